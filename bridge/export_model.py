@@ -1,10 +1,13 @@
 """
 export_model.py
 读取 best.pth →
-  1. model.json      网络结构 + 每层参数 + hotspots
-  2. weights.bin     原始 float32 权重连续内存
-  3. hotspots.json   热点参数文件
-  4.各卷积层输出的数据文件
+  1. model.bcnn      单文件模型容器（文件头 + 张量表 + 元数据 + 64字节对齐的张量数据），查看器优先加载
+  2. hotspots.json   热点参数文件
+  3. model.json      网络结构 + 每层参数（含BN的running_mean/var和eps） + hotspots（--legacy）
+  4. weights.bin     原始 float32 权重连续内存（--legacy）
+各卷积层的参考输出只写入 model.bcnn。旧版的 model.json + weights.bin 只在指定 --legacy 时写出，
+参考输出仍需以 m_ustc_*.bin 放在同一目录才能用于 --verify（见 assets/model_legacy）；
+CMake 的 bcnn_static_shapes 直接读取 model.bcnn 中的元数据
 """
 import torch
 import json
@@ -14,6 +17,7 @@ import sys
 import importlib.util
 import numpy as np
 import os
+import contextlib
 from PIL import Image
 import torchvision.transforms as transforms
 
@@ -119,6 +123,12 @@ def analyze_model_structure(model):
         {"name": "gap", "type": "adaptive_avg_pool2d", "output_size": 1},
         {"name": "classifier", "type": "linear", "in_features": 64, "out_features": 9}
     ]
+
+    # BN 的 eps 取自模型本身，推理端按 (x - running_mean) / sqrt(running_var + eps) 归一化
+    bn_modules = [m for m in model.modules() if isinstance(m, torch.nn.BatchNorm2d)]
+    bn_layers = [layer for layer in structure if layer["type"] == "batchnorm2d"]
+    for layer, bn in zip(bn_layers, bn_modules):
+        layer["eps"] = float(bn.eps)
     
     return structure
 
@@ -127,6 +137,7 @@ def extract_parameters(model):
     """提取模型参数并准备序列化"""
     layers = []
     weights = []
+    tensors = []
     offset = 0
     
     # 参数名称映射到热点
@@ -143,7 +154,11 @@ def extract_parameters(model):
         "classifier.bias": "classifier"
     }
     
-    for name, param in model.named_parameters():
+    # 可训练参数之后追加 BN 的 running_mean / running_var 缓冲区（num_batches_tracked 推理时不需要）
+    bn_buffers = [(name, buf) for name, buf in model.named_buffers()
+                  if name.endswith("running_mean") or name.endswith("running_var")]
+
+    for name, param in list(model.named_parameters()) + bn_buffers:
         shape = list(param.shape)
         num_elements = param.numel()
         data = param.detach().view(-1).tolist()
@@ -177,13 +192,23 @@ def extract_parameters(model):
         
         layers.append(layer_info)
         weights.extend(data)
+        tensors.append((name, param.detach().cpu().numpy()))
         offset += num_elements * 4
     
-    return layers, weights
+    return layers, weights, tensors
 
 # ---------- 5. 主导出函数 ----------
-def export_model():
-    """导出模型的主要函数"""
+@contextlib.contextmanager
+def atomic_open(path, mode, **kwargs):
+    """先写临时文件再整体替换，查看器正在映射的旧文件不会被截断"""
+    path = pathlib.Path(path)
+    tmp_path = path.with_name(path.name + ".tmp")
+    with open(tmp_path, mode, **kwargs) as f:
+        yield f
+    os.replace(tmp_path, path)
+
+def export_model(write_legacy=False):
+    """导出模型的主要函数；write_legacy 为真时同时写出旧版的 model.json + weights.bin"""
     print("正在加载模型...")
     model = load_model()
     
@@ -191,7 +216,7 @@ def export_model():
     model_structure = analyze_model_structure(model)
     
     print("提取模型参数...")
-    layers, weights = extract_parameters(model)
+    layers, weights, tensors = extract_parameters(model)
     
     # ---------- 写 JSON 文件 ----------
     json_data = {
@@ -206,23 +231,24 @@ def export_model():
         "hotspots": HOT_SPOTS
     }
     
-    json_path = OUTPUT_DIR / "model.json"
-    with open(json_path, "w", encoding="utf-8") as f:
-        json.dump(json_data, f, indent=2, ensure_ascii=False)
-    print(f"[+] JSON → {json_path}")
-    
-    # ---------- 写二进制权重文件 ----------
-    bin_path = OUTPUT_DIR / "weights.bin"
-    with open(bin_path, "wb") as f:
-        # 写入权重数量作为文件头
-        f.write(struct.pack("I", len(weights)))
-        # 写入所有权重数据
-        f.write(struct.pack(f"{len(weights)}f", *weights))
-    print(f"[+] BIN  → {bin_path}  ({len(weights)*4} bytes, {len(weights)}个参数)")
+    if write_legacy:
+        json_path = OUTPUT_DIR / "model.json"
+        with atomic_open(json_path, "w", encoding="utf-8") as f:
+            json.dump(json_data, f, indent=2, ensure_ascii=False)
+        print(f"[+] JSON → {json_path}")
+        
+        # ---------- 写二进制权重文件 ----------
+        bin_path = OUTPUT_DIR / "weights.bin"
+        with atomic_open(bin_path, "wb") as f:
+            # 写入权重数量作为文件头
+            f.write(struct.pack("I", len(weights)))
+            # 写入所有权重数据
+            f.write(struct.pack(f"{len(weights)}f", *weights))
+        print(f"[+] BIN  → {bin_path}  ({len(weights)*4} bytes, {len(weights)}个参数)")
     
     # ---------- 单独的热点文件 ----------
     hot_path = OUTPUT_DIR / "hotspots.json"
-    with open(hot_path, "w", encoding="utf-8") as f:
+    with atomic_open(hot_path, "w", encoding="utf-8") as f:
         json.dump(HOT_SPOTS, f, indent=2, ensure_ascii=False)
     print(f"[+] HOT  → {hot_path}")
     
@@ -232,6 +258,8 @@ def export_model():
     print(f"总文件大小: {len(weights)*4} 字节")
     print(f"热点区域数量: {len(HOT_SPOTS)}")
 
+    return json_data, tensors
+
 # ---------- 6. 验证函数 ----------
 def verify_export():
     """验证导出的文件"""
@@ -286,9 +314,9 @@ def load_test_image(image_path=None):
     return torch.randn(1, 1, 64, 64)
 
 # ---------- 各层输出数据导出函数 ----------
-def export_layer_outputs(model, test_input, output_dir, input_name="m_ustc"):
-    """导出各层的输出数据"""
-    print("导出各层输出数据...")
+def export_layer_outputs(model, test_input):
+    """计算各层的输出数据，由 export_container 写入 model.bcnn"""
+    print("计算各层输出数据...")
     layer_outputs = {}
     
     with torch.no_grad():
@@ -307,21 +335,175 @@ def export_layer_outputs(model, test_input, output_dir, input_name="m_ustc"):
         x = model.conv4(x)
         layer_outputs['conv4_output'] = x.numpy()    # 64×4×4
     
-    # 保存为二进制文件
     for name, data in layer_outputs.items():
-        data.tofile(f"{output_dir}/{input_name}_{name}.bin")
         print(f"  {name}: shape={data.shape}")
     
     return layer_outputs
 
+# ---------- 7. 单文件模型容器 ----------
+# 格式与 src/loader/ModelContainer.hpp 保持一致，所有整数为小端序
+CONTAINER_MAGIC = b"BCNNMDL\0"
+CONTAINER_VERSION = 1
+CONTAINER_ALIGN = 64
+CONTAINER_MAX_DIMS = 6
+CONTAINER_NAME_LEN = 96
+HEADER_FMT = "<8sIIIIQQQQQ"      # 64 字节文件头
+ENTRY_FMT = "<96sII6I6IQQQQ8x"   # 192 字节张量表项（最后一个Q为数据校验和）
+DTYPE_CODES = {"float32": 0, "float16": 1, "bfloat16": 2, "int8": 3}
+
+def _align(n, a=CONTAINER_ALIGN):
+    return (n + a - 1) // a * a
+
+def fnv1a64(*chunks):
+    """张量数据的 FNV-1a 64 校验和，ModelWatcher 按它判断张量是否变化而不读取数据"""
+    h = 0xCBF29CE484222325
+    for chunk in chunks:
+        for b in chunk:
+            h = ((h ^ b) * 0x100000001B3) & 0xFFFFFFFFFFFFFFFF
+    return h
+
+def encode_tensor(arr, dtype):
+    """按存储类型编码张量，返回 (数据字节, int8缩放系数字节或None)"""
+    arr = np.ascontiguousarray(arr, dtype=np.float32)
+    if dtype == "float32":
+        return arr.tobytes(), None
+    if dtype == "float16":
+        return arr.astype(np.float16).tobytes(), None
+    if dtype == "bfloat16":
+        # 取 float32 高16位，按最近偶数舍入
+        bits = arr.view(np.uint32).astype(np.uint64)
+        rounded = (bits + 0x7FFF + ((bits >> 16) & 1)) >> 16
+        # NaN 不参与舍入（尾数只在低16位的 NaN 进位后会变成 Inf），截断并置静默位
+        nan = np.isnan(arr)
+        rounded[nan] = (bits[nan] >> 16) | 0x40
+        return rounded.astype(np.uint16).tobytes(), None
+    if dtype == "int8":
+        # 按第0维（输出通道）对称量化
+        channels = arr.reshape(arr.shape[0], -1)
+        scales = np.abs(channels).max(axis=1) / 127.0
+        scales[scales == 0] = 1.0
+        q = np.clip(np.round(channels / scales[:, None]), -127, 127).astype(np.int8)
+        return q.tobytes(), scales.astype(np.float32).tobytes()
+    raise ValueError(f"不支持的数据类型: {dtype}")
+
+def storage_dtype(arr, weight_dtype):
+    """参数张量的存储类型：int8 只用于卷积/全连接权重，BN与偏置保持 float32"""
+    if weight_dtype == "int8" and arr.ndim < 2:
+        return "float32"
+    return weight_dtype
+
+def write_container(path, metadata, tensors):
+    """写入单文件模型容器
+    tensors: [(name, ndarray, dtype)]，数据区中每个张量按 64 字节对齐"""
+    header_size = struct.calcsize(HEADER_FMT)
+    entry_size = struct.calcsize(ENTRY_FMT)
+    meta_bytes = json.dumps(metadata, ensure_ascii=False).encode("utf-8")
+
+    table_offset = header_size
+    meta_offset = table_offset + entry_size * len(tensors)
+    data_offset = _align(meta_offset + len(meta_bytes))
+
+    # 计算每个张量的绝对偏移
+    entries = []
+    payloads = []
+    cursor = data_offset
+    for name, arr, dtype in tensors:
+        arr = np.ascontiguousarray(arr, dtype=np.float32)
+        if arr.ndim > CONTAINER_MAX_DIMS or len(name.encode("utf-8")) >= CONTAINER_NAME_LEN:
+            raise ValueError(f"张量无法写入容器: {name} {arr.shape}")
+        data, scales = encode_tensor(arr, dtype)
+        shape = list(arr.shape)
+        strides = [s // arr.itemsize for s in arr.strides]
+        pad = CONTAINER_MAX_DIMS - arr.ndim
+
+        data_pos = cursor
+        payloads.append((data_pos, data))
+        cursor = _align(cursor + len(data))
+
+        # int8 缩放系数紧跟在数据之后
+        scale_pos = 0
+        if scales is not None:
+            scale_pos = cursor
+            payloads.append((scale_pos, scales))
+            cursor = _align(cursor + len(scales))
+
+        entries.append(struct.pack(
+            ENTRY_FMT, name.encode("utf-8"), DTYPE_CODES[dtype], arr.ndim,
+            *(shape + [0] * pad), *(strides + [0] * pad), data_pos, len(data), scale_pos,
+            fnv1a64(data, scales or b"")))
+
+    header = struct.pack(HEADER_FMT, CONTAINER_MAGIC, CONTAINER_VERSION, header_size,
+                         len(tensors), entry_size, table_offset, meta_offset, len(meta_bytes),
+                         data_offset, cursor - data_offset)
+
+    with atomic_open(path, "wb") as f:
+        f.write(header)
+        f.write(b"".join(entries))
+        f.write(meta_bytes)
+        for offset, data in payloads:
+            f.write(b"\0" * (offset - f.tell()))
+            f.write(data)
+
+def export_container(json_data, tensors, layer_outputs, input_name="m_ustc", weight_dtype="float32"):
+    """把结构、参数和参考激活值打包为 model.bcnn
+    weight_dtype: 参数存储类型 float32 / float16 / bfloat16 / int8，参考激活值始终为 float32"""
+    param_tensors = [(name, arr, storage_dtype(arr, weight_dtype)) for name, arr in tensors]
+    param_dtypes = {name: dtype for name, _, dtype in param_tensors}
+
+    # 偏移由张量表给出，元数据中只保留类型和热点信息
+    metadata = dict(json_data)
+    metadata["layers"] = [
+        dict({k: v for k, v in layer.items() if k not in ("offset", "size_bytes")},
+             dtype=param_dtypes[layer["name"]])
+        for layer in json_data["layers"]
+    ]
+    activation_tensors = [(f"{input_name}_{name}", data, "float32") for name, data in layer_outputs.items()]
+    metadata["activations"] = [name for name, _, _ in activation_tensors]
+
+    path = OUTPUT_DIR / "model.bcnn"
+    write_container(path, metadata, param_tensors + activation_tensors)
+    print(f"[+] BCNN → {path}  ({len(tensors)} 个参数张量 [{weight_dtype}], {len(activation_tensors)} 个参考激活)")
+
+def verify_container():
+    """验证单文件模型容器"""
+    try:
+        with open(OUTPUT_DIR / "model.bcnn", "rb") as f:
+            blob = f.read()
+        (magic, version, header_size, count, entry_size,
+         table_offset, meta_offset, meta_size, data_offset, data_size) = struct.unpack_from(HEADER_FMT, blob)
+        assert magic == CONTAINER_MAGIC and version == CONTAINER_VERSION
+        for i in range(count):
+            fields = struct.unpack_from(ENTRY_FMT, blob, table_offset + i * entry_size)
+            offset, size_bytes, scale_offset, checksum = fields[-4:]
+            assert offset % CONTAINER_ALIGN == 0 and offset + size_bytes <= len(blob)
+            assert scale_offset <= len(blob)
+            scales = blob[scale_offset:scale_offset + 4 * fields[3]] if scale_offset else b""
+            assert checksum == fnv1a64(blob[offset:offset + size_bytes], scales), "校验和不符"
+        json.loads(blob[meta_offset:meta_offset + meta_size].decode("utf-8"))
+        print("BCNN验证通过，张量数量:", count)
+    except Exception as e:
+        print(f"容器验证失败: {e}")
+
 if __name__ == "__main__":
-    export_model()
+    import argparse
+    parser = argparse.ArgumentParser(description="导出模型到可视化工具")
+    parser.add_argument("--weight-dtype", choices=list(DTYPE_CODES), default="float32",
+                        help="model.bcnn 中参数的存储类型（weights.bin 始终为 float32）")
+    parser.add_argument("--legacy", action="store_true",
+                        help="同时写出旧版的 model.json + weights.bin（旧版查看器使用）")
+    args = parser.parse_args()
+
+    json_data, tensors = export_model(args.legacy)
 
     model = load_model()
     # 加载ustc.png
     test_input = load_test_image()
-    # 导出各层输出数据
-    export_layer_outputs(model, test_input, OUTPUT_DIR, "m_ustc")
-    
+    # 计算各层输出数据
+    layer_outputs = export_layer_outputs(model, test_input)
+
+    # 打包单文件容器
+    export_container(json_data, tensors, layer_outputs, "m_ustc", args.weight_dtype)
 
-    verify_export()
\ No newline at end of file
+    verify_container()
+    if args.legacy:
+        verify_export()
\ No newline at end of file
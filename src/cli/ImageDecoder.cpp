@@ -0,0 +1,130 @@
+#include "cli/ImageDecoder.hpp"
+#include <algorithm>
+#include <cctype>
+#include <csetjmp>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <png.h>
+#include <jpeglib.h>
+
+namespace {
+
+bool decode_png(const std::string& path, DecodedImage& image, std::string& error) {
+    png_image png;
+    std::memset(&png, 0, sizeof(png));
+    png.version = PNG_IMAGE_VERSION;
+
+    if (!png_image_begin_read_from_file(&png, path.c_str())) {
+        error = png.message;
+        return false;
+    }
+
+    // 保留原始通道数，灰度转换交给预处理（与PIL一致）
+    bool color = (png.format & PNG_FORMAT_FLAG_COLOR) != 0;
+    bool alpha = (png.format & PNG_FORMAT_FLAG_ALPHA) != 0;
+    if (color) {
+        png.format = alpha ? PNG_FORMAT_RGBA : PNG_FORMAT_RGB;
+        image.channels = alpha ? 4 : 3;
+    } else {
+        png.format = alpha ? PNG_FORMAT_GA : PNG_FORMAT_GRAY;
+        image.channels = alpha ? 2 : 1;
+    }
+
+    image.width = static_cast<int>(png.width);
+    image.height = static_cast<int>(png.height);
+    image.pixels.resize(PNG_IMAGE_SIZE(png));
+
+    if (!png_image_finish_read(&png, nullptr, image.pixels.data(), 0, nullptr)) {
+        error = png.message;
+        png_image_free(&png);
+        return false;
+    }
+    return true;
+}
+
+// libjpeg 默认出错时直接退出进程，这里改为跳回调用处
+struct JpegError {
+    jpeg_error_mgr mgr;
+    std::jmp_buf jump;
+    char message[JMSG_LENGTH_MAX];
+};
+
+void jpeg_error_exit(j_common_ptr cinfo) {
+    auto* err = reinterpret_cast<JpegError*>(cinfo->err);
+    (*cinfo->err->format_message)(cinfo, err->message);
+    std::longjmp(err->jump, 1);
+}
+
+bool decode_jpeg(const std::string& path, DecodedImage& image, std::string& error) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        error = "无法打开文件";
+        return false;
+    }
+
+    jpeg_decompress_struct cinfo;
+    JpegError jerr;
+    cinfo.err = jpeg_std_error(&jerr.mgr);
+    jerr.mgr.error_exit = jpeg_error_exit;
+
+    if (setjmp(jerr.jump)) {
+        error = jerr.message;
+        jpeg_destroy_decompress(&cinfo);
+        std::fclose(file);
+        return false;
+    }
+
+    jpeg_create_decompress(&cinfo);
+    jpeg_stdio_src(&cinfo, file);
+    jpeg_read_header(&cinfo, TRUE);
+
+    cinfo.out_color_space = cinfo.num_components == 1 ? JCS_GRAYSCALE : JCS_RGB;
+    jpeg_start_decompress(&cinfo);
+
+    image.width = static_cast<int>(cinfo.output_width);
+    image.height = static_cast<int>(cinfo.output_height);
+    image.channels = cinfo.output_components;
+    image.pixels.resize(static_cast<size_t>(image.width) * image.height * image.channels);
+
+    size_t stride = static_cast<size_t>(image.width) * image.channels;
+    while (cinfo.output_scanline < cinfo.output_height) {
+        JSAMPROW row = image.pixels.data() + cinfo.output_scanline * stride;
+        jpeg_read_scanlines(&cinfo, &row, 1);
+    }
+
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+    std::fclose(file);
+    return true;
+}
+
+} // namespace
+
+bool decode_image(const std::string& path, DecodedImage& image, std::string& error) {
+    unsigned char magic[8] = {0};
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        error = "无法打开文件";
+        return false;
+    }
+    size_t n = std::fread(magic, 1, sizeof(magic), file);
+    std::fclose(file);
+
+    // 按文件内容而不是扩展名判断格式
+    if (n >= 8 && png_sig_cmp(magic, 0, 8) == 0) {
+        return decode_png(path, image, error);
+    }
+    if (n >= 3 && magic[0] == 0xFF && magic[1] == 0xD8 && magic[2] == 0xFF) {
+        return decode_jpeg(path, image, error);
+    }
+    error = "不支持的图片格式";
+    return false;
+}
+
+bool is_supported_image(const std::string& path) {
+    std::string ext = std::filesystem::path(path).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".png" || ext == ".jpg" || ext == ".jpeg";
+}
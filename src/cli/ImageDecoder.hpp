@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 解码后的8位图像，行优先，通道交错
+struct DecodedImage {
+    int width = 0;
+    int height = 0;
+    int channels = 0;                 // 1=灰度, 2=灰度+alpha, 3=RGB, 4=RGBA
+    std::vector<uint8_t> pixels;
+};
+
+// 根据文件头识别并解码 PNG / JPEG，失败时返回false并把原因写入error
+bool decode_image(const std::string& path, DecodedImage& image, std::string& error);
+
+// 是否为支持的图片扩展名（.png / .jpg / .jpeg，不区分大小写）
+bool is_supported_image(const std::string& path);
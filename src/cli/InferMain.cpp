@@ -0,0 +1,846 @@
+// 校徽批量分类命令行工具
+// 用法与输出格式与 python/infer.py 一致：
+//   digit_viz_infer --img <图片或目录> [--topk k] [--model assets/model] [--threads n] [--batch n]
+//                   [--affinity none|compact] [--scaling]
+//                   [--conv auto|direct|gemm|winograd2|winograd4|层名=实现,...] [--no-fold-bn]
+//                   [--int8 [--calib python/data/clean/val]] [--int8-report] [--layout nchw|nchwc] [--static]
+//   digit_viz_infer --verify [--model assets/model] [--tolerance t]
+// 目录会递归扫描 .png/.jpg/.jpeg；统计信息（吞吐量和各阶段耗时）输出到 stderr。
+// 计算在 --threads 个线程的工作窃取线程池中进行：各批图片之间并行，每批的融合卷积块
+// 再按图像、输出通道块和行分块拆成任务；--affinity compact 把工作线程绑定到各自的CPU。
+// --scaling 不逐张输出，改为线程数从1倍增到 --threads，报告处理 --img 全部图片的吞吐量和加速比。
+// --verify 用导出的 m_ustc_input 依次以各卷积实现前向，与 m_ustc_conv*_output 逐块比较，
+// 相对误差超过 tolerance 时返回非0；同时比较 forward_batch（融合块、分块布局）与逐层 forward 的 logits。
+// 默认在加载后把BN折叠进卷积权重（ModelLoader::fold_batchnorm），--no-fold-bn 保留单独的BN层。
+// BN缺少 running_mean/running_var 或 eps 时加载失败；--allow-missing-bn-stats 改为按均值0、方差1近似
+// （结果与训练时的网络不同，仅用于查看旧版导出的模型）。
+// --int8 先用 --calib 目录下的图片以float前向标定激活范围，再以INT8量化的卷积块分类；
+// 标定集默认为源码树中的 python/data/clean/val，CPU没有INT8 SIMD内核时忽略 --int8；
+// --int8-report 不逐张输出，改为在 --img 上比较float与INT8的 top-1 准确率（标签取自上级目录名）、
+// 预测一致率和前向吞吐量。
+// --static（需以 BCNN_STATIC_NETWORK 构建）逐张使用编译期特化的 StaticNetwork 前向，
+// 模型与构建时生成的形状不符时回退到 InferenceEngine，输入尺寸不符的图片（如非正方形图片）
+// 逐批改由 InferenceEngine 前向；--verify 同时比较其 logits。
+#include "cli/ImageDecoder.hpp"
+#include "engine/InferenceEngine.hpp"
+#include "engine/ThreadPool.hpp"
+#include "engine/kernels/Isa.hpp"
+#include "engine/kernels/Layout.hpp"
+#include "loader/ModelLoader.hpp"
+#ifdef BCNN_STATIC_NETWORK
+#include "engine/static/StaticNetwork.hpp"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// 类别顺序必须与训练时 ImageFolder 的 class_to_idx 一致
+const std::vector<std::string> kClassNames = {
+    "fdu", "hit", "nju", "pku", "sjtu", "thu", "ustc", "xjtu", "zju"
+};
+
+// 默认标定集：CMake 构建时为源码树中的 python/data/clean/val（与工作目录无关）
+#ifndef BCNN_DEFAULT_CALIB_DIR
+#define BCNN_DEFAULT_CALIB_DIR "python/data/clean/val"
+#endif
+
+struct Options {
+    std::string model_dir = "assets/model";
+    std::string img;
+    int topk = 1;
+    int threads = 0;                  // 0 表示使用全部核心
+    ThreadPool::Affinity affinity = ThreadPool::Affinity::None;
+    bool scaling = false;             // 线程数扩展性测试
+    int batch = 16;
+    std::string conv = "auto";        // 卷积实现，如 gemm 或 conv3=gemm,conv4=direct
+    bool fold_bn = true;              // 加载后把BN折叠进卷积
+    bool allow_missing_bn_stats = false;   // BN缺少统计量时按均值0方差1近似，而不是报错
+    bool verify = false;              // 与导出的参考激活值比较各卷积实现
+    float tolerance = 1e-4f;          // --verify 允许的最大相对误差
+    bool int8 = false;                // INT8量化推理
+    bool int8_report = false;         // 比较float与INT8的准确率和吞吐量
+    std::string calib = BCNN_DEFAULT_CALIB_DIR;     // INT8标定集
+    bool blocked = true;              // 融合块使用 NCHWc 分块布局
+    bool use_static = false;          // 使用编译期特化的 StaticNetwork
+};
+
+struct Prediction {
+    bool ok = false;
+    std::string error;
+    std::vector<std::pair<int, float>> top;   // (类别, 概率)，按概率降序
+};
+
+// 各阶段累计耗时（纳秒）
+struct StageTimes {
+    std::atomic<long long> decode{0};
+    std::atomic<long long> preprocess{0};
+    std::atomic<long long> forward{0};
+};
+
+using Clock = std::chrono::steady_clock;
+
+long long elapsed_ns(Clock::time_point since) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - since).count();
+}
+
+void print_usage() {
+    std::cerr << "用法: digit_viz_infer --img <图片或文件夹> [--topk k] [--model 模型目录]"
+              << " [--threads n] [--affinity none|compact] [--scaling] [--batch n]"
+              << " [--conv auto|direct|gemm|winograd2|winograd4|层名=实现,...]"
+              << " [--no-fold-bn] [--allow-missing-bn-stats] [--int8 [--calib 标定集目录]] [--int8-report] [--layout nchw|nchwc]"
+              << " [--static]" << std::endl;
+    std::cerr << "      digit_viz_infer --verify [--model 模型目录] [--tolerance t] [--no-fold-bn]"
+              << " [--allow-missing-bn-stats]" << std::endl;
+}
+
+bool parse_args(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&](const char* name) -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "缺少参数值: " << name << std::endl;
+                return nullptr;
+            }
+            return argv[++i];
+        };
+
+        const char* value = nullptr;
+        if (arg == "--img") {
+            if (!(value = next("--img"))) return false;
+            opt.img = value;
+        } else if (arg == "--model") {
+            if (!(value = next("--model"))) return false;
+            opt.model_dir = value;
+        } else if (arg == "--topk") {
+            if (!(value = next("--topk"))) return false;
+            opt.topk = std::max(1, std::atoi(value));
+        } else if (arg == "--threads") {
+            if (!(value = next("--threads"))) return false;
+            opt.threads = std::max(0, std::atoi(value));
+        } else if (arg == "--affinity") {
+            if (!(value = next("--affinity"))) return false;
+            if (!ThreadPool::parse_affinity(value, opt.affinity)) {
+                std::cerr << "未知的线程绑定方式: " << value << std::endl;
+                return false;
+            }
+        } else if (arg == "--scaling") {
+            opt.scaling = true;
+        } else if (arg == "--batch") {
+            if (!(value = next("--batch"))) return false;
+            opt.batch = std::max(1, std::atoi(value));
+        } else if (arg == "--conv") {
+            if (!(value = next("--conv"))) return false;
+            opt.conv = value;
+        } else if (arg == "--no-fold-bn") {
+            opt.fold_bn = false;
+        } else if (arg == "--allow-missing-bn-stats") {
+            opt.allow_missing_bn_stats = true;
+        } else if (arg == "--verify") {
+            opt.verify = true;
+        } else if (arg == "--tolerance") {
+            if (!(value = next("--tolerance"))) return false;
+            opt.tolerance = static_cast<float>(std::atof(value));
+        } else if (arg == "--int8") {
+            opt.int8 = true;
+        } else if (arg == "--int8-report") {
+            opt.int8_report = true;
+        } else if (arg == "--layout") {
+            if (!(value = next("--layout"))) return false;
+            std::string layout = value;
+            if (layout != "nchw" && layout != "nchwc") {
+                std::cerr << "未知的布局: " << layout << std::endl;
+                return false;
+            }
+            opt.blocked = layout == "nchwc";
+        } else if (arg == "--static") {
+#ifdef BCNN_STATIC_NETWORK
+            opt.use_static = true;
+#else
+            std::cerr << "--static 需要以 -DBCNN_STATIC_NETWORK=ON 构建" << std::endl;
+            return false;
+#endif
+        } else if (arg == "--calib") {
+            if (!(value = next("--calib"))) return false;
+            opt.calib = value;
+        } else if (arg == "-h" || arg == "--help") {
+            return false;
+        } else {
+            std::cerr << "未知参数: " << arg << std::endl;
+            return false;
+        }
+    }
+    return opt.verify || !opt.img.empty();
+}
+
+// 递归收集目录下的图片，按路径排序保证输出稳定
+std::vector<std::string> collect_images(const std::string& root) {
+    std::vector<std::string> files;
+    std::error_code ec;
+    for (auto it = std::filesystem::recursive_directory_iterator(root, ec);
+         !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+        if (it->is_regular_file(ec) && is_supported_image(it->path().string())) {
+            files.push_back(it->path().string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+// 解析 --conv：逗号分隔，每项为实现名（作用于全部卷积层）或 层名=实现名
+bool apply_conv_backends(const std::string& spec, InferenceEngine& engine) {
+    size_t pos = 0;
+    while (pos <= spec.size()) {
+        size_t end = spec.find(',', pos);
+        if (end == std::string::npos) end = spec.size();
+        std::string item = spec.substr(pos, end - pos);
+        pos = end + 1;
+        if (item.empty()) continue;
+
+        std::string layer;
+        size_t eq = item.find('=');
+        if (eq != std::string::npos) {
+            layer = item.substr(0, eq);
+            item = item.substr(eq + 1);
+        }
+
+        InferenceEngine::ConvBackend backend;
+        if (!InferenceEngine::parse_conv_backend(item, backend)) {
+            std::cerr << "未知的卷积实现: " << item << std::endl;
+            return false;
+        }
+        if (!engine.set_conv_backend(layer, backend)) {
+            std::cerr << "找不到卷积层: " << layer << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// 读取导出的参考张量：优先使用模型容器中的激活值，否则读取模型目录下的 <name>.bin
+bool load_reference(const ModelLoader& model, const std::string& name, size_t count, std::vector<float>& out) {
+    TensorView tensor = model.get_tensor(name);
+    if (tensor.valid() && tensor.numel() >= count) {
+        out.assign(tensor.data(), tensor.data() + count);
+        return true;
+    }
+
+    std::ifstream file(model.get_model_dir() + "/" + name + ".bin", std::ios::binary);
+    if (!file) return false;
+    out.resize(count);
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(out.data()), count * sizeof(float)));
+}
+
+// --verify：每种卷积实现各前向一次 m_ustc_input，
+// 与每个卷积块（conv -> bn -> relu -> maxpool）的参考输出 m_ustc_<conv>_output 比较
+int run_verify(const Options& opt, const ModelLoader& model, InferenceEngine& engine) {
+    Tensor input;
+    input.shape = engine.get_input_shape();
+    size_t input_size = 1;
+    for (int d : input.shape) input_size *= static_cast<size_t>(d);
+    if (input.shape.size() != 3 || !load_reference(model, "m_ustc_input", input_size, input.data)) {
+        std::cerr << "找不到参考输入: m_ustc_input" << std::endl;
+        return 1;
+    }
+
+    // 块输出为每个卷积层之后的第一个最大池化层
+    std::vector<std::pair<std::string, std::string>> blocks;   // (卷积层, 池化层)
+    std::string conv;
+    for (const LayerStructure& s : model.get_structure()) {
+        if (s.type == "conv2d") {
+            conv = s.name;
+        } else if (s.type == "maxpool2d" && !conv.empty()) {
+            blocks.emplace_back(conv, s.name);
+            conv.clear();
+        }
+    }
+
+    bool passed = true;
+    int compared = 0;
+    for (InferenceEngine::ConvBackend backend :
+         {InferenceEngine::ConvBackend::Direct, InferenceEngine::ConvBackend::Gemm,
+          InferenceEngine::ConvBackend::Winograd2, InferenceEngine::ConvBackend::Winograd4}) {
+        engine.set_conv_backend("", backend);
+        ForwardResult result;
+        if (!engine.forward(input, result)) {
+            std::cerr << "前向传播失败" << std::endl;
+            return 1;
+        }
+
+        for (const auto& block : blocks) {
+            const Tensor* out = result.find(block.second);
+            std::vector<float> ref;
+            if (!out || !load_reference(model, "m_ustc_" + block.first + "_output", out->numel(), ref)) {
+                continue;
+            }
+
+            float max_abs = 0.0f;
+            float max_ref = 0.0f;
+            for (size_t i = 0; i < ref.size(); ++i) {
+                max_abs = std::max(max_abs, std::fabs(out->data[i] - ref[i]));
+                max_ref = std::max(max_ref, std::fabs(ref[i]));
+            }
+            float rel = max_abs / std::max(max_ref, 1e-12f);
+            bool ok = rel <= opt.tolerance;
+            passed = passed && ok;
+            ++compared;
+
+            // 报告实际生效的实现（不支持Winograd的层会回退到Auto）
+            std::printf("%-10s %-8s max_abs=%.3e  rel=%.3e  %s\n",
+                        InferenceEngine::conv_backend_name(engine.get_conv_backend(block.first)),
+                        block.first.c_str(), max_abs, rel, ok ? "ok" : "FAIL");
+        }
+    }
+
+    if (compared == 0) {
+        std::cerr << "找不到参考激活值: m_ustc_conv*_output" << std::endl;
+        return 1;
+    }
+
+    // 批量路径（融合块，分块布局时含布局转换）与逐层路径的 logits 应一致
+    for (bool blocked : {false, true}) {
+        engine.set_conv_backend("", InferenceEngine::ConvBackend::Auto);
+        engine.set_blocked_layout(blocked);
+        ForwardResult result;
+        std::vector<std::vector<float>> logits;
+        if (!engine.forward(input, result) || !engine.forward_batch({input}, logits)) {
+            std::cerr << "前向传播失败" << std::endl;
+            return 1;
+        }
+
+        float max_abs = 0.0f;
+        float max_ref = 0.0f;
+        for (size_t i = 0; i < result.logits.size(); ++i) {
+            max_abs = std::max(max_abs, std::fabs(logits[0][i] - result.logits[i]));
+            max_ref = std::max(max_ref, std::fabs(result.logits[i]));
+        }
+        float rel = max_abs / std::max(max_ref, 1e-12f);
+        bool ok = rel <= opt.tolerance;
+        passed = passed && ok;
+        std::printf("%-10s %-8s max_abs=%.3e  rel=%.3e  %s\n", blocked ? "nchwc" : "nchw", "logits",
+                    max_abs, rel, ok ? "ok" : "FAIL");
+    }
+
+#ifdef BCNN_STATIC_NETWORK
+    // 编译期特化的前向与逐层路径的 logits 应一致
+    StaticNetwork network;
+    ForwardResult result;
+    float logits[StaticNetwork::kNumClasses];
+    if (network.load(engine) && engine.forward(input, result) && network.forward(input.data.data(), logits)) {
+        float max_abs = 0.0f;
+        float max_ref = 0.0f;
+        for (size_t i = 0; i < result.logits.size(); ++i) {
+            max_abs = std::max(max_abs, std::fabs(logits[i] - result.logits[i]));
+            max_ref = std::max(max_ref, std::fabs(result.logits[i]));
+        }
+        float rel = max_abs / std::max(max_ref, 1e-12f);
+        bool ok = rel <= opt.tolerance;
+        passed = passed && ok;
+        std::printf("%-10s %-8s max_abs=%.3e  rel=%.3e  %s\n", "static", "logits", max_abs, rel,
+                    ok ? "ok" : "FAIL");
+    }
+#endif
+    std::printf("verify: %s (tolerance %.1e)\n", passed ? "passed" : "FAILED", opt.tolerance);
+    return passed ? 0 : 1;
+}
+
+#ifdef BCNN_STATIC_NETWORK
+// StaticNetwork 逐张前向；与生成的输入形状（kChannels[0]×kHeights[0]×kWidths[0]）不符的图片
+// （如保持宽高比缩放后的非正方形图片）改由 InferenceEngine 批量前向，返回其数量（失败时为 -1）
+long forward_static(const StaticNetwork& network, const InferenceEngine& engine,
+                    const std::vector<Tensor>& inputs, std::vector<std::vector<float>>& logits) {
+    thread_local std::vector<Tensor> others;
+    thread_local std::vector<size_t> other_indices;
+    thread_local std::vector<std::vector<float>> other_logits;
+    others.clear();
+    other_indices.clear();
+
+    logits.resize(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const Tensor& input = inputs[i];
+        if (input.shape.size() != 3 || input.shape[0] != StaticNetwork::kInputChannels ||
+            input.shape[1] != StaticNetwork::kInputHeight || input.shape[2] != StaticNetwork::kInputWidth) {
+            others.push_back(input);
+            other_indices.push_back(i);
+            continue;
+        }
+        logits[i].resize(StaticNetwork::kNumClasses);
+        if (!network.forward(input.data.data(), logits[i].data())) {
+            return -1;
+        }
+    }
+
+    if (!others.empty()) {
+        if (!engine.forward_batch(others, other_logits)) {
+            return -1;
+        }
+        for (size_t j = 0; j < others.size(); ++j) {
+            logits[other_indices[j]].swap(other_logits[j]);
+        }
+    }
+    return static_cast<long>(others.size());
+}
+#endif
+
+// 解码并预处理全部图片，失败的图片跳过；labels 非空时按上级目录名查找类别（找不到为-1）
+size_t load_inputs(const std::vector<std::string>& files, std::vector<Tensor>& inputs, std::vector<int>* labels) {
+    PreprocessOptions preprocess;
+    DecodedImage image;
+    size_t failed = 0;
+    for (const std::string& file : files) {
+        std::string error;
+        if (!decode_image(file, image, error)) {
+            std::cerr << error << std::endl;
+            ++failed;
+            continue;
+        }
+        inputs.push_back(preprocess_image(image.pixels.data(), image.width, image.height,
+                                          image.channels, preprocess));
+        if (labels) {
+            std::string dir = std::filesystem::path(file).parent_path().filename().string();
+            auto it = std::find(kClassNames.begin(), kClassNames.end(), dir);
+            labels->push_back(it == kClassNames.end() ? -1 : static_cast<int>(it - kClassNames.begin()));
+        }
+    }
+    return failed;
+}
+
+// 用 --calib 目录下的全部图片标定，然后量化
+bool prepare_int8(const Options& opt, InferenceEngine& engine) {
+    std::vector<std::string> files = collect_images(opt.calib);
+    if (files.empty()) {
+        std::cerr << "标定集为空: " << opt.calib << "（用 --calib 指定标定集目录）" << std::endl;
+        return false;
+    }
+    std::vector<Tensor> inputs;
+    load_inputs(files, inputs, nullptr);
+    for (const Tensor& input : inputs) {
+        if (!engine.calibrate(input)) {
+            return false;
+        }
+    }
+
+    std::streambuf* stdout_buf = std::cout.rdbuf(std::cerr.rdbuf());
+    int layers = engine.quantize_int8();
+    std::cout.rdbuf(stdout_buf);
+    std::fprintf(stderr, "int8 calibration: %zu images from %s\n", inputs.size(), opt.calib.c_str());
+    return layers > 0;
+}
+
+int argmax(const std::vector<float>& v) {
+    return static_cast<int>(std::max_element(v.begin(), v.end()) - v.begin());
+}
+
+// --int8-report：单线程按 --batch 分批前向，float与INT8各计时一次
+int run_int8_report(const Options& opt, const std::vector<std::string>& files, InferenceEngine& engine) {
+    std::vector<Tensor> inputs;
+    std::vector<int> labels;
+    load_inputs(files, inputs, &labels);
+    if (inputs.empty()) {
+        return 1;
+    }
+
+    auto run = [&](bool int8, std::vector<int>& predictions) -> double {
+        engine.set_int8(int8);
+        predictions.assign(inputs.size(), -1);
+        std::vector<Tensor> batch;
+        std::vector<std::vector<float>> logits;
+        auto start = Clock::now();
+        for (size_t begin = 0; begin < inputs.size(); begin += opt.batch) {
+            size_t end = std::min(inputs.size(), begin + opt.batch);
+            batch.assign(inputs.begin() + begin, inputs.begin() + end);
+            if (!engine.forward_batch(batch, logits)) {
+                return -1.0;
+            }
+            for (size_t j = 0; j < logits.size(); ++j) {
+                predictions[begin + j] = argmax(logits[j]);
+            }
+        }
+        return elapsed_ns(start) / 1e6;
+    };
+
+    std::vector<int> pred_float;
+    std::vector<int> pred_int8;
+    double ms_float = run(false, pred_float);
+    double ms_int8 = run(true, pred_int8);
+    if (ms_float < 0.0 || ms_int8 < 0.0) {
+        std::cerr << "前向计算失败" << std::endl;
+        return 1;
+    }
+
+    size_t labeled = 0;
+    size_t correct_float = 0;
+    size_t correct_int8 = 0;
+    size_t agree = 0;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        agree += pred_float[i] == pred_int8[i];
+        if (labels[i] < 0) continue;
+        ++labeled;
+        correct_float += pred_float[i] == labels[i];
+        correct_int8 += pred_int8[i] == labels[i];
+    }
+
+    const double n = static_cast<double>(inputs.size());
+    std::printf("int8 report: %zu images (%zu labeled), batch %d\n", inputs.size(), labeled, opt.batch);
+    std::printf("layers:");
+    for (const std::string& layer : engine.get_int8_layers()) {
+        std::printf(" %s", layer.c_str());
+    }
+    std::printf(" (%s)\n", kernels::int8_isa_name(kernels::best_int8_isa()));
+    if (labeled > 0) {
+        std::printf("top-1 accuracy: float %.2f%%, int8 %.2f%% (%+.2f%%)\n",
+                    100.0 * correct_float / labeled, 100.0 * correct_int8 / labeled,
+                    100.0 * (static_cast<double>(correct_int8) - correct_float) / labeled);
+    }
+    std::printf("agreement: %.2f%% (%zu / %zu)\n", 100.0 * agree / n, agree, inputs.size());
+    std::printf("forward: float %.3f ms/img, int8 %.3f ms/img, speedup %.2fx\n",
+                ms_float / n, ms_int8 / n, ms_float / ms_int8);
+    return 0;
+}
+
+// --scaling：线程数从1倍增到 --threads（默认全部核心），每种线程数新建线程池，
+// 与分类相同地解码、预处理并前向 --img 的全部图片（批间并行，批内各层再拆分），先预热一遍再计时
+int run_scaling(const Options& opt, const std::vector<std::string>& files, InferenceEngine& engine) {
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    const int max_threads = opt.threads > 0 ? opt.threads : static_cast<int>(hardware);
+    std::vector<int> counts;
+    for (int t = 1; t < max_threads; t *= 2) {
+        counts.push_back(t);
+    }
+    counts.push_back(max_threads);
+
+    const size_t batches = (files.size() + opt.batch - 1) / opt.batch;
+    std::atomic<size_t> failed{0};
+    auto process = [&](size_t first, size_t last) {
+        thread_local std::vector<Tensor> inputs;
+        thread_local std::vector<std::vector<float>> logits;
+        thread_local DecodedImage image;
+        PreprocessOptions preprocess;
+        for (size_t b = first; b < last; ++b) {
+            inputs.clear();
+            const size_t end = std::min(files.size(), (b + 1) * opt.batch);
+            for (size_t i = b * opt.batch; i < end; ++i) {
+                std::string error;
+                if (!decode_image(files[i], image, error)) {
+                    ++failed;
+                    continue;
+                }
+                inputs.push_back(preprocess_image(image.pixels.data(), image.width, image.height,
+                                                  image.channels, preprocess));
+            }
+            if (!engine.forward_batch(inputs, logits)) {
+                failed += inputs.size();
+            }
+        }
+    };
+
+    std::printf("scaling: %zu images, batch %d, affinity %s, %u hardware threads\n", files.size(), opt.batch,
+                ThreadPool::affinity_name(opt.affinity), hardware);
+    std::printf("threads   images/s   speedup   efficiency\n");
+    double base = 0.0;
+    for (int threads : counts) {
+        ThreadPool::Options options;
+        options.threads = threads;
+        options.affinity = opt.affinity;
+        ThreadPool pool(options);
+        engine.set_thread_pool(&pool);
+
+        pool.parallel_for(0, batches, 1, process);
+        failed = 0;
+        auto start = Clock::now();
+        pool.parallel_for(0, batches, 1, process);
+        double seconds = elapsed_ns(start) / 1e9;
+        engine.set_thread_pool(nullptr);
+        if (failed > 0) {
+            std::cerr << failed << " 张图片处理失败" << std::endl;
+            return 1;
+        }
+
+        double rate = files.size() / seconds;
+        if (threads == 1) base = rate;
+        std::printf("%7d   %8.1f   %6.2fx   %9.1f%%\n", threads, rate, rate / base,
+                    100.0 * rate / base / threads);
+    }
+    return 0;
+}
+
+void softmax_topk(const std::vector<float>& logits, int k, Prediction& pred) {
+    float max_logit = *std::max_element(logits.begin(), logits.end());
+    std::vector<float> prob(logits.size());
+    float sum = 0.0f;
+    for (size_t i = 0; i < logits.size(); ++i) {
+        prob[i] = std::exp(logits[i] - max_logit);
+        sum += prob[i];
+    }
+
+    std::vector<int> order(logits.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = static_cast<int>(i);
+    k = std::min<int>(k, static_cast<int>(order.size()));
+    std::partial_sort(order.begin(), order.begin() + k, order.end(),
+                      [&](int a, int b) { return prob[a] > prob[b]; });
+
+    pred.top.clear();
+    for (int i = 0; i < k; ++i) {
+        pred.top.emplace_back(order[i], prob[order[i]] / sum);
+    }
+}
+
+std::string class_name(int index) {
+    return index >= 0 && index < static_cast<int>(kClassNames.size())
+        ? kClassNames[index] : std::to_string(index);
+}
+
+// 与 infer.py 相同的单行输出：name  -->  cls  (xx.x%)，topk>1 时在后面追加其余类别
+void print_prediction(const std::string& label, const Prediction& pred) {
+    if (!pred.ok) {
+        std::printf("%s  -->  失败 (%s)\n", label.c_str(), pred.error.c_str());
+        return;
+    }
+    std::printf("%s  -->  %s  (%.1f%%)", label.c_str(),
+                class_name(pred.top[0].first).c_str(), pred.top[0].second * 100.0f);
+    for (size_t i = 1; i < pred.top.size(); ++i) {
+        std::printf("  %s (%.1f%%)", class_name(pred.top[i].first).c_str(), pred.top[i].second * 100.0f);
+    }
+    std::printf("\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parse_args(argc, argv, opt)) {
+        print_usage();
+        return 1;
+    }
+
+    std::printf("device: cpu\n");
+
+    // 加载过程的日志转到 stderr，stdout 只保留与 infer.py 相同的结果行
+    ModelLoader model;
+    InferenceEngine engine;
+    std::streambuf* stdout_buf = std::cout.rdbuf(std::cerr.rdbuf());
+    bool loaded = model.load_from_dir(opt.model_dir);
+    if (loaded && opt.fold_bn) {
+        loaded = model.fold_batchnorm(opt.allow_missing_bn_stats) >= 0;
+    }
+    engine.set_allow_missing_bn_stats(opt.allow_missing_bn_stats);
+    loaded = loaded && engine.build(model);
+    std::cout.rdbuf(stdout_buf);
+    if (!loaded) {
+        std::cerr << "模型加载失败: " << opt.model_dir << std::endl;
+        return 1;
+    }
+    if (opt.verify) {
+        return run_verify(opt, model, engine);
+    }
+    engine.set_blocked_layout(opt.blocked);
+    if (!apply_conv_backends(opt.conv, engine)) {
+        return 1;
+    }
+
+    // 收集输入
+    bool single = std::filesystem::is_regular_file(opt.img);
+    std::vector<std::string> files;
+    if (single) {
+        files.push_back(opt.img);
+    } else if (std::filesystem::is_directory(opt.img)) {
+        files = collect_images(opt.img);
+        std::printf("find %zu images\n\n", files.size());
+    } else {
+        std::cerr << "路径不存在: " << opt.img << std::endl;
+        return 1;
+    }
+    if (files.empty()) {
+        return 0;
+    }
+    // 没有INT8 SIMD内核时标量INT8卷积比float慢，--int8 不量化（--int8-report 仍比较两者）
+    if (opt.int8 && kernels::best_int8_isa() == kernels::Int8Isa::Scalar) {
+        std::cerr << "没有可用的INT8 SIMD内核（需要AVX2或AVX-512 VNNI），--int8 忽略，使用float推理" << std::endl;
+        opt.int8 = false;
+    }
+    if ((opt.int8 || opt.int8_report) && !prepare_int8(opt, engine)) {
+        std::cerr << "INT8量化失败" << std::endl;
+        return 1;
+    }
+    if (opt.int8_report) {
+        return run_int8_report(opt, files, engine);
+    }
+    if (opt.scaling) {
+        return run_scaling(opt, files, engine);
+    }
+
+#ifdef BCNN_STATIC_NETWORK
+    StaticNetwork network;
+    if (opt.use_static) {
+        if (engine.is_int8()) {
+            std::cerr << "--static 不支持INT8，使用推理引擎" << std::endl;
+        } else if (!network.load(engine)) {
+            std::cerr << "StaticNetwork 不可用，使用推理引擎" << std::endl;
+        }
+    }
+#endif
+
+    ThreadPool::Options pool_options;
+    pool_options.threads = opt.threads;
+    pool_options.affinity = opt.affinity;
+    ThreadPool pool(pool_options);
+    engine.set_thread_pool(&pool);
+
+    // 流水线：线程池的每个任务处理一批图片，依次完成 解码 -> 预处理 -> 前向（前向再拆成更小的任务）；
+    // 主线程按输入顺序输出已完成的结果
+    std::vector<Prediction> results(files.size());
+    std::vector<char> done(files.size(), 0);
+    std::mutex done_mutex;
+    std::condition_variable done_cv;
+    StageTimes times;
+#ifdef BCNN_STATIC_NETWORK
+    std::atomic<size_t> static_fallback{0};   // StaticNetwork 形状不符、改用推理引擎的图片数
+#endif
+
+    PreprocessOptions preprocess;   // 与 infer.py 相同：Resize(64) + Normalize(0.5, 0.5)
+
+    auto process = [&](size_t first_batch, size_t last_batch) {
+        thread_local std::vector<Tensor> inputs;
+        thread_local std::vector<size_t> indices;
+        thread_local std::vector<std::vector<float>> logits;
+        thread_local DecodedImage image;
+
+        for (size_t b = first_batch; b < last_batch; ++b) {
+            size_t begin = b * opt.batch;
+            size_t end = std::min(files.size(), begin + opt.batch);
+
+            // 解码与预处理
+            inputs.clear();
+            indices.clear();
+            for (size_t i = begin; i < end; ++i) {
+                auto t0 = Clock::now();
+                std::string error;
+                bool ok = decode_image(files[i], image, error);
+                times.decode += elapsed_ns(t0);
+                if (!ok) {
+                    results[i].error = error;
+                    continue;
+                }
+
+                auto t1 = Clock::now();
+                inputs.push_back(preprocess_image(image.pixels.data(), image.width, image.height,
+                                                  image.channels, preprocess));
+                indices.push_back(i);
+                times.preprocess += elapsed_ns(t1);
+            }
+
+            // 批量前向
+            auto t2 = Clock::now();
+#ifdef BCNN_STATIC_NETWORK
+            bool ok;
+            if (network.is_ready()) {
+                long fallback = forward_static(network, engine, inputs, logits);
+                ok = fallback >= 0;
+                if (fallback > 0) static_fallback += static_cast<size_t>(fallback);
+            } else {
+                ok = engine.forward_batch(inputs, logits);
+            }
+#else
+            bool ok = engine.forward_batch(inputs, logits);
+#endif
+            for (size_t j = 0; j < inputs.size(); ++j) {
+                Prediction& pred = results[indices[j]];
+                if (ok) {
+                    softmax_topk(logits[j], opt.topk, pred);
+                    pred.ok = true;
+                } else {
+                    pred.error = "前向计算失败";
+                }
+            }
+            times.forward += elapsed_ns(t2);
+
+            {
+                std::lock_guard<std::mutex> lock(done_mutex);
+                std::fill(done.begin() + begin, done.begin() + end, 1);
+            }
+            done_cv.notify_one();
+        }
+    };
+
+    auto start = Clock::now();
+    const size_t batches = (files.size() + opt.batch - 1) / opt.batch;
+    std::thread driver([&] { pool.parallel_for(0, batches, 1, process); });
+
+    // 按顺序输出
+    long long report_ns = 0;
+    std::filesystem::path root(opt.img);
+    for (size_t i = 0; i < files.size(); ++i) {
+        {
+            std::unique_lock<std::mutex> lock(done_mutex);
+            done_cv.wait(lock, [&] { return done[i] != 0; });
+        }
+        auto t0 = Clock::now();
+        if (single) {
+            print_prediction(files[i], results[i]);
+        } else {
+            // 递归扫描时显示相对路径，左对齐25列与 infer.py 一致
+            std::string label = std::filesystem::relative(files[i], root).string();
+            if (label.size() < 25) label.resize(25, ' ');
+            print_prediction(label, results[i]);
+        }
+        report_ns += elapsed_ns(t0);
+    }
+
+    driver.join();
+    double wall = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // 统计信息
+    size_t failed = std::count_if(results.begin(), results.end(),
+                                  [](const Prediction& p) { return !p.ok; });
+    double n = static_cast<double>(files.size());
+    std::fprintf(stderr, "\n%zu images (%zu failed), %d threads (affinity %s), batch %d\n",
+                 files.size(), failed, pool.size(), ThreadPool::affinity_name(opt.affinity), opt.batch);
+    std::fprintf(stderr, "throughput: %.1f images/s (%.3f s)\n", n / wall, wall);
+    std::fprintf(stderr, "kernels: %s,", kernels::isa_name(kernels::best_isa()));
+    bool engine_used = true;
+#ifdef BCNN_STATIC_NETWORK
+    if (network.is_ready()) {
+        std::fprintf(stderr, " static(%s)", network.kernel_name());
+        // 形状不符的图片由推理引擎处理，同时列出引擎的实现
+        engine_used = static_fallback > 0;
+        if (engine_used) {
+            std::fprintf(stderr, ", %zu images not %dx%dx%d ->", static_fallback.load(),
+                         StaticNetwork::kInputChannels, StaticNetwork::kInputHeight, StaticNetwork::kInputWidth);
+        }
+    }
+#endif
+    if (engine_used) {
+        for (const auto& [layer, backend] : engine.get_conv_backends()) {
+            std::fprintf(stderr, " %s=%s", layer.c_str(), InferenceEngine::conv_backend_name(backend));
+        }
+        if (!engine.get_blocked_layers().empty()) {
+            std::fprintf(stderr, ", nchw%dc:", kernels::channel_block(kernels::best_isa()));
+            for (const std::string& layer : engine.get_blocked_layers()) {
+                std::fprintf(stderr, " %s", layer.c_str());
+            }
+        }
+        if (engine.is_int8()) {
+            std::fprintf(stderr, ", int8(%s):", kernels::int8_isa_name(kernels::best_int8_isa()));
+            for (const std::string& layer : engine.get_int8_layers()) {
+                std::fprintf(stderr, " %s", layer.c_str());
+            }
+        }
+    }
+    std::fprintf(stderr, "\n");
+    std::fprintf(stderr, "latency per image: decode %.3f ms, preprocess %.3f ms, forward %.3f ms, report %.3f ms\n",
+                 times.decode / n / 1e6, times.preprocess / n / 1e6,
+                 times.forward / n / 1e6, report_ns / n / 1e6);
+    return failed == 0 ? 0 : 2;
+}
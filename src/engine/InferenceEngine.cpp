@@ -0,0 +1,1170 @@
+#include "engine/InferenceEngine.hpp"
+#include "engine/ThreadPool.hpp"
+#include "engine/kernels/Conv3x3.hpp"
+#include "engine/kernels/ConvBlock.hpp"
+#include "engine/kernels/ConvGemm.hpp"
+#include "engine/kernels/Layout.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+namespace {
+
+// 并行时每个任务至少的乘加次数（或逐元素操作的元素数），更小的任务调度开销占比过高
+constexpr size_t kMinTaskWork = 1 << 17;
+
+// 有线程池时把 [0, count) 拆成不小于 grain 的任务并行执行，否则在当前线程一次完成
+template <typename Body>
+void parallel_range(ThreadPool* pool, size_t count, size_t grain, const Body& body) {
+    if (pool && pool->size() > 1) {
+        pool->parallel_for(0, count, grain, body);
+    } else {
+        body(0, count);
+    }
+}
+
+// 按候选名称依次查找参数张量
+TensorView find_param(const ModelLoader& model, const std::vector<std::string>& names) {
+    for (const auto& name : names) {
+        TensorView view = model.get_tensor(name);
+        if (view.valid()) return view;
+    }
+    return TensorView();
+}
+
+int param_or(const LayerStructure& s, const std::string& key, int fallback) {
+    auto it = s.parameters.find(key);
+    return it != s.parameters.end() ? it->second : fallback;
+}
+
+// 与 PIL 的 BILINEAR 重采样一致的一维三角滤波（缩小时按比例扩大支撑范围，即抗锯齿）
+// 返回每个输出位置的起始下标和归一化权重
+struct ResampleTaps {
+    std::vector<int> start;
+    std::vector<std::vector<float>> weights;
+};
+
+ResampleTaps make_taps(int in_size, int out_size) {
+    ResampleTaps taps;
+    taps.start.resize(out_size);
+    taps.weights.resize(out_size);
+
+    double scale = static_cast<double>(in_size) / out_size;
+    double filter_scale = std::max(scale, 1.0);
+    double support = filter_scale;   // 三角滤波半径为1
+
+    for (int i = 0; i < out_size; ++i) {
+        double center = (i + 0.5) * scale;
+        int lo = std::max(0, static_cast<int>(center - support + 0.5));
+        int hi = std::min(in_size, static_cast<int>(center + support + 0.5));
+
+        std::vector<float> w;
+        double total = 0.0;
+        for (int j = lo; j < hi; ++j) {
+            double x = (j + 0.5 - center) / filter_scale;
+            double v = std::max(0.0, 1.0 - std::abs(x));
+            w.push_back(static_cast<float>(v));
+            total += v;
+        }
+        if (total > 0.0) {
+            for (auto& v : w) v = static_cast<float>(v / total);
+        }
+        taps.start[i] = lo;
+        taps.weights[i] = std::move(w);
+    }
+    return taps;
+}
+
+// 每次执行方式改变时分配新的 plan_id，不同引擎实例之间也不会重复
+uint64_t next_plan_id() {
+    static std::atomic<uint64_t> counter{0};
+    return ++counter;
+}
+
+uint8_t clip_u8(float v) {
+    return static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, std::round(v))));
+}
+
+} // namespace
+
+const Tensor* ForwardResult::find(const std::string& name) const {
+    for (const auto& [n, t] : activations) {
+        if (n == name) return &t;
+    }
+    return nullptr;
+}
+
+Tensor preprocess_image(const uint8_t* pixels, int width, int height, int channels,
+                        const PreprocessOptions& options) {
+    // 转为灰度（与 PIL convert('L') 相同的 ITU-R 601-2 系数）
+    std::vector<uint8_t> gray(static_cast<size_t>(width) * height);
+    for (size_t i = 0; i < gray.size(); ++i) {
+        const uint8_t* p = pixels + i * channels;
+        if (channels >= 3) {
+            gray[i] = static_cast<uint8_t>((p[0] * 19595 + p[1] * 38470 + p[2] * 7471 + 0x8000) >> 16);
+        } else {
+            gray[i] = p[0];
+        }
+    }
+
+    // 目标尺寸
+    int out_w = options.size;
+    int out_h = options.size;
+    if (options.keep_aspect) {
+        if (width <= height) {
+            out_h = static_cast<int>(static_cast<long long>(options.size) * height / width);
+        } else {
+            out_w = static_cast<int>(static_cast<long long>(options.size) * width / height);
+        }
+    }
+
+    // 可分离重采样：先水平后垂直，每一趟结果取整到8位（与PIL一致）
+    std::vector<uint8_t> horiz(static_cast<size_t>(out_w) * height);
+    if (out_w == width) {
+        horiz = gray;
+    } else {
+        ResampleTaps taps = make_taps(width, out_w);
+        for (int y = 0; y < height; ++y) {
+            const uint8_t* row = gray.data() + static_cast<size_t>(y) * width;
+            for (int x = 0; x < out_w; ++x) {
+                float sum = 0.0f;
+                const auto& w = taps.weights[x];
+                for (size_t k = 0; k < w.size(); ++k) sum += row[taps.start[x] + k] * w[k];
+                horiz[static_cast<size_t>(y) * out_w + x] = clip_u8(sum);
+            }
+        }
+    }
+
+    std::vector<uint8_t> resized(static_cast<size_t>(out_w) * out_h);
+    if (out_h == height) {
+        resized = horiz;
+    } else {
+        ResampleTaps taps = make_taps(height, out_h);
+        for (int y = 0; y < out_h; ++y) {
+            const auto& w = taps.weights[y];
+            for (int x = 0; x < out_w; ++x) {
+                float sum = 0.0f;
+                for (size_t k = 0; k < w.size(); ++k) {
+                    sum += horiz[static_cast<size_t>(taps.start[y] + k) * out_w + x] * w[k];
+                }
+                resized[static_cast<size_t>(y) * out_w + x] = clip_u8(sum);
+            }
+        }
+    }
+
+    // ToTensor + Normalize
+    Tensor input;
+    input.shape = {1, out_h, out_w};
+    input.data.resize(resized.size());
+    for (size_t i = 0; i < resized.size(); ++i) {
+        float v = resized[i] / 255.0f;
+        input.data[i] = options.normalize ? (v - 0.5f) / 0.5f : v;
+    }
+    return input;
+}
+
+bool InferenceEngine::build(const ModelLoader& model) {
+    ops.clear();
+    input_shape = model.model_info.input_size;
+    num_classes = 0;
+
+    const auto& structure = model.get_structure();
+    if (structure.empty()) {
+        std::cerr << "模型缺少网络结构信息，无法构建推理引擎" << std::endl;
+        return false;
+    }
+
+    std::string prev_conv;
+    for (size_t i = 0; i < structure.size(); ++i) {
+        const LayerStructure& s = structure[i];
+        Op op;
+        op.name = s.name;
+
+        bool ok = true;
+        if (s.type == "conv2d") {
+            ok = build_conv(model, s, op);
+            prev_conv = s.name;
+
+            // 结构中写在卷积上的ReLU实际位于BN之后（Conv -> BN -> ReLU）
+            auto act = s.attributes.find("activation");
+            bool relu = act != s.attributes.end() && act->second == "relu";
+            bool next_is_bn = i + 1 < structure.size() && structure[i + 1].type == "batchnorm2d";
+            op.relu = relu && !next_is_bn;
+        } else if (s.type == "batchnorm2d") {
+            ok = build_batchnorm(model, s, prev_conv, op);
+            // 继承前一个卷积的激活函数
+            if (ok && !ops.empty() && ops.back().type == OpType::Conv2d) {
+                auto act = structure[i - 1].attributes.find("activation");
+                op.relu = act != structure[i - 1].attributes.end() && act->second == "relu";
+            }
+        } else if (s.type == "maxpool2d") {
+            op.type = OpType::MaxPool2d;
+            op.kernel = param_or(s, "kernel_size", 2);
+            op.stride = param_or(s, "stride", op.kernel);
+        } else if (s.type == "adaptive_avg_pool2d") {
+            if (param_or(s, "output_size", 1) != 1) {
+                std::cerr << "仅支持 output_size=1 的自适应平均池化: " << s.name << std::endl;
+                ok = false;
+            }
+            op.type = OpType::GlobalAvgPool;
+        } else if (s.type == "linear") {
+            ok = build_linear(model, s, op);
+            num_classes = op.out_channels;
+        } else {
+            std::cerr << "不支持的层类型: " << s.name << " (" << s.type << ")" << std::endl;
+            ok = false;
+        }
+
+        if (!ok) {
+            ops.clear();
+            return false;
+        }
+        ops.push_back(std::move(op));
+    }
+
+    int blocks = fuse_conv_blocks();
+    invalidate_plan();
+
+    std::cout << "推理引擎构建完成: " << ops.size() << " 个算子, "
+              << num_classes << " 个输出类别, " << blocks << " 个融合卷积块" << std::endl;
+
+    size_t arena_bytes = 0;
+    size_t naive_bytes = 0;
+    if (get_activation_footprint(input_shape, arena_bytes, naive_bytes)) {
+        char line[192];
+        std::snprintf(line, sizeof(line), "激活值内存: %.1f KB/图像（逐层分配为 %.1f KB，不含卷积内核的线程局部临时缓冲区）",
+                      arena_bytes / 1024.0, naive_bytes / 1024.0);
+        std::cout << line << std::endl;
+    }
+    return true;
+}
+
+int InferenceEngine::fuse_conv_blocks() {
+    int blocks = 0;
+    auto is_pool2 = [](const Op& op) {
+        return op.type == OpType::MaxPool2d && op.kernel == 2 && op.stride == 2;
+    };
+
+    for (size_t i = 0; i + 1 < ops.size(); ++i) {
+        Op& conv = ops[i];
+        if (conv.type != OpType::Conv2d || conv.kernel != 3 || conv.stride != 1 || conv.padding != 1) {
+            continue;
+        }
+        const int C = conv.out_channels;
+
+        if (conv.relu && is_pool2(ops[i + 1])) {
+            // BN已由 ModelLoader::fold_batchnorm 折叠进卷积：Conv+ReLU -> MaxPool
+            conv.scale.assign(C, 1.0f);
+            conv.shift.resize(C);
+            for (int c = 0; c < C; ++c) {
+                conv.shift[c] = conv.bias ? conv.bias[c] : 0.0f;
+            }
+            conv.fused_ops = 1;
+        } else if (!conv.relu && i + 2 < ops.size() && is_pool2(ops[i + 2]) &&
+                   ops[i + 1].type == OpType::BatchNorm2d && ops[i + 1].relu &&
+                   ops[i + 1].out_channels == C) {
+            // BN(conv + bias) = conv * scale + (bias * scale + shift)
+            const Op& bn = ops[i + 1];
+            conv.scale = bn.scale;
+            conv.shift.resize(C);
+            for (int c = 0; c < C; ++c) {
+                float b = conv.bias ? conv.bias[c] : 0.0f;
+                conv.shift[c] = b * bn.scale[c] + bn.shift[c];
+            }
+            conv.fused_ops = 2;
+        } else {
+            continue;
+        }
+        // 输入输出通道数都是通道块大小的倍数时可使用分块布局（conv1 只有1个输入通道，保持 NCHW）
+        const int cb = kernels::channel_block(kernels::best_isa());
+        if (cb > 0 && conv.in_channels % cb == 0 && C % cb == 0) {
+            conv.block = cb;
+            kernels::pack_conv3x3_weights_nchwc(conv.weight, C, conv.in_channels, cb, conv.blocked_weight);
+        }
+        conv.backend = auto_conv_backend(conv);
+        ++blocks;
+    }
+    return blocks;
+}
+
+bool InferenceEngine::build_conv(const ModelLoader& model, const LayerStructure& s, Op& op) {
+    op.type = OpType::Conv2d;
+    op.in_channels = param_or(s, "in_channels", 0);
+    op.out_channels = param_or(s, "out_channels", 0);
+    op.kernel = param_or(s, "kernel_size", 3);
+    op.stride = param_or(s, "stride", 1);
+    op.padding = param_or(s, "padding", 0);
+
+    // 参数名可能为 conv1.weight 或 Sequential 中的 conv1.0.weight
+    TensorView w = find_param(model, {s.name + ".weight", s.name + ".0.weight"});
+    TensorView b = find_param(model, {s.name + ".bias", s.name + ".0.bias"});
+    if (!w.valid()) {
+        std::cerr << "找不到卷积权重: " << s.name << std::endl;
+        return false;
+    }
+    if (w.dim(0) != op.out_channels || w.dim(1) != op.in_channels ||
+        w.dim(2) != op.kernel || w.dim(3) != op.kernel) {
+        std::cerr << "卷积权重形状与结构不符: " << w.name() << std::endl;
+        return false;
+    }
+    op.weight_view = w;
+    op.bias_view = b;
+    op.weight = w.data();
+    op.bias = b.valid() ? b.data() : nullptr;
+    if (!op.weight) return false;
+
+    // Gemm 使用的权重面板在构建时打包一次
+    kernels::pack_conv_weights(op.weight, op.out_channels, op.in_channels, op.kernel, op.packed_weight);
+
+    // Winograd 的滤波器变换已由ModelLoader预先计算，这里只按SGEMM面板格式打包
+    if (op.kernel == 3 && op.stride == 1 && op.padding == 1) {
+        const Layer* layer = model.find_layer(w.name());
+        const float* u2 = layer ? model.get_winograd_filter(*layer, 2) : nullptr;
+        const float* u4 = layer ? model.get_winograd_filter(*layer, 4) : nullptr;
+        if (u2) kernels::pack_winograd_weights(u2, op.in_channels, op.out_channels, 2, op.winograd2);
+        if (u4) kernels::pack_winograd_weights(u4, op.in_channels, op.out_channels, 4, op.winograd4);
+    }
+    op.backend = auto_conv_backend(op);
+    return true;
+}
+
+bool InferenceEngine::build_batchnorm(const ModelLoader& model, const LayerStructure& s,
+                                      const std::string& prev_conv, Op& op) {
+    op.type = OpType::BatchNorm2d;
+    op.out_channels = param_or(s, "num_features", 0);
+
+    // BN参数名可能为 batchnorm1.* 或与卷积同一Sequential中的 conv1.1.*
+    std::vector<std::string> prefixes = {s.name};
+    if (!prev_conv.empty()) prefixes.push_back(prev_conv + ".1");
+
+    auto find = [&](const std::string& suffix) {
+        std::vector<std::string> names;
+        for (const auto& p : prefixes) names.push_back(p + "." + suffix);
+        return find_param(model, names);
+    };
+
+    TensorView gamma = find("weight");
+    TensorView beta = find("bias");
+    TensorView mean = find("running_mean");
+    TensorView var = find("running_var");
+
+    if (!gamma.valid() || !beta.valid()) {
+        std::cerr << "找不到BN参数: " << s.name << std::endl;
+        return false;
+    }
+    int c = op.out_channels;
+    if (gamma.numel() != static_cast<size_t>(c) || beta.numel() != static_cast<size_t>(c)) {
+        std::cerr << "BN参数形状与结构不符: " << s.name << std::endl;
+        return false;
+    }
+
+    // 没有统计量或 eps 时结果与训练时的网络不同，除非明确允许，否则构建失败
+    bool has_stats = mean.valid() && var.valid() &&
+                     mean.numel() == static_cast<size_t>(c) && var.numel() == static_cast<size_t>(c);
+    auto eps_it = s.float_parameters.find("eps");
+    bool has_eps = eps_it != s.float_parameters.end();
+    if (!has_stats || !has_eps) {
+        const char* what = !has_stats ? "running_mean/running_var" : "eps";
+        if (!allow_missing_bn_stats) {
+            std::cerr << "错误: " << s.name << " 缺少 " << what
+                      << "（请用 bridge/export_model.py 重新导出模型）" << std::endl;
+            return false;
+        }
+        std::cerr << "警告: " << s.name << " 缺少 " << what << "，按均值0、方差1、eps=1e-5 近似计算" << std::endl;
+    }
+
+    const float eps = has_eps ? eps_it->second : 1e-5f;
+    op.scale.resize(c);
+    op.shift.resize(c);
+    for (int i = 0; i < c; ++i) {
+        float m = has_stats ? mean.data()[i] : 0.0f;
+        float v = has_stats ? var.data()[i] : 1.0f;
+        float inv = 1.0f / std::sqrt(v + eps);
+        op.scale[i] = gamma.data()[i] * inv;
+        op.shift[i] = beta.data()[i] - m * op.scale[i];
+    }
+    return true;
+}
+
+bool InferenceEngine::build_linear(const ModelLoader& model, const LayerStructure& s, Op& op) {
+    op.type = OpType::Linear;
+    op.in_channels = param_or(s, "in_features", 0);
+    op.out_channels = param_or(s, "out_features", 0);
+
+    TensorView w = find_param(model, {s.name + ".weight"});
+    TensorView b = find_param(model, {s.name + ".bias"});
+    if (!w.valid() || w.dim(0) != op.out_channels || w.dim(1) != op.in_channels) {
+        std::cerr << "找不到全连接权重或形状不符: " << s.name << std::endl;
+        return false;
+    }
+    op.weight_view = w;
+    op.bias_view = b;
+    op.weight = w.data();
+    op.bias = b.valid() ? b.data() : nullptr;
+    return op.weight != nullptr;
+}
+
+bool InferenceEngine::forward(const Tensor& input, ForwardResult& result) const {
+    result.activations.clear();
+    result.logits.clear();
+
+    if (ops.empty()) {
+        std::cerr << "推理引擎尚未构建" << std::endl;
+        return false;
+    }
+    if (input.shape.size() != 3) {
+        std::cerr << "输入形状必须为 [C, H, W]" << std::endl;
+        return false;
+    }
+
+    const Tensor* current = &input;
+    for (const Op& op : ops) {
+        Tensor out;
+        if (!run_op(op, *current, out)) {
+            return false;
+        }
+        result.activations.emplace_back(op.name, std::move(out));
+        current = &result.activations.back().second;
+    }
+
+    result.logits = current->data;
+    return true;
+}
+
+bool InferenceEngine::forward_batch(const std::vector<Tensor>& inputs,
+                                    std::vector<std::vector<float>>& logits) const {
+    logits.resize(inputs.size());
+
+    if (ops.empty()) {
+        std::cerr << "推理引擎尚未构建" << std::endl;
+        return false;
+    }
+
+    // 按输入形状分组（保持形状比例缩放时各图像尺寸可能不同）
+    thread_local std::vector<char> grouped;
+    thread_local std::vector<const Tensor*> group;
+    thread_local std::vector<std::vector<float>*> outputs;
+    grouped.assign(inputs.size(), 0);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (grouped[i]) continue;
+        if (inputs[i].shape.size() != 3) {
+            std::cerr << "输入形状必须为 [C, H, W]" << std::endl;
+            return false;
+        }
+
+        group.clear();
+        outputs.clear();
+        for (size_t j = i; j < inputs.size(); ++j) {
+            if (!grouped[j] && inputs[j].shape == inputs[i].shape) {
+                grouped[j] = 1;
+                group.push_back(&inputs[j]);
+                outputs.push_back(&logits[j]);
+            }
+        }
+        if (!forward_group(group, outputs)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool InferenceEngine::forward_group(const std::vector<const Tensor*>& inputs,
+                                    std::vector<std::vector<float>*>& logits) const {
+    const int n = static_cast<int>(inputs.size());
+    const Shape input{inputs[0]->dim(0), inputs[0]->dim(1), inputs[0]->dim(2)};
+
+    // 内存规划按 (plan_id, 输入形状) 缓存在线程中，arena只增不减；
+    // 缓存已满时淘汰最早的规划
+    constexpr size_t kMaxCachedPlans = 8;
+    thread_local std::vector<ActivationPlan> plans;
+    thread_local AlignedArena arena;
+    auto cached = std::find_if(plans.begin(), plans.end(), [&](const ActivationPlan& p) {
+        return p.id == plan_id && p.input == input;
+    });
+    if (cached == plans.end()) {
+        ActivationPlan plan;
+        if (!plan_activations(input, plan)) {
+            return false;
+        }
+        if (plans.size() >= kMaxCachedPlans) {
+            plans.erase(plans.begin());
+        }
+        plans.push_back(std::move(plan));
+        cached = plans.end() - 1;
+    }
+    const ActivationPlan& plan = *cached;
+    arena.reserve(plan.arena_bytes * n);
+    uint8_t* base = arena.data();
+
+    thread_local std::vector<const float*> src;
+    thread_local std::vector<float*> dst;
+    src.resize(n);
+    dst.resize(n);
+    for (int i = 0; i < n; ++i) {
+        src[i] = inputs[i]->data.data();
+    }
+
+    for (const PlanStep& step : plan.steps) {
+        const Op& op = ops[step.op];
+        for (int i = 0; i < n; ++i) {
+            dst[i] = reinterpret_cast<float*>(base + step.output * n + i * step.output_bytes);
+        }
+        uint8_t* scratch = base + step.scratch * n;
+        const float* const* in = src.data();
+        float* const* out = dst.data();
+        // 逐张处理的步骤按图像拆分任务，小的步骤（布局转换、池化、全连接）几张图像合为一个任务
+        const size_t image_grain = std::max<size_t>(1, kMinTaskWork / std::max<size_t>(1, step.in.numel()));
+
+        if (step.type == StepType::Reorder) {
+            parallel_range(thread_pool, n, image_grain, [&](size_t first, size_t last) {
+                run_reorder(step, in + first, out + first, static_cast<int>(last - first));
+            });
+        } else if (op.fused_ops > 0) {
+            if (use_int8 && !op.qweight.empty()) {
+                // 每张图像使用各自的量化缓冲区，便于并行
+                parallel_range(thread_pool, n, 1, [&](size_t first, size_t last) {
+                    for (size_t i = first; i < last; ++i) {
+                        run_block_int8_batch(op, in + i, out + i, 1, step.in, scratch + i * step.scratch_bytes);
+                    }
+                });
+            } else {
+                run_block_parallel(op, in, out, n, step.in, step.in_block, reinterpret_cast<float*>(scratch));
+            }
+        } else if (op.type == OpType::GlobalAvgPool && step.in_block > 0) {
+            parallel_range(thread_pool, n, image_grain, [&](size_t first, size_t last) {
+                for (size_t i = first; i < last; ++i) {
+                    kernels::global_avg_pool_nchwc(in[i], step.in.c, step.in.h, step.in.w, step.in_block, out[i]);
+                }
+            });
+        } else if (op.type == OpType::Conv2d && op.backend != ConvBackend::Direct && n > 1) {
+            // Gemm / Winograd 整批计算更快，按线程数均分为几个子批
+            const int threads = thread_pool ? thread_pool->size() : 1;
+            parallel_range(thread_pool, n, (n + threads - 1) / threads, [&](size_t first, size_t last) {
+                run_conv_batch(op, in + first, out + first, static_cast<int>(last - first), step.in, op.bias);
+                if (op.relu) {
+                    for (size_t i = first; i < last; ++i) {
+                        for (size_t j = 0; j < step.out.numel(); ++j) out[i][j] = std::max(out[i][j], 0.0f);
+                    }
+                }
+            });
+        } else {
+            parallel_range(thread_pool, n, image_grain, [&](size_t first, size_t last) {
+                for (size_t i = first; i < last; ++i) {
+                    run_op(op, in[i], step.in, out[i]);
+                }
+            });
+        }
+
+        for (int i = 0; i < n; ++i) {
+            src[i] = dst[i];
+        }
+    }
+
+    const size_t classes = plan.steps.back().out.numel();
+    for (int i = 0; i < n; ++i) {
+        logits[i]->assign(src[i], src[i] + classes);
+    }
+    return true;
+}
+
+bool InferenceEngine::output_shape(const Op& op, const Shape& in, Shape& out) const {
+    switch (op.type) {
+        case OpType::Conv2d: {
+            if (in.c != op.in_channels) {
+                std::cerr << "输入通道数不符: " << op.name << std::endl;
+                return false;
+            }
+            int h = in.h + 2 * op.padding - op.kernel;
+            int w = in.w + 2 * op.padding - op.kernel;
+            if (h < 0 || w < 0) {
+                std::cerr << "输入尺寸小于卷积核: " << op.name << std::endl;
+                return false;
+            }
+            out = {op.out_channels, h / op.stride + 1, w / op.stride + 1};
+            return true;
+        }
+        case OpType::BatchNorm2d:
+            if (in.c != op.out_channels) {
+                std::cerr << "输入通道数不符: " << op.name << std::endl;
+                return false;
+            }
+            out = in;
+            return true;
+        case OpType::MaxPool2d:
+            if (in.h < op.kernel || in.w < op.kernel) {
+                std::cerr << "输入尺寸小于池化窗口: " << op.name << std::endl;
+                return false;
+            }
+            out = {in.c, (in.h - op.kernel) / op.stride + 1, (in.w - op.kernel) / op.stride + 1};
+            return true;
+        case OpType::GlobalAvgPool:
+            out = {in.c, 1, 1};
+            return true;
+        case OpType::Linear:
+            if (in.numel() != static_cast<size_t>(op.in_channels)) {
+                std::cerr << "全连接输入维度不符: " << op.name << std::endl;
+                return false;
+            }
+            out = {op.out_channels, 1, 1};
+            return true;
+    }
+    return false;
+}
+
+bool InferenceEngine::plan_activations(const Shape& input, ActivationPlan& plan) const {
+    plan.id = plan_id;
+    plan.input = input;
+    plan.steps.clear();
+
+    // 执行步骤：融合卷积块与其后并入的BN、池化算子合为一步；
+    // 相邻步骤的布局不同时插入布局转换（全局平均池化直接读取 NCHWc，输出按通道顺序）
+    auto tensor_bytes = [](const Shape& shape, int block) {
+        size_t count = block > 0 ? kernels::nchwc_size(shape.c, shape.h, shape.w, block) : shape.numel();
+        return align_arena(count * sizeof(float));
+    };
+    Shape current = input;
+    int layout = 0;
+    for (size_t k = 0; k < ops.size(); ++k) {
+        const Op& op = ops[k];
+        const bool blocked = uses_blocked_layout(op);
+        const int in_block = blocked ? op.block : (op.type == OpType::GlobalAvgPool ? layout : 0);
+        if (in_block != layout) {
+            PlanStep reorder;
+            reorder.type = StepType::Reorder;
+            reorder.in = current;
+            reorder.out = current;
+            reorder.in_block = layout;
+            reorder.out_block = in_block;
+            reorder.output_bytes = tensor_bytes(current, in_block);
+            plan.steps.push_back(reorder);
+            layout = in_block;
+        }
+
+        PlanStep step;
+        step.op = k;
+        step.in = current;
+        step.in_block = in_block;
+        step.out_block = blocked ? op.block : 0;
+        for (size_t j = k; j <= k + op.fused_ops; ++j) {
+            if (!output_shape(ops[j], current, current)) {
+                return false;
+            }
+        }
+        step.out = current;
+        step.output_bytes = tensor_bytes(step.out, step.out_block);
+        layout = step.out_block;
+
+        if (op.fused_ops > 0 && use_int8 && !op.qweight.empty()) {
+            step.scratch_bytes = static_cast<size_t>(op.qweight.channel_groups) * step.in.h * step.in.w * 4;
+        } else if (op.fused_ops > 0 && op.backend != ConvBackend::Direct) {
+            step.scratch_bytes = static_cast<size_t>(op.out_channels) * step.in.h * step.in.w * sizeof(float);
+        }
+        plan.steps.push_back(step);
+        k += op.fused_ops;
+    }
+
+    // 生存期：第 k 步的输出在第 k+1 步读完后释放，临时缓冲区只在本步内使用
+    std::vector<BufferLifetime> buffers;
+    const int last = static_cast<int>(plan.steps.size()) - 1;
+    for (int k = 0; k <= last; ++k) {
+        const PlanStep& step = plan.steps[k];
+        buffers.push_back({step.output_bytes, k, std::min(k + 1, last)});
+        buffers.push_back({step.scratch_bytes, k, k});
+    }
+    plan.arena_bytes = plan_buffer_offsets(buffers);
+    plan.naive_bytes = 0;
+    for (int k = 0; k <= last; ++k) {
+        PlanStep& step = plan.steps[k];
+        step.output = buffers[2 * k].offset;
+        step.scratch = buffers[2 * k + 1].offset;
+        step.scratch_bytes = align_arena(step.scratch_bytes);
+        plan.naive_bytes += step.output_bytes + step.scratch_bytes;
+    }
+    return true;
+}
+
+bool InferenceEngine::get_activation_footprint(const std::vector<int>& input, size_t& arena_bytes,
+                                               size_t& naive_bytes) const {
+    if (ops.empty() || input.size() != 3) {
+        return false;
+    }
+    ActivationPlan plan;
+    if (!plan_activations({input[0], input[1], input[2]}, plan)) {
+        return false;
+    }
+    arena_bytes = plan.arena_bytes;
+    naive_bytes = plan.naive_bytes;
+    return true;
+}
+
+void InferenceEngine::invalidate_plan() {
+    plan_id = next_plan_id();
+}
+
+bool InferenceEngine::calibrate(const Tensor& input) {
+    ForwardResult result;
+    if (!forward(input, result)) {
+        return false;
+    }
+
+    for (size_t k = 0; k < ops.size(); ++k) {
+        Op& op = ops[k];
+        if (op.type != OpType::Conv2d) continue;
+
+        const Tensor& in = k == 0 ? input : result.activations[k - 1].second;
+        auto range = std::minmax_element(in.data.begin(), in.data.end());
+        if (range.first == in.data.end()) continue;
+        if (op.calibrated) {
+            op.input_min = std::min(op.input_min, *range.first);
+            op.input_max = std::max(op.input_max, *range.second);
+        } else {
+            op.input_min = *range.first;
+            op.input_max = *range.second;
+            op.calibrated = true;
+        }
+    }
+    return true;
+}
+
+int InferenceEngine::quantize_int8() {
+    int layers = 0;
+    for (Op& op : ops) {
+        op.qweight = kernels::QuantizedConvWeights();
+        op.qscale.clear();
+        // INT8内核只实现了融合卷积块，激活值按无符号量化，第一层（输入已归一化到[-1, 1]）保持float
+        if (op.fused_ops == 0 || !op.calibrated || op.input_min < 0.0f || op.input_max <= 0.0f) {
+            continue;
+        }
+
+        op.input_scale = op.input_max / kernels::kInt8ActivationMax;
+        kernels::quantize_conv3x3_weights(op.weight, op.out_channels, op.in_channels, op.qweight);
+        op.qscale.resize(op.out_channels);
+        for (int oc = 0; oc < op.out_channels; ++oc) {
+            op.qscale[oc] = op.input_scale * op.qweight.scales[oc] * op.scale[oc];
+        }
+        ++layers;
+    }
+
+    use_int8 = layers > 0;
+    invalidate_plan();
+    std::cout << "INT8量化完成: " << layers << " 个卷积层 ("
+              << kernels::int8_isa_name(kernels::best_int8_isa()) << ")" << std::endl;
+    return layers;
+}
+
+void InferenceEngine::set_int8(bool enabled) {
+    use_int8 = enabled;
+    invalidate_plan();
+}
+
+std::vector<InferenceEngine::BlockParams> InferenceEngine::get_fused_blocks() const {
+    std::vector<BlockParams> blocks;
+    for (const Op& op : ops) {
+        if (op.fused_ops == 0) continue;
+        BlockParams p;
+        p.name = op.name;
+        p.in_channels = op.in_channels;
+        p.out_channels = op.out_channels;
+        p.weight = op.weight;
+        p.scale = op.scale.data();
+        p.shift = op.shift.data();
+        blocks.push_back(p);
+    }
+    return blocks;
+}
+
+bool InferenceEngine::get_classifier(LinearParams& params) const {
+    for (auto it = ops.rbegin(); it != ops.rend(); ++it) {
+        if (it->type != OpType::Linear) continue;
+        params.name = it->name;
+        params.in_features = it->in_channels;
+        params.out_features = it->out_channels;
+        params.weight = it->weight;
+        params.bias = it->bias;
+        return true;
+    }
+    return false;
+}
+
+void InferenceEngine::set_blocked_layout(bool enabled) {
+    use_blocked = enabled;
+    for (Op& op : ops) {
+        if (op.type == OpType::Conv2d && op.auto_backend) op.backend = auto_conv_backend(op);
+    }
+    invalidate_plan();
+}
+
+bool InferenceEngine::uses_blocked_layout(const Op& op) const {
+    return use_blocked && op.fused_ops > 0 && op.block > 0 && op.backend == ConvBackend::Direct &&
+           !(use_int8 && !op.qweight.empty());
+}
+
+std::vector<std::string> InferenceEngine::get_blocked_layers() const {
+    std::vector<std::string> result;
+    for (const Op& op : ops) {
+        if (uses_blocked_layout(op)) result.push_back(op.name);
+    }
+    return result;
+}
+
+std::vector<std::string> InferenceEngine::get_int8_layers() const {
+    std::vector<std::string> result;
+    for (const Op& op : ops) {
+        if (!op.qweight.empty()) result.push_back(op.name);
+    }
+    return result;
+}
+
+bool InferenceEngine::run_op(const Op& op, const Tensor& in, Tensor& out) const {
+    const Shape shape{in.dim(0), in.dim(1), in.dim(2)};
+    Shape result;
+    if (!output_shape(op, shape, result)) {
+        return false;
+    }
+
+    if (op.type == OpType::GlobalAvgPool || op.type == OpType::Linear) {
+        out.shape = {result.c};
+    } else {
+        out.shape = {result.c, result.h, result.w};
+    }
+    out.data.resize(result.numel());
+    run_op(op, in.data.data(), shape, out.data.data());
+    return true;
+}
+
+void InferenceEngine::run_op(const Op& op, const float* in, const Shape& shape, float* out) const {
+    switch (op.type) {
+        case OpType::Conv2d: run_conv(op, in, shape, out); break;
+        case OpType::BatchNorm2d: run_batchnorm(op, in, shape, out); break;
+        case OpType::MaxPool2d: run_maxpool(op, in, shape, out); break;
+        case OpType::GlobalAvgPool: run_global_avg_pool(in, shape, out); break;
+        case OpType::Linear: run_linear(op, in, out); break;
+    }
+
+    if (op.relu) {
+        Shape result;
+        output_shape(op, shape, result);
+        for (size_t i = 0; i < result.numel(); ++i) out[i] = std::max(out[i], 0.0f);
+    }
+}
+
+InferenceEngine::ConvBackend InferenceEngine::auto_conv_backend(const Op& op) const {
+    // 分块布局的融合块沿输出通道向量化，对小特征图也能用满向量，比Winograd更快
+    if (op.fused_ops > 0 && op.block > 0 && use_blocked) {
+        return ConvBackend::Direct;
+    }
+    // 直接卷积只对 3×3 s1 p1 有SIMD实现，其他形状总是使用Gemm
+    bool direct_kernel = op.kernel == 3 && op.stride == 1 && op.padding == 1;
+    if (op.in_channels >= kWinogradMinChannels && conv_backend_supported(op, ConvBackend::Winograd4)) {
+        return ConvBackend::Winograd4;
+    }
+    // 融合块的直接卷积不写回池化前的特征图，比Gemm + 后处理更快
+    if (op.fused_ops > 0) {
+        return ConvBackend::Direct;
+    }
+    return direct_kernel && op.in_channels < kGemmMinChannels ? ConvBackend::Direct : ConvBackend::Gemm;
+}
+
+bool InferenceEngine::conv_backend_supported(const Op& op, ConvBackend backend) {
+    switch (backend) {
+        case ConvBackend::Winograd2: return !op.winograd2.empty();
+        case ConvBackend::Winograd4: return !op.winograd4.empty();
+        default: return true;
+    }
+}
+
+bool InferenceEngine::set_conv_backend(const std::string& layer, ConvBackend backend) {
+    bool found = false;
+    for (Op& op : ops) {
+        if (op.type != OpType::Conv2d || (!layer.empty() && op.name != layer)) continue;
+        op.auto_backend = backend == ConvBackend::Auto || !conv_backend_supported(op, backend);
+        op.backend = op.auto_backend ? auto_conv_backend(op) : backend;
+        found = true;
+    }
+    if (found) {
+        invalidate_plan();
+    }
+    return found;
+}
+
+InferenceEngine::ConvBackend InferenceEngine::get_conv_backend(const std::string& layer) const {
+    for (const Op& op : ops) {
+        if (op.type == OpType::Conv2d && op.name == layer) return op.backend;
+    }
+    return ConvBackend::Auto;
+}
+
+std::vector<std::pair<std::string, InferenceEngine::ConvBackend>> InferenceEngine::get_conv_backends() const {
+    std::vector<std::pair<std::string, ConvBackend>> result;
+    for (const Op& op : ops) {
+        if (op.type == OpType::Conv2d) result.emplace_back(op.name, op.backend);
+    }
+    return result;
+}
+
+const char* InferenceEngine::conv_backend_name(ConvBackend backend) {
+    switch (backend) {
+        case ConvBackend::Auto: return "auto";
+        case ConvBackend::Direct: return "direct";
+        case ConvBackend::Gemm: return "gemm";
+        case ConvBackend::Winograd2: return "winograd2";
+        case ConvBackend::Winograd4: return "winograd4";
+    }
+    return "unknown";
+}
+
+bool InferenceEngine::parse_conv_backend(const std::string& text, ConvBackend& backend) {
+    for (ConvBackend b : {ConvBackend::Auto, ConvBackend::Direct, ConvBackend::Gemm,
+                          ConvBackend::Winograd2, ConvBackend::Winograd4}) {
+        if (text == conv_backend_name(b)) {
+            backend = b;
+            return true;
+        }
+    }
+    return false;
+}
+
+void InferenceEngine::run_conv(const Op& op, const float* in, const Shape& shape, float* out) const {
+    const int C = op.in_channels;
+    const int H = shape.h;
+    const int W = shape.w;
+    const int K = op.kernel;
+    const int OH = (H + 2 * op.padding - K) / op.stride + 1;
+    const int OW = (W + 2 * op.padding - K) / op.stride + 1;
+
+    if (op.backend == ConvBackend::Gemm) {
+        kernels::conv2d_gemm(&in, 1, C, H, W, K, op.stride, op.padding, op.packed_weight, op.bias, &out);
+        return;
+    }
+
+    if (op.backend == ConvBackend::Winograd2 || op.backend == ConvBackend::Winograd4) {
+        const kernels::WinogradWeights& weights =
+            op.backend == ConvBackend::Winograd2 ? op.winograd2 : op.winograd4;
+        kernels::conv3x3_winograd(&in, 1, C, H, W, weights, op.bias, &out);
+        return;
+    }
+
+    // BadgeCNN 的卷积全部是 3×3 s1 p1，走SIMD专用内核
+    if (K == 3 && op.stride == 1 && op.padding == 1) {
+        kernels::conv3x3_s1p1(in, C, H, W, op.weight, op.bias, op.out_channels, out);
+        return;
+    }
+
+    for (int oc = 0; oc < op.out_channels; ++oc) {
+        float* dst = out + static_cast<size_t>(oc) * OH * OW;
+        float b = op.bias ? op.bias[oc] : 0.0f;
+        std::fill(dst, dst + static_cast<size_t>(OH) * OW, b);
+
+        for (int ic = 0; ic < C; ++ic) {
+            const float* src = in + static_cast<size_t>(ic) * H * W;
+            const float* k = op.weight + (static_cast<size_t>(oc) * C + ic) * K * K;
+
+            for (int ky = 0; ky < K; ++ky) {
+                for (int kx = 0; kx < K; ++kx) {
+                    float w = k[ky * K + kx];
+                    for (int oy = 0; oy < OH; ++oy) {
+                        int iy = oy * op.stride + ky - op.padding;
+                        if (iy < 0 || iy >= H) continue;
+                        const float* srow = src + static_cast<size_t>(iy) * W;
+                        float* drow = dst + static_cast<size_t>(oy) * OW;
+                        for (int ox = 0; ox < OW; ++ox) {
+                            int ix = ox * op.stride + kx - op.padding;
+                            if (ix < 0 || ix >= W) continue;
+                            drow[ox] += w * srow[ix];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void InferenceEngine::run_conv_batch(const Op& op, const float* const* src, float* const* dst, int n,
+                                     const Shape& shape, const float* bias) const {
+    const int C = op.in_channels;
+    const int H = shape.h;
+    const int W = shape.w;
+    switch (op.backend) {
+        case ConvBackend::Winograd2:
+            kernels::conv3x3_winograd(src, n, C, H, W, op.winograd2, bias, dst);
+            break;
+        case ConvBackend::Winograd4:
+            kernels::conv3x3_winograd(src, n, C, H, W, op.winograd4, bias, dst);
+            break;
+        default:
+            kernels::conv2d_gemm(src, n, C, H, W, op.kernel, op.stride,
+                                 op.padding, op.packed_weight, bias, dst);
+            break;
+    }
+}
+
+void InferenceEngine::run_block_batch(const Op& op, const float* const* src, float* const* dst, int n,
+                                      const Shape& shape, int block, float* conv) const {
+    const int H = shape.h;
+    const int W = shape.w;
+
+    // 分块布局：沿输出通道向量化的融合内核
+    if (block > 0) {
+        for (int i = 0; i < n; ++i) {
+            kernels::conv3x3_bn_relu_pool2_nchwc(src[i], op.in_channels, H, W, op.blocked_weight.data(),
+                                                 op.scale.data(), op.shift.data(), op.out_channels,
+                                                 block, dst[i]);
+        }
+        return;
+    }
+
+    // 直接卷积：BN、ReLU和池化在卷积内核的寄存器中完成
+    if (op.backend == ConvBackend::Direct) {
+        for (int i = 0; i < n; ++i) {
+            kernels::conv3x3_bn_relu_pool2(src[i], op.in_channels, H, W, op.weight,
+                                           op.scale.data(), op.shift.data(), op.out_channels, dst[i]);
+        }
+        return;
+    }
+
+    // Gemm / Winograd：卷积结果（不含偏置）写入临时缓冲区，再单趟完成 BN + ReLU + 池化
+    const size_t conv_size = static_cast<size_t>(op.out_channels) * H * W;
+    thread_local std::vector<float*> conv_dst;
+    conv_dst.resize(n);
+    for (int i = 0; i < n; ++i) {
+        conv_dst[i] = conv + i * conv_size;
+    }
+    run_conv_batch(op, src, conv_dst.data(), n, shape, nullptr);
+    for (int i = 0; i < n; ++i) {
+        kernels::bn_relu_pool2(conv_dst[i], op.out_channels, H, W, op.scale.data(), op.shift.data(), dst[i]);
+    }
+}
+
+void InferenceEngine::run_block_parallel(const Op& op, const float* const* src, float* const* dst, int n,
+                                         const Shape& shape, int block, float* conv) const {
+    const int threads = thread_pool ? thread_pool->size() : 1;
+    if (threads <= 1) {
+        run_block_batch(op, src, dst, n, shape, block, conv);
+        return;
+    }
+
+    const int C = op.in_channels;
+    const int H = shape.h;
+    const int W = shape.w;
+    const int OC = op.out_channels;
+    const size_t pooled = static_cast<size_t>(H / 2) * (W / 2);
+
+    // 融合的直接卷积：按 (图像, 输出通道块, 池化行分块) 拆分。
+    // 平面布局的内核每次计算4个输出通道，按4个通道一组；分块布局一组为一个通道块，
+    // 通道块较少（conv2 只有2个），再按池化行分块，使每张图像也能拆成足够多的任务
+    if (block > 0 || op.backend == ConvBackend::Direct) {
+        const int group = block > 0 ? block : 4;
+        const int groups = (OC + group - 1) / group;
+        const int PH = H / 2;
+        const size_t row_work = static_cast<size_t>(2) * W * group * C * 9;
+        const int rows = block > 0 ? static_cast<int>(std::clamp<size_t>(
+                                         (kMinTaskWork + row_work - 1) / row_work, 1, std::max(PH, 1)))
+                                   : PH;
+        const int tiles = std::max(1, (PH + rows - 1) / rows);
+        const size_t per_image = static_cast<size_t>(groups) * tiles;
+
+        thread_pool->parallel_for(0, n * per_image, 1, [&](size_t first, size_t last) {
+            for (size_t t = first; t < last; ++t) {
+                const size_t i = t / per_image;
+                const int oc = static_cast<int>(t % per_image / tiles) * group;
+                const int row = static_cast<int>(t % tiles) * rows;
+                const int count = std::min(group, OC - oc);
+                const size_t k = static_cast<size_t>(oc) * C * 9;
+                if (block > 0) {
+                    kernels::conv3x3_bn_relu_pool2_nchwc(src[i], C, H, W, op.blocked_weight.data() + k,
+                                                         op.scale.data() + oc, op.shift.data() + oc, count,
+                                                         block, dst[i] + oc * pooled, row, row + rows);
+                } else {
+                    kernels::conv3x3_bn_relu_pool2(src[i], C, H, W, op.weight + k, op.scale.data() + oc,
+                                                   op.shift.data() + oc, count, dst[i] + oc * pooled);
+                }
+            }
+        });
+        return;
+    }
+
+    // Gemm / Winograd：整批计算更快，按线程数均分为几个子批，各子批使用各自的卷积结果缓冲区
+    const size_t conv_size = static_cast<size_t>(OC) * H * W;
+    thread_pool->parallel_for(0, n, (n + threads - 1) / threads, [&](size_t first, size_t last) {
+        run_block_batch(op, src + first, dst + first, static_cast<int>(last - first), shape, block,
+                        conv + first * conv_size);
+    });
+}
+
+void InferenceEngine::run_reorder(const PlanStep& step, const float* const* src, float* const* dst,
+                                  int n) const {
+    const Shape& s = step.in;
+    for (int i = 0; i < n; ++i) {
+        if (step.out_block > 0) {
+            kernels::reorder_nchw_to_nchwc(src[i], s.c, s.h, s.w, step.out_block, dst[i]);
+        } else {
+            kernels::reorder_nchwc_to_nchw(src[i], s.c, s.h, s.w, step.in_block, dst[i]);
+        }
+    }
+}
+
+void InferenceEngine::run_block_int8_batch(const Op& op, const float* const* src, float* const* dst, int n,
+                                           const Shape& shape, uint8_t* quantized) const {
+    // 量化后的输入按 [C/4][H][W][4] 存放，只占float的1/4，逐张复用
+    for (int i = 0; i < n; ++i) {
+        kernels::quantize_activations(src[i], op.in_channels, shape.h, shape.w, op.input_scale, quantized);
+        kernels::conv3x3_int8_bn_relu_pool2(quantized, shape.h, shape.w, op.qweight, op.qscale.data(),
+                                            op.shift.data(), dst[i]);
+    }
+}
+
+void InferenceEngine::run_batchnorm(const Op& op, const float* in, const Shape& shape, float* out) const {
+    size_t plane = static_cast<size_t>(shape.h) * shape.w;
+    for (int c = 0; c < op.out_channels; ++c) {
+        const float* src = in + c * plane;
+        float* dst = out + c * plane;
+        for (size_t i = 0; i < plane; ++i) {
+            dst[i] = src[i] * op.scale[c] + op.shift[c];
+        }
+    }
+}
+
+void InferenceEngine::run_maxpool(const Op& op, const float* in, const Shape& shape, float* out) const {
+    const int C = shape.c;
+    const int H = shape.h;
+    const int W = shape.w;
+    const int OH = (H - op.kernel) / op.stride + 1;
+    const int OW = (W - op.kernel) / op.stride + 1;
+
+    for (int c = 0; c < C; ++c) {
+        const float* src = in + static_cast<size_t>(c) * H * W;
+        float* dst = out + static_cast<size_t>(c) * OH * OW;
+        for (int oy = 0; oy < OH; ++oy) {
+            for (int ox = 0; ox < OW; ++ox) {
+                float m = -INFINITY;
+                for (int ky = 0; ky < op.kernel; ++ky) {
+                    for (int kx = 0; kx < op.kernel; ++kx) {
+                        m = std::max(m, src[(oy * op.stride + ky) * W + ox * op.stride + kx]);
+                    }
+                }
+                dst[oy * OW + ox] = m;
+            }
+        }
+    }
+}
+
+void InferenceEngine::run_global_avg_pool(const float* in, const Shape& shape, float* out) const {
+    size_t plane = static_cast<size_t>(shape.h) * shape.w;
+    for (int c = 0; c < shape.c; ++c) {
+        const float* src = in + c * plane;
+        double sum = 0.0;
+        for (size_t i = 0; i < plane; ++i) sum += src[i];
+        out[c] = static_cast<float>(sum / plane);
+    }
+}
+
+void InferenceEngine::run_linear(const Op& op, const float* in, float* out) const {
+    for (int o = 0; o < op.out_channels; ++o) {
+        const float* w = op.weight + static_cast<size_t>(o) * op.in_channels;
+        float sum = op.bias ? op.bias[o] : 0.0f;
+        for (int i = 0; i < op.in_channels; ++i) sum += w[i] * in[i];
+        out[o] = sum;
+    }
+}
@@ -0,0 +1,304 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "loader/ModelLoader.hpp"
+#include "engine/kernels/Sgemm.hpp"
+#include "engine/kernels/Winograd.hpp"
+#include "engine/kernels/Int8Conv.hpp"
+#include "engine/MemoryPlan.hpp"
+
+class ThreadPool;
+
+// 单张特征图（batch=1），按 CHW 行优先存储
+struct Tensor {
+    std::vector<int> shape;           // [C, H, W] 或 [N]
+    std::vector<float> data;
+
+    size_t numel() const { return data.size(); }
+    int dim(size_t i) const { return i < shape.size() ? shape[i] : 1; }
+};
+
+// 一次前向传播的全部结果
+struct ForwardResult {
+    // 每个结构层的输出，顺序与 ModelLoader::structure 一致
+    // 例如 "conv1"（卷积输出）、"batchnorm1"（BN+ReLU）、"maxpool1"（块输出）
+    std::vector<std::pair<std::string, Tensor>> activations;
+    std::vector<float> logits;
+
+    // 按层名查找中间结果，找不到时返回nullptr
+    const Tensor* find(const std::string& name) const;
+};
+
+// 输入预处理参数，默认与 python/infer.py 一致：
+// 灰度 -> Resize(64) -> ToTensor -> Normalize(0.5, 0.5)
+struct PreprocessOptions {
+    int size = 64;
+    bool keep_aspect = true;          // true: 短边缩放到size（T.Resize(64)）；false: 缩放到 size x size
+    bool normalize = true;            // (x - 0.5) / 0.5；导出参考激活时未归一化
+};
+
+// 把 8 位图像（1/3/4 通道，行优先）转换为网络输入 [1, H, W]
+// 不依赖SFML，命令行工具和可视化界面共用
+Tensor preprocess_image(const uint8_t* pixels, int width, int height, int channels,
+                        const PreprocessOptions& options = PreprocessOptions());
+
+// BadgeCNN 原生前向推理引擎
+// 按 ModelLoader::structure 中的层序列（conv2d / batchnorm2d / maxpool2d /
+// adaptive_avg_pool2d / linear）构建执行计划，参数直接引用ModelLoader中的张量，
+// 引擎的生命周期不能超过所用的ModelLoader。
+class InferenceEngine {
+public:
+    // 卷积实现
+    // Direct: 直接卷积（3×3 s1 p1 使用SIMD专用内核）
+    // Gemm:   im2col + 分块SGEMM，权重在构建时打包；通道数多的层缓存复用更好，批量输入时收益最大
+    // Winograd2 / Winograd4: Winograd F(2×2,3×3) / F(4×4,3×3)，仅 3×3 s1 p1；
+    //         滤波器变换由ModelLoader在加载时预先计算，通道多、特征图小的层收益最大
+    // Auto:   按层选择，可使用分块布局的融合卷积块使用Direct；
+    //         其余层中，输入通道数不少于 kWinogradMinChannels 的 3×3 s1 p1 层使用Winograd4，
+    //         可融合的卷积块使用Direct（融合内核），输入通道数不少于 kGemmMinChannels 的层使用Gemm
+    enum class ConvBackend {
+        Auto,
+        Direct,
+        Gemm,
+        Winograd2,
+        Winograd4
+    };
+
+    static constexpr int kGemmMinChannels = 32;
+    static constexpr int kWinogradMinChannels = 64;
+
+    // 根据模型结构构建执行计划
+    // BN层缺少 running_mean/running_var 或 eps 时失败，除非已调用 set_allow_missing_bn_stats(true)
+    bool build(const ModelLoader& model);
+
+    // 允许BN层缺少统计量，按均值0、方差1、eps=1e-5 近似（仅用于查看旧版导出的模型），需在 build 之前设置
+    void set_allow_missing_bn_stats(bool allowed) { allow_missing_bn_stats = allowed; }
+
+    // 执行前向传播；input 形状为 [C, H, W]，通道数需与第一层一致
+    // 网络以全局平均池化结尾，空间尺寸不必与训练时相同
+    bool forward(const Tensor& input, ForwardResult& result) const;
+
+    // 批量前向传播，只返回每张图像的 logits；形状相同的输入逐层一起计算，
+    // 使用Gemm / Winograd的卷积层对整批输入一起计算；
+    // Conv -> BN -> ReLU -> MaxPool 2×2 的卷积块融合执行，池化前的特征图不写回内存。
+    // 中间结果放在按生存期规划的线程局部arena中，同一形状的输入重复调用时不再分配堆内存
+    // （logits 复用调用方已有的容量）。
+    // 启用分块布局时，融合卷积块之间的激活值按 NCHWc 存放（见 kernels/Layout.hpp），
+    // 在输入侧与全局平均池化处插入布局转换；forward 的逐层结果始终为 NCHW
+    bool forward_batch(const std::vector<Tensor>& inputs, std::vector<std::vector<float>>& logits) const;
+
+    // 设置卷积层的实现，layer 为空时作用于全部卷积层；找不到该层时返回false
+    // 不支持Winograd的层（非 3×3 s1 p1）改用Auto对应的实现
+    bool set_conv_backend(const std::string& layer, ConvBackend backend);
+    ConvBackend get_conv_backend(const std::string& layer) const;
+    // 各卷积层名称及当前实现
+    std::vector<std::pair<std::string, ConvBackend>> get_conv_backends() const;
+
+    // INT8 训练后量化：
+    // calibrate 用float前向传播统计各卷积层输入的取值范围，逐张调用以累积整个标定集；
+    // quantize_int8 把已标定、输入非负（位于ReLU之后）的融合卷积块的权重按输出通道对称量化为int8，
+    // 激活值按标定的最大值量化为 0..127，返回量化的层数并启用INT8。
+    // 启用后 forward_batch 对这些层使用INT8内核，forward 仍按float计算（可视化及对比用）
+    bool calibrate(const Tensor& input);
+    int quantize_int8();
+    void set_int8(bool enabled);
+    bool is_int8() const { return use_int8; }
+    // 已量化的卷积层名称
+    std::vector<std::string> get_int8_layers() const;
+
+    // forward_batch 中的融合卷积块（Direct）是否使用 NCHWc 分块布局，默认在AVX2 / AVX-512上启用；
+    // 输入和输出通道数须为通道块大小（8 / 16）的倍数
+    void set_blocked_layout(bool enabled);
+    bool is_blocked_layout() const { return use_blocked; }
+    // 使用分块布局的卷积层名称
+    std::vector<std::string> get_blocked_layers() const;
+
+    // forward_batch 使用的线程池（不持有），nullptr 时在调用线程上串行执行（默认）。
+    // 设置后批内的图像、融合卷积块的输出通道块和池化行分块作为任务在池中并行；
+    // 可以在池内的任务中调用（批间并行时嵌套）
+    void set_thread_pool(ThreadPool* pool) { thread_pool = pool; }
+    ThreadPool* get_thread_pool() const { return thread_pool; }
+
+    static const char* conv_backend_name(ConvBackend backend);
+    static bool parse_conv_backend(const std::string& text, ConvBackend& backend);
+
+    // 融合卷积块（按执行顺序）与最后一个全连接层的参数，指针指向引擎和ModelLoader内部的数据；
+    // 供编译期特化的 StaticNetwork 复制使用
+    struct BlockParams {
+        std::string name;
+        int in_channels = 0;
+        int out_channels = 0;
+        const float* weight = nullptr;    // [OC][C][3][3]
+        const float* scale = nullptr;     // 并入BN与卷积偏置后的逐通道仿射
+        const float* shift = nullptr;
+    };
+    struct LinearParams {
+        std::string name;
+        int in_features = 0;
+        int out_features = 0;
+        const float* weight = nullptr;    // [out][in]
+        const float* bias = nullptr;
+    };
+    std::vector<BlockParams> get_fused_blocks() const;
+    bool get_classifier(LinearParams& params) const;
+
+    bool is_ready() const { return !ops.empty(); }
+    const std::vector<int>& get_input_shape() const { return input_shape; }
+    int get_num_classes() const { return num_classes; }
+
+    // 单张图像的激活值arena大小（字节），以及逐层单独分配时的总大小；input 为 [C, H, W]。
+    // 两者都不含卷积内核自己的 thread_local 临时缓冲区（见 MemoryPlan.hpp）
+    bool get_activation_footprint(const std::vector<int>& input, size_t& arena_bytes, size_t& naive_bytes) const;
+
+private:
+    enum class OpType {
+        Conv2d,
+        BatchNorm2d,
+        MaxPool2d,
+        GlobalAvgPool,
+        Linear
+    };
+
+    struct Op {
+        std::string name;
+        OpType type;
+        bool relu = false;            // 输出后接ReLU
+
+        // 卷积 / 池化参数
+        int in_channels = 0;
+        int out_channels = 0;
+        int kernel = 1;
+        int stride = 1;
+        int padding = 0;
+
+        // 参数：weight / bias 指向两个视图的数据（float32 为ModelLoader中的映射数据，
+        // 低精度模型为视图持有的反量化结果，由算子持有以免ModelLoader常驻float副本）
+        TensorView weight_view;
+        TensorView bias_view;
+        const float* weight = nullptr;
+        const float* bias = nullptr;
+
+        // 卷积实现及Gemm / Winograd使用的打包权重
+        ConvBackend backend = ConvBackend::Direct;
+        bool auto_backend = true;     // 由Auto选择（分块布局开关改变时重新选择）
+        kernels::PackedMatrix packed_weight;
+        kernels::WinogradWeights winograd2;
+        kernels::WinogradWeights winograd4;
+
+        // BN 推理时的逐通道仿射：y = x * scale + shift
+        // 融合卷积块的卷积算子中保存其后BN的 scale，以及并入卷积偏置后的 shift
+        // （BN已折叠进卷积时 scale 为1、shift 为卷积偏置）
+        std::vector<float> scale;
+        std::vector<float> shift;
+
+        // 卷积块融合执行时并入本算子的后续算子数：BN+ReLU 与池化为2，仅池化（BN已折叠）为1；
+        // forward_batch 跳过这些算子
+        int fused_ops = 0;
+
+        // INT8：标定得到的输入取值范围、量化权重，以及反量化并入BN后的逐通道 scale
+        float input_min = 0.0f;
+        float input_max = 0.0f;
+        bool calibrated = false;
+        float input_scale = 0.0f;
+        kernels::QuantizedConvWeights qweight;
+        std::vector<float> qscale;
+
+        // 分块布局：通道块大小（0 表示该层不能使用）及 [OC/cb][C][3][3][cb] 的权重
+        int block = 0;
+        std::vector<float> blocked_weight;
+    };
+
+    struct Shape {
+        int c = 0;
+        int h = 1;
+        int w = 1;
+
+        size_t numel() const { return static_cast<size_t>(c) * h * w; }
+        bool operator==(const Shape& other) const { return c == other.c && h == other.h && w == other.w; }
+    };
+
+    // forward_batch 的执行步骤（融合卷积块为一步，或者布局转换）及其缓冲区在arena中的位置。
+    // 按单张图像规划：n 张图像时每个缓冲区的偏移和大小都乘以 n，第 i 张图像位于 偏移·n + i·大小
+    enum class StepType {
+        Op,
+        Reorder
+    };
+
+    struct PlanStep {
+        StepType type = StepType::Op;
+        size_t op = 0;                // ops 下标
+        Shape in;
+        Shape out;
+        int in_block = 0;             // 输入 / 输出的通道块大小，0 为 NCHW
+        int out_block = 0;
+        size_t output = 0;            // 输出偏移（字节）
+        size_t output_bytes = 0;      // 按 kArenaAlignment 对齐
+        size_t scratch = 0;           // 临时缓冲区：Gemm/Winograd融合块的卷积结果，或INT8量化后的输入（内核内部的临时缓冲区不在此列）
+        size_t scratch_bytes = 0;
+    };
+
+    struct ActivationPlan {
+        uint64_t id = 0;              // 对应的 plan_id
+        Shape input;
+        std::vector<PlanStep> steps;
+        size_t arena_bytes = 0;
+        size_t naive_bytes = 0;       // 不复用时各缓冲区大小之和
+    };
+
+    std::vector<Op> ops;
+    std::vector<int> input_shape;
+    int num_classes = 0;
+    bool use_int8 = false;
+    bool use_blocked = true;
+    bool allow_missing_bn_stats = false;
+    ThreadPool* thread_pool = nullptr;
+    // 执行方式（算子、卷积实现、INT8）改变时更新，使线程缓存的内存规划失效；全局唯一
+    uint64_t plan_id = 0;
+
+    void invalidate_plan();
+    // 单个算子的输出形状，输入形状不符时返回false
+    bool output_shape(const Op& op, const Shape& in, Shape& out) const;
+    bool plan_activations(const Shape& input, ActivationPlan& plan) const;
+    // 该算子在当前设置下是否使用分块布局
+    bool uses_blocked_layout(const Op& op) const;
+
+    bool build_conv(const ModelLoader& model, const LayerStructure& s, Op& op);
+    bool build_batchnorm(const ModelLoader& model, const LayerStructure& s,
+                         const std::string& prev_conv, Op& op);
+    bool build_linear(const ModelLoader& model, const LayerStructure& s, Op& op);
+    // 标记可融合的 Conv 3×3 s1 p1 -> BN+ReLU -> MaxPool 2×2 s2 卷积块
+    // （以及BN已折叠的 Conv+ReLU -> MaxPool），返回块数
+    int fuse_conv_blocks();
+
+    // Auto 对应的实际实现
+    ConvBackend auto_conv_backend(const Op& op) const;
+    // 该层是否可以使用指定的实现
+    static bool conv_backend_supported(const Op& op, ConvBackend backend);
+
+    // 执行单个算子（含ReLU），输入形状不符时返回false
+    bool run_op(const Op& op, const Tensor& in, Tensor& out) const;
+    // 同上，输出写入 out（需容纳 output_shape 的大小），不检查形状
+    void run_op(const Op& op, const float* in, const Shape& shape, float* out) const;
+    bool forward_group(const std::vector<const Tensor*>& inputs, std::vector<std::vector<float>*>& logits) const;
+
+    // 批量版本的 src / dst 为 n 张图像的指针
+    void run_conv(const Op& op, const float* in, const Shape& shape, float* out) const;
+    void run_conv_batch(const Op& op, const float* const* src, float* const* dst, int n,
+                        const Shape& shape, const float* bias) const;
+    // conv 为 n 张图像卷积结果的临时缓冲区（Gemm / Winograd使用，每张 out_channels·H·W）；
+    // block 非0时输入输出为该通道块大小的 NCHWc
+    void run_block_batch(const Op& op, const float* const* src, float* const* dst, int n,
+                         const Shape& shape, int block, float* conv) const;
+    // 以上批量算子的并行版本：有线程池时拆成任务，否则与 run_block_batch 相同
+    void run_block_parallel(const Op& op, const float* const* src, float* const* dst, int n,
+                            const Shape& shape, int block, float* conv) const;
+    void run_reorder(const PlanStep& step, const float* const* src, float* const* dst, int n) const;
+    // quantized 为量化后输入的临时缓冲区（channel_groups·H·W·4 字节，逐张复用）
+    void run_block_int8_batch(const Op& op, const float* const* src, float* const* dst, int n,
+                              const Shape& shape, uint8_t* quantized) const;
+    void run_batchnorm(const Op& op, const float* in, const Shape& shape, float* out) const;
+    void run_maxpool(const Op& op, const float* in, const Shape& shape, float* out) const;
+    void run_global_avg_pool(const float* in, const Shape& shape, float* out) const;
+    void run_linear(const Op& op, const float* in, float* out) const;
+};
@@ -0,0 +1,54 @@
+#include "engine/MemoryPlan.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+
+size_t plan_buffer_offsets(std::vector<BufferLifetime>& buffers) {
+    std::vector<size_t> order(buffers.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return buffers[a].bytes > buffers[b].bytes;
+    });
+
+    size_t total = 0;
+    std::vector<size_t> placed;
+    std::vector<const BufferLifetime*> live;
+    for (size_t index : order) {
+        BufferLifetime& buffer = buffers[index];
+        const size_t bytes = align_arena(buffer.bytes);
+
+        // 与当前缓冲区生存期重叠的已分配缓冲区，按偏移排序后找第一个放得下的空隙
+        live.clear();
+        for (size_t p : placed) {
+            if (buffers[p].overlaps(buffer)) live.push_back(&buffers[p]);
+        }
+        std::sort(live.begin(), live.end(), [](const BufferLifetime* a, const BufferLifetime* b) {
+            return a->offset < b->offset;
+        });
+
+        size_t offset = 0;
+        for (const BufferLifetime* other : live) {
+            if (offset + bytes <= other->offset) break;
+            offset = std::max(offset, other->offset + align_arena(other->bytes));
+        }
+
+        buffer.offset = offset;
+        total = std::max(total, offset + bytes);
+        placed.push_back(index);
+    }
+    return total;
+}
+
+void AlignedArena::reserve(size_t bytes) {
+    if (bytes <= size) return;
+    bytes = align_arena(bytes);
+    void* p = std::aligned_alloc(kArenaAlignment, bytes);
+    if (!p) throw std::bad_alloc();
+    storage.reset(static_cast<uint8_t*>(p));
+    size = bytes;
+}
+
+void AlignedArena::Free::operator()(uint8_t* p) const {
+    std::free(p);
+}
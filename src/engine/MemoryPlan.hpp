@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// 激活值内存规划
+// 每个缓冲区有大小和生存期 [first, last]（执行步骤下标，闭区间），生存期重叠的缓冲区不能共用内存。
+// 规划结果是每个缓冲区在一块连续arena中的偏移，推理时所有激活值都放在这块arena里。
+// 卷积内核内部的临时缓冲区（ConvGemm 的im2col列矩阵、Sgemm 的打包面板、Winograd 的变换块、
+// ConvBlock 标量路径的卷积结果）是各内核自己的 thread_local vector，不在规划范围内，也不计入arena大小。
+
+constexpr size_t kArenaAlignment = 64;
+
+inline size_t align_arena(size_t bytes) {
+    return (bytes + kArenaAlignment - 1) / kArenaAlignment * kArenaAlignment;
+}
+
+struct BufferLifetime {
+    size_t bytes = 0;
+    int first = 0;
+    int last = 0;
+    size_t offset = 0;                // 规划结果（字节）
+
+    bool overlaps(const BufferLifetime& other) const {
+        return first <= other.last && other.first <= last;
+    }
+};
+
+// 贪心分配：按大小降序，每个缓冲区放在与其生存期重叠的已分配缓冲区之间最低的空隙；
+// 偏移和大小按 kArenaAlignment 对齐。返回arena总字节数
+size_t plan_buffer_offsets(std::vector<BufferLifetime>& buffers);
+
+// 64字节对齐的内存块，只增不减，重新分配时不保留内容
+class AlignedArena {
+public:
+    void reserve(size_t bytes);
+    uint8_t* data() const { return storage.get(); }
+    size_t capacity() const { return size; }
+
+private:
+    struct Free {
+        void operator()(uint8_t* p) const;
+    };
+    std::unique_ptr<uint8_t, Free> storage;
+    size_t size = 0;
+};
@@ -0,0 +1,225 @@
+#include "engine/ThreadPool.hpp"
+#include <algorithm>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+// 当前线程所属的线程池及其队列下标（非池内线程为 nullptr）
+thread_local const ThreadPool* tls_pool = nullptr;
+thread_local size_t tls_queue = 0;
+
+// 进入休眠前反复尝试的次数：批内各层的任务间隔很短，立即休眠会让唤醒延迟占满计算时间
+constexpr int kSpinRounds = 2000;
+
+std::vector<int> allowed_cpus() {
+    std::vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+        }
+    }
+#endif
+    return cpus;
+}
+
+void pin_current_thread(int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+} // namespace
+
+void ThreadPool::TaskQueue::push(const Task& task) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count == ring.size()) {
+        std::vector<Task> grown(std::max<size_t>(16, ring.size() * 2));
+        for (size_t i = 0; i < count; ++i) {
+            grown[i] = ring[(head + i) % ring.size()];
+        }
+        ring.swap(grown);
+        head = 0;
+    }
+    ring[(head + count) % ring.size()] = task;
+    ++count;
+}
+
+bool ThreadPool::TaskQueue::pop(Task& task, const Job* job) {
+    return take(task, job, true);
+}
+
+bool ThreadPool::TaskQueue::steal(Task& task, const Job* job) {
+    return take(task, job, false);
+}
+
+bool ThreadPool::TaskQueue::take(Task& task, const Job* job, bool from_tail) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const size_t size = ring.size();
+    for (size_t k = 0; k < count; ++k) {
+        const size_t i = from_tail ? count - 1 - k : k;
+        const Task& candidate = ring[(head + i) % size];
+        if (job && candidate.job != job) continue;
+
+        task = candidate;
+        if (i == 0) {
+            head = (head + 1) % size;
+        } else {
+            // 取出中间的任务时，把它之后的任务前移一位
+            for (size_t j = i; j + 1 < count; ++j) {
+                ring[(head + j) % size] = ring[(head + j + 1) % size];
+            }
+        }
+        --count;
+        return true;
+    }
+    return false;
+}
+
+ThreadPool::ThreadPool() : ThreadPool(Options()) {}
+
+ThreadPool::ThreadPool(const Options& options) {
+    int threads = options.threads > 0 ? options.threads
+                                      : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<int> cpus;
+    if (options.affinity == Affinity::Compact) {
+        cpus = allowed_cpus();
+    }
+
+    queues.reserve(threads);
+    for (int i = 0; i < threads; ++i) {
+        queues.push_back(std::make_unique<TaskQueue>());
+    }
+    workers.reserve(threads - 1);
+    for (int i = 1; i < threads; ++i) {
+        int cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+        workers.emplace_back(&ThreadPool::worker_loop, this, static_cast<size_t>(i), cpu);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& t : workers) {
+        t.join();
+    }
+}
+
+size_t ThreadPool::current_queue() const {
+    return tls_pool == this ? tls_queue : 0;
+}
+
+void ThreadPool::run(size_t begin, size_t end, size_t grain,
+                     void (*invoke)(const void*, size_t, size_t), const void* context) {
+    if (begin >= end) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    if (workers.empty() || end - begin <= grain) {
+        invoke(context, begin, end);
+        return;
+    }
+
+    Job job;
+    job.invoke = invoke;
+    job.context = context;
+    job.grain = grain;
+    job.remaining.store(end - begin, std::memory_order_relaxed);
+
+    // 先处理自己拆出的前一半，再帮忙执行队列中的任务（包括其他线程拆出的），直到本次全部完成
+    const size_t queue = current_queue();
+    execute(Task{&job, begin, end}, queue);
+    while (job.remaining.load(std::memory_order_acquire) != 0) {
+        if (!try_run_one(queue, &job)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ThreadPool::execute(Task task, size_t queue) {
+    Job* job = task.job;
+    while (task.end - task.begin > job->grain) {
+        const size_t mid = task.begin + (task.end - task.begin) / 2;
+        queues[queue]->push(Task{job, mid, task.end});
+        queued.fetch_add(1);
+        if (sleeping.load() > 0) {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            wake.notify_one();
+        }
+        task.end = mid;
+    }
+    job->invoke(job->context, task.begin, task.end);
+    // 计数归零后 job 可能立即被调用方销毁，之后不能再访问
+    job->remaining.fetch_sub(task.end - task.begin, std::memory_order_acq_rel);
+}
+
+bool ThreadPool::try_run_one(size_t queue, const Job* job) {
+    Task task;
+    bool found = queues[queue]->pop(task, job);
+    for (size_t i = 1; !found && i < queues.size(); ++i) {
+        found = queues[(queue + i) % queues.size()]->steal(task, job);
+    }
+    if (!found) {
+        return false;
+    }
+    queued.fetch_sub(1);
+    execute(task, queue);
+    return true;
+}
+
+void ThreadPool::worker_loop(size_t index, int cpu) {
+    if (cpu >= 0) {
+        pin_current_thread(cpu);
+    }
+    tls_pool = this;
+    tls_queue = index;
+
+    for (;;) {
+        bool ran = false;
+        for (int spin = 0; spin < kSpinRounds && !ran; ++spin) {
+            ran = queued.load() > 0 && try_run_one(index, nullptr);
+            if (!ran) std::this_thread::yield();
+        }
+        if (ran) continue;
+
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        sleeping.fetch_add(1);
+        wake.wait(lock, [&] { return stopping || queued.load() > 0; });
+        sleeping.fetch_sub(1);
+        if (stopping && queued.load() == 0) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::parse_affinity(const std::string& text, Affinity& affinity) {
+    if (text == "none") {
+        affinity = Affinity::None;
+    } else if (text == "compact") {
+        affinity = Affinity::Compact;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* ThreadPool::affinity_name(Affinity affinity) {
+    switch (affinity) {
+        case Affinity::Compact: return "compact";
+        default: return "none";
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 工作窃取线程池
+// 每个线程有自己的任务双端队列：parallel_for 把区间二分，后一半压入当前线程队列的尾部，
+// 继续处理前一半，直到不超过 grain；线程优先从自己队列的尾部取任务（最近拆出、数据仍在缓存中），
+// 空闲时从其他队列的头部窃取（最早拆出、范围最大）。调用线程在等待期间也执行任务，
+// 因此任务内可以再调用 parallel_for（例如批间并行，每批的各层再按输出通道块和行分块并行）。
+// 等待期间只执行属于同一次 parallel_for 的任务（任务隔离）：否则等待中的线程可能执行外层的其他任务，
+// 重入仍在使用中的线程局部状态（如 InferenceEngine 的激活值arena）。
+// 不是池内线程的调用方共用一个外部队列。
+class ThreadPool {
+public:
+    enum class Affinity {
+        None,       // 不绑定，由系统调度
+        Compact     // 第 i 个工作线程绑定到进程允许的第 i+1 个CPU（调用线程通常在第0个）
+    };
+
+    struct Options {
+        int threads = 0;              // 参与计算的线程数（含调用线程），0 表示全部核心
+        Affinity affinity = Affinity::None;
+    };
+
+    ThreadPool();
+    explicit ThreadPool(const Options& options);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // 参与计算的线程数（工作线程数 + 1）
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+
+    // 对 [begin, end) 调用 body(first, last)，每段不超过 grain（至少为1）；返回时全部完成。
+    // body 在多个线程上并发执行，各段之间不能有数据竞争；不分配堆内存
+    template <typename Body>
+    void parallel_for(size_t begin, size_t end, size_t grain, const Body& body) {
+        run(begin, end, grain, [](const void* context, size_t first, size_t last) {
+            (*static_cast<const Body*>(context))(first, last);
+        }, &body);
+    }
+
+    static bool parse_affinity(const std::string& text, Affinity& affinity);
+    static const char* affinity_name(Affinity affinity);
+
+private:
+    struct Job {
+        void (*invoke)(const void* context, size_t first, size_t last) = nullptr;
+        const void* context = nullptr;
+        size_t grain = 1;
+        std::atomic<size_t> remaining{0};     // 尚未执行完的元素个数
+    };
+
+    struct Task {
+        Job* job = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    // 环形缓冲区实现的双端队列，容量只增不减
+    class TaskQueue {
+    public:
+        // job 非空时只取属于该 job 的任务（等待中的线程）
+        void push(const Task& task);
+        bool pop(Task& task, const Job* job);       // 从尾部查找（所属线程）
+        bool steal(Task& task, const Job* job);     // 从头部查找（其他线程）
+
+    private:
+        bool take(Task& task, const Job* job, bool from_tail);
+
+        std::mutex mutex;
+        std::vector<Task> ring;
+        size_t head = 0;
+        size_t count = 0;
+    };
+
+    void run(size_t begin, size_t end, size_t grain,
+             void (*invoke)(const void*, size_t, size_t), const void* context);
+    void execute(Task task, size_t queue);
+    bool try_run_one(size_t queue, const Job* job);
+    void worker_loop(size_t index, int cpu);
+    size_t current_queue() const;
+
+    // queues[0] 为外部调用方共用，queues[i] 属于第 i 个工作线程
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::atomic<size_t> queued{0};            // 各队列中的任务总数
+    std::atomic<int> sleeping{0};
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+};
@@ -0,0 +1,89 @@
+#include "engine/kernels/Conv3x3.hpp"
+#include "engine/kernels/Conv3x3Impl.hpp"
+#include <cstddef>
+
+namespace kernels {
+namespace detail {
+
+float conv3x3_pixel(const float* in, int C, int H, int W, const float* weight_oc, int y, int x) {
+    float sum = 0.0f;
+    for (int ic = 0; ic < C; ++ic) {
+        const float* src = in + static_cast<size_t>(ic) * H * W;
+        const float* k = weight_oc + ic * 9;
+        for (int ky = 0; ky < 3; ++ky) {
+            int iy = y + ky - 1;
+            if (iy < 0 || iy >= H) continue;
+            for (int kx = 0; kx < 3; ++kx) {
+                int ix = x + kx - 1;
+                if (ix < 0 || ix >= W) continue;
+                sum += src[iy * W + ix] * k[ky * 3 + kx];
+            }
+        }
+    }
+    return sum;
+}
+
+void conv3x3_s1p1_scalar(const float* in, int C, int H, int W,
+                         const float* weight, const float* bias, int OC, float* out) {
+    const size_t plane = static_cast<size_t>(H) * W;
+    for (int oc = 0; oc < OC; ++oc) {
+        float* dst = out + oc * plane;
+        float b = bias ? bias[oc] : 0.0f;
+        for (size_t i = 0; i < plane; ++i) dst[i] = b;
+
+        for (int ic = 0; ic < C; ++ic) {
+            const float* src = in + ic * plane;
+            const float* k = weight + (static_cast<size_t>(oc) * C + ic) * 9;
+
+            for (int y = 0; y < H; ++y) {
+                float* drow = dst + y * W;
+                for (int ky = 0; ky < 3; ++ky) {
+                    int iy = y + ky - 1;
+                    if (iy < 0 || iy >= H) continue;   // 上下边界：跳过该行抽头
+                    const float* srow = src + iy * W;
+                    float k0 = k[ky * 3], k1 = k[ky * 3 + 1], k2 = k[ky * 3 + 2];
+
+                    // 左右边界单独处理，内部无分支
+                    if (W == 1) {
+                        drow[0] += k1 * srow[0];
+                        continue;
+                    }
+                    drow[0] += k1 * srow[0] + k2 * srow[1];
+                    for (int x = 1; x < W - 1; ++x) {
+                        drow[x] += k0 * srow[x - 1] + k1 * srow[x] + k2 * srow[x + 1];
+                    }
+                    drow[W - 1] += k0 * srow[W - 2] + k1 * srow[W - 1];
+                }
+            }
+        }
+    }
+}
+
+} // namespace detail
+
+void conv3x3_s1p1(const float* in, int C, int H, int W,
+                  const float* weight, const float* bias, int OC, float* out) {
+    Isa isa = best_isa();
+    // 宽度不超过8时AVX-512有一半通道空转，AVX2更快
+    if (isa == Isa::AVX512 && W <= 8) isa = Isa::AVX2;
+    conv3x3_s1p1(in, C, H, W, weight, bias, OC, out, isa);
+}
+
+void conv3x3_s1p1(const float* in, int C, int H, int W,
+                  const float* weight, const float* bias, int OC, float* out, Isa isa) {
+#if defined(BCNN_X86_KERNELS)
+    if (isa != Isa::Scalar && isa_supported(isa)) {
+        switch (isa) {
+            case Isa::SSE42: detail::conv3x3_s1p1_sse42(in, C, H, W, weight, bias, OC, out); return;
+            case Isa::AVX2: detail::conv3x3_s1p1_avx2(in, C, H, W, weight, bias, OC, out); return;
+            case Isa::AVX512: detail::conv3x3_s1p1_avx512(in, C, H, W, weight, bias, OC, out); return;
+            default: break;
+        }
+    }
+#else
+    (void)isa;
+#endif
+    detail::conv3x3_s1p1_scalar(in, C, H, W, weight, bias, OC, out);
+}
+
+} // namespace kernels
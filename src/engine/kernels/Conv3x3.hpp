@@ -0,0 +1,20 @@
+#pragma once
+#include "engine/kernels/Isa.hpp"
+
+// 3×3、stride 1、padding 1 卷积专用内核（BadgeCNN 的全部卷积层都是这一形状）
+// 输入/输出为单张 CHW 特征图，权重为 PyTorch 的 [OC][C][3][3] 布局；
+// 边界按零填充处理，但不会生成带padding的输入副本。
+namespace kernels {
+
+// out[oc] = bias[oc] + Σ_ic conv3x3(in[ic], weight[oc][ic])
+// bias 可为 nullptr；out 需容纳 OC*H*W 个float
+void conv3x3_s1p1(const float* in, int C, int H, int W,
+                  const float* weight, const float* bias, int OC,
+                  float* out);
+
+// 指定指令集（不支持时退回标量实现）
+void conv3x3_s1p1(const float* in, int C, int H, int W,
+                  const float* weight, const float* bias, int OC,
+                  float* out, Isa isa);
+
+} // namespace kernels
@@ -0,0 +1,315 @@
+// AVX2 + FMA 实现：每次计算4个输出通道 × 8个相邻像素。
+// 行首/行尾的向量用掩码加载，越界的抽头读作0，因此不需要带padding的输入副本。
+// 融合块内核每次计算4个输出通道 × 2行 × 8像素，在寄存器中完成BN、ReLU和2×2池化；
+// 分块布局（NCHW8c）的融合块每次计算8个输出通道 × 2行 × 4像素。
+#include "engine/kernels/Conv3x3Impl.hpp"
+#include <immintrin.h>
+
+namespace kernels {
+namespace detail {
+namespace {
+
+// 一个8像素段的加载掩码：左邻(x-1)、中心(x)、右邻(x+1)
+struct SegmentMasks {
+    __m256i left;
+    __m256i center;
+    __m256i right;
+};
+
+SegmentMasks segment_masks(int x0, int W) {
+    alignas(32) int l[8], c[8], r[8];
+    for (int i = 0; i < 8; ++i) {
+        int x = x0 + i;
+        l[i] = (x - 1 >= 0 && x - 1 < W) ? -1 : 0;
+        c[i] = x < W ? -1 : 0;
+        r[i] = x + 1 < W ? -1 : 0;
+    }
+    SegmentMasks m;
+    m.left = _mm256_load_si256(reinterpret_cast<const __m256i*>(l));
+    m.center = _mm256_load_si256(reinterpret_cast<const __m256i*>(c));
+    m.right = _mm256_load_si256(reinterpret_cast<const __m256i*>(r));
+    return m;
+}
+
+template <int NB, bool Edge>
+void conv_segment(const float* in, int C, int H, int W, const float* weight, const float* bias,
+                  int oc0, int y, int x0, const SegmentMasks& m, float* out) {
+    const long plane = static_cast<long>(H) * W;
+
+    __m256 acc[NB];
+    #pragma GCC unroll 8
+    for (int j = 0; j < NB; ++j) {
+        acc[j] = _mm256_set1_ps(bias ? bias[oc0 + j] : 0.0f);
+    }
+
+    for (int ic = 0; ic < C; ++ic) {
+        const float* src = in + ic * plane;
+        for (int ky = 0; ky < 3; ++ky) {
+            int iy = y + ky - 1;
+            if (iy < 0 || iy >= H) continue;
+            const float* row = src + iy * W + x0;
+            __m256 l, c, r;
+            if (Edge) {
+                l = _mm256_maskload_ps(row - 1, m.left);
+                c = _mm256_maskload_ps(row, m.center);
+                r = _mm256_maskload_ps(row + 1, m.right);
+            } else {
+                l = _mm256_loadu_ps(row - 1);
+                c = _mm256_loadu_ps(row);
+                r = _mm256_loadu_ps(row + 1);
+            }
+
+            #pragma GCC unroll 8
+            for (int j = 0; j < NB; ++j) {
+                const float* k = weight + (static_cast<long>(oc0 + j) * C + ic) * 9 + ky * 3;
+                acc[j] = _mm256_fmadd_ps(_mm256_broadcast_ss(k), l, acc[j]);
+                acc[j] = _mm256_fmadd_ps(_mm256_broadcast_ss(k + 1), c, acc[j]);
+                acc[j] = _mm256_fmadd_ps(_mm256_broadcast_ss(k + 2), r, acc[j]);
+            }
+        }
+    }
+
+    #pragma GCC unroll 8
+    for (int j = 0; j < NB; ++j) {
+        float* dst = out + (oc0 + j) * plane + y * W + x0;
+        if (Edge) {
+            _mm256_maskstore_ps(dst, m.center, acc[j]);
+        } else {
+            _mm256_storeu_ps(dst, acc[j]);
+        }
+    }
+}
+
+template <int NB>
+void conv_block(const float* in, int C, int H, int W,
+                const float* weight, const float* bias, int oc0, float* out) {
+    for (int y = 0; y < H; ++y) {
+        for (int x0 = 0; x0 < W; x0 += 8) {
+            // 段内所有抽头都在行内时使用普通加载
+            if (x0 >= 1 && x0 + 9 <= W) {
+                conv_segment<NB, false>(in, C, H, W, weight, bias, oc0, y, x0, SegmentMasks(), out);
+            } else {
+                conv_segment<NB, true>(in, C, H, W, weight, bias, oc0, y, x0, segment_masks(x0, W), out);
+            }
+        }
+    }
+}
+
+// 融合块：池化输出第 py 行、从第 x0 列开始的8个卷积像素（4个池化像素）
+template <int NB, bool Edge>
+void block_segment(const float* in, int C, int H, int W, const float* weight,
+                   const float* scale, const float* shift, int oc0, int py, int x0,
+                   const SegmentMasks& m, int PH, int PW, float* out) {
+    const long plane = static_cast<long>(H) * W;
+    const int y0 = 2 * py;
+
+    // acc0 / acc1：卷积输出第 y0 / y0+1 行
+    __m256 acc0[NB], acc1[NB];
+    #pragma GCC unroll 8
+    for (int j = 0; j < NB; ++j) {
+        acc0[j] = _mm256_setzero_ps();
+        acc1[j] = _mm256_setzero_ps();
+    }
+
+    for (int ic = 0; ic < C; ++ic) {
+        const float* src = in + ic * plane;
+        // 两行卷积共用输入行 y0-1 .. y0+2；第 r 行对 acc0 是抽头行 r，对 acc1 是抽头行 r-1
+        #pragma GCC unroll 4
+        for (int r = 0; r < 4; ++r) {
+            int iy = y0 + r - 1;
+            if (iy < 0 || iy >= H) continue;
+            const float* row = src + iy * W + x0;
+            __m256 l, c, rr;
+            if (Edge) {
+                l = _mm256_maskload_ps(row - 1, m.left);
+                c = _mm256_maskload_ps(row, m.center);
+                rr = _mm256_maskload_ps(row + 1, m.right);
+            } else {
+                l = _mm256_loadu_ps(row - 1);
+                c = _mm256_loadu_ps(row);
+                rr = _mm256_loadu_ps(row + 1);
+            }
+
+            #pragma GCC unroll 8
+            for (int j = 0; j < NB; ++j) {
+                const float* k = weight + (static_cast<long>(oc0 + j) * C + ic) * 9;
+                if (r < 3) {
+                    const float* k0 = k + r * 3;
+                    acc0[j] = _mm256_fmadd_ps(_mm256_broadcast_ss(k0), l, acc0[j]);
+                    acc0[j] = _mm256_fmadd_ps(_mm256_broadcast_ss(k0 + 1), c, acc0[j]);
+                    acc0[j] = _mm256_fmadd_ps(_mm256_broadcast_ss(k0 + 2), rr, acc0[j]);
+                }
+                if (r > 0) {
+                    const float* k1 = k + (r - 1) * 3;
+                    acc1[j] = _mm256_fmadd_ps(_mm256_broadcast_ss(k1), l, acc1[j]);
+                    acc1[j] = _mm256_fmadd_ps(_mm256_broadcast_ss(k1 + 1), c, acc1[j]);
+                    acc1[j] = _mm256_fmadd_ps(_mm256_broadcast_ss(k1 + 2), rr, acc1[j]);
+                }
+            }
+        }
+    }
+
+    // BN + ReLU 后先做行间最大值，再把相邻两列的最大值压缩到低4个通道
+    const __m256i even = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    const __m256 zero = _mm256_setzero_ps();
+    const int px0 = x0 / 2;
+    const int count = PW - px0 < 4 ? PW - px0 : 4;
+    const __m128i store_mask = _mm_cmpgt_epi32(_mm_set1_epi32(count), _mm_setr_epi32(0, 1, 2, 3));
+
+    #pragma GCC unroll 8
+    for (int j = 0; j < NB; ++j) {
+        const __m256 s = _mm256_set1_ps(scale[oc0 + j]);
+        const __m256 t = _mm256_set1_ps(shift[oc0 + j]);
+        __m256 a = _mm256_max_ps(_mm256_fmadd_ps(acc0[j], s, t), zero);
+        __m256 b = _mm256_max_ps(_mm256_fmadd_ps(acc1[j], s, t), zero);
+        __m256 v = _mm256_max_ps(a, b);
+        v = _mm256_max_ps(v, _mm256_permute_ps(v, 0xB1));
+        __m128 pooled = _mm256_castps256_ps128(_mm256_permutevar8x32_ps(v, even));
+
+        float* dst = out + (static_cast<long>(oc0 + j) * PH + py) * PW + px0;
+        if (count == 4) {
+            _mm_storeu_ps(dst, pooled);
+        } else {
+            _mm_maskstore_ps(dst, store_mask, pooled);
+        }
+    }
+}
+
+template <int NB>
+void pool_block(const float* in, int C, int H, int W, const float* weight,
+                const float* scale, const float* shift, int oc0, float* out) {
+    const int PH = H / 2;
+    const int PW = W / 2;
+    for (int py = 0; py < PH; ++py) {
+        // 只计算池化用到的 2·PW 列
+        for (int x0 = 0; x0 < 2 * PW; x0 += 8) {
+            if (x0 >= 1 && x0 + 9 <= W) {
+                block_segment<NB, false>(in, C, H, W, weight, scale, shift, oc0, py, x0,
+                                         SegmentMasks(), PH, PW, out);
+            } else {
+                block_segment<NB, true>(in, C, H, W, weight, scale, shift, oc0, py, x0,
+                                        segment_masks(x0, W), PH, PW, out);
+            }
+        }
+    }
+}
+
+// 分块布局（NCHW8c）融合块：8个输出通道 × 2行 × TW像素的累加器常驻寄存器，
+// 每次乘加广播一个输入值。Left / Right 表示该段紧贴左 / 右边界，越界的抽头在编译期去掉
+template <int TW, bool Left, bool Right>
+void nchwc_tile(const float* in, int C, int H, int W, const float* weight,
+                const float* scale, const float* shift, int y0, int x0, float* out) {
+    const long plane = static_cast<long>(H) * W * 8;
+    __m256 acc0[TW], acc1[TW];
+    #pragma GCC unroll 16
+    for (int j = 0; j < TW; ++j) {
+        acc0[j] = _mm256_setzero_ps();
+        acc1[j] = _mm256_setzero_ps();
+    }
+
+    for (int ic = 0; ic < C; ++ic) {
+        const float* src = in + (ic / 8) * plane + ic % 8;
+        const float* k = weight + static_cast<long>(ic) * 9 * 8;
+        // 两行卷积共用输入行 y0-1 .. y0+2；第 r 行对 acc0 是抽头行 r，对 acc1 是抽头行 r-1
+        #pragma GCC unroll 4
+        for (int r = 0; r < 4; ++r) {
+            const int iy = y0 + r - 1;
+            if (iy < 0 || iy >= H) continue;
+            const float* row = src + (static_cast<long>(iy) * W + x0) * 8;
+
+            #pragma GCC unroll 3
+            for (int kx = 0; kx < 3; ++kx) {
+                const __m256 w0 = r < 3 ? _mm256_loadu_ps(k + (r * 3 + kx) * 8) : _mm256_setzero_ps();
+                const __m256 w1 = r > 0 ? _mm256_loadu_ps(k + ((r - 1) * 3 + kx) * 8) : _mm256_setzero_ps();
+                #pragma GCC unroll 16
+                for (int j = 0; j < TW; ++j) {
+                    const int dx = j + kx - 1;
+                    if (Left && dx < 0) continue;
+                    if (Right && dx >= TW) continue;
+                    const __m256 v = _mm256_set1_ps(row[dx * 8]);
+                    if (r < 3) acc0[j] = _mm256_fmadd_ps(v, w0, acc0[j]);
+                    if (r > 0) acc1[j] = _mm256_fmadd_ps(v, w1, acc1[j]);
+                }
+            }
+        }
+    }
+
+    // scale 可能为负，先做BN仿射再取最大值
+    const __m256 s = _mm256_loadu_ps(scale);
+    const __m256 t = _mm256_loadu_ps(shift);
+    __m256 m = _mm256_setzero_ps();
+    const int PW = W / 2;
+    #pragma GCC unroll 8
+    for (int j = 0; j < TW; j += 2) {
+        __m256 v = _mm256_max_ps(_mm256_fmadd_ps(acc0[j], s, t), _mm256_fmadd_ps(acc0[j + 1], s, t));
+        v = _mm256_max_ps(v, _mm256_max_ps(_mm256_fmadd_ps(acc1[j], s, t), _mm256_fmadd_ps(acc1[j + 1], s, t)));
+        _mm256_storeu_ps(out + ((y0 / 2) * static_cast<long>(PW) + (x0 + j) / 2) * 8, _mm256_max_ps(v, m));
+    }
+}
+
+template <int TW>
+void nchwc_segment(const float* in, int C, int H, int W, const float* weight,
+                   const float* scale, const float* shift, int y0, int x0, float* out) {
+    const bool left = x0 == 0;
+    const bool right = x0 + TW >= W;
+    if (left && right) {
+        nchwc_tile<TW, true, true>(in, C, H, W, weight, scale, shift, y0, x0, out);
+    } else if (left) {
+        nchwc_tile<TW, true, false>(in, C, H, W, weight, scale, shift, y0, x0, out);
+    } else if (right) {
+        nchwc_tile<TW, false, true>(in, C, H, W, weight, scale, shift, y0, x0, out);
+    } else {
+        nchwc_tile<TW, false, false>(in, C, H, W, weight, scale, shift, y0, x0, out);
+    }
+}
+
+} // namespace
+
+void conv3x3_bn_relu_pool2_avx2(const float* in, int C, int H, int W, const float* weight,
+                                const float* scale, const float* shift, int OC, float* out) {
+    int oc = 0;
+    for (; oc + 4 <= OC; oc += 4) {
+        pool_block<4>(in, C, H, W, weight, scale, shift, oc, out);
+    }
+    for (; oc < OC; ++oc) {
+        pool_block<1>(in, C, H, W, weight, scale, shift, oc, out);
+    }
+}
+
+void conv3x3_s1p1_avx2(const float* in, int C, int H, int W,
+                       const float* weight, const float* bias, int OC, float* out) {
+    int oc = 0;
+    for (; oc + 4 <= OC; oc += 4) {
+        conv_block<4>(in, C, H, W, weight, bias, oc, out);
+    }
+    for (; oc < OC; ++oc) {
+        conv_block<1>(in, C, H, W, weight, bias, oc, out);
+    }
+}
+
+void conv3x3_bn_relu_pool2_nchw8c_avx2(const float* in, int C, int H, int W, const float* weight,
+                                       const float* scale, const float* shift, int OC, float* out,
+                                       int row_begin, int row_end) {
+    const int PH = H / 2;
+    const int PW = W / 2;
+    // 只计算池化用到的 2·PW 列：先按 4 列一段，余下的按2列一段
+    const int wide = 2 * PW / 4 * 4;
+    for (int ocb = 0; ocb < OC / 8; ++ocb) {
+        const float* k = weight + static_cast<long>(ocb) * C * 9 * 8;
+        const float* s = scale + ocb * 8;
+        const float* t = shift + ocb * 8;
+        float* dst = out + static_cast<long>(ocb) * PH * PW * 8;
+        for (int py = row_begin; py < row_end; ++py) {
+            int x0 = 0;
+            for (; x0 < wide; x0 += 4) {
+                nchwc_segment<4>(in, C, H, W, k, s, t, 2 * py, x0, dst);
+            }
+            for (; x0 < 2 * PW; x0 += 2) {
+                nchwc_segment<2>(in, C, H, W, k, s, t, 2 * py, x0, dst);
+            }
+        }
+    }
+}
+
+} // namespace detail
+} // namespace kernels
@@ -0,0 +1,266 @@
+// AVX-512F 实现：每次计算4个输出通道 × 16个相邻像素。
+// 行首/行尾使用掩码加载与掩码存储，越界的抽头读作0。
+// 融合块内核每次计算4个输出通道 × 2行 × 16像素，在寄存器中完成BN、ReLU和2×2池化；
+// 分块布局（NCHW16c）的融合块每次计算16个输出通道 × 2行 × 8像素。
+#include "engine/kernels/Conv3x3Impl.hpp"
+#include <immintrin.h>
+
+namespace kernels {
+namespace detail {
+namespace {
+
+// 一个16像素段的加载掩码：左邻(x-1)、中心(x)、右邻(x+1)
+struct SegmentMasks {
+    __mmask16 left = 0;
+    __mmask16 center = 0;
+    __mmask16 right = 0;
+};
+
+SegmentMasks segment_masks(int x0, int W) {
+    SegmentMasks m;
+    for (int i = 0; i < 16; ++i) {
+        int x = x0 + i;
+        if (x - 1 >= 0 && x - 1 < W) m.left |= static_cast<__mmask16>(1u << i);
+        if (x < W) m.center |= static_cast<__mmask16>(1u << i);
+        if (x + 1 < W) m.right |= static_cast<__mmask16>(1u << i);
+    }
+    return m;
+}
+
+template <int NB>
+void conv_block(const float* in, int C, int H, int W,
+                const float* weight, const float* bias, int oc0, float* out) {
+    const long plane = static_cast<long>(H) * W;
+
+    for (int x0 = 0; x0 < W; x0 += 16) {
+        const SegmentMasks m = segment_masks(x0, W);
+
+        for (int y = 0; y < H; ++y) {
+            __m512 acc[NB];
+            #pragma GCC unroll 8
+            for (int j = 0; j < NB; ++j) {
+                acc[j] = _mm512_set1_ps(bias ? bias[oc0 + j] : 0.0f);
+            }
+
+            for (int ic = 0; ic < C; ++ic) {
+                const float* src = in + ic * plane;
+                for (int ky = 0; ky < 3; ++ky) {
+                    int iy = y + ky - 1;
+                    if (iy < 0 || iy >= H) continue;
+                    const float* row = src + iy * W + x0;
+                    __m512 l = _mm512_maskz_loadu_ps(m.left, row - 1);
+                    __m512 c = _mm512_maskz_loadu_ps(m.center, row);
+                    __m512 r = _mm512_maskz_loadu_ps(m.right, row + 1);
+
+                    #pragma GCC unroll 8
+                    for (int j = 0; j < NB; ++j) {
+                        const float* k = weight + (static_cast<long>(oc0 + j) * C + ic) * 9 + ky * 3;
+                        acc[j] = _mm512_fmadd_ps(_mm512_set1_ps(k[0]), l, acc[j]);
+                        acc[j] = _mm512_fmadd_ps(_mm512_set1_ps(k[1]), c, acc[j]);
+                        acc[j] = _mm512_fmadd_ps(_mm512_set1_ps(k[2]), r, acc[j]);
+                    }
+                }
+            }
+
+            #pragma GCC unroll 8
+            for (int j = 0; j < NB; ++j) {
+                _mm512_mask_storeu_ps(out + (oc0 + j) * plane + y * W + x0, m.center, acc[j]);
+            }
+        }
+    }
+}
+
+// 融合块：每个16像素段产生8个池化像素
+template <int NB>
+void pool_block(const float* in, int C, int H, int W, const float* weight,
+                const float* scale, const float* shift, int oc0, float* out) {
+    const long plane = static_cast<long>(H) * W;
+    const int PH = H / 2;
+    const int PW = W / 2;
+    const __m512i even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 0, 2, 4, 6, 8, 10, 12, 14);
+    const __m512 zero = _mm512_setzero_ps();
+
+    // 只计算池化用到的 2·PW 列
+    for (int x0 = 0; x0 < 2 * PW; x0 += 16) {
+        const SegmentMasks m = segment_masks(x0, W);
+        const int px0 = x0 / 2;
+        const int count = PW - px0 < 8 ? PW - px0 : 8;
+        const __mmask16 store_mask = static_cast<__mmask16>((1u << count) - 1);
+
+        for (int py = 0; py < PH; ++py) {
+            const int y0 = 2 * py;
+
+            // acc0 / acc1：卷积输出第 y0 / y0+1 行
+            __m512 acc0[NB], acc1[NB];
+            #pragma GCC unroll 8
+            for (int j = 0; j < NB; ++j) {
+                acc0[j] = _mm512_setzero_ps();
+                acc1[j] = _mm512_setzero_ps();
+            }
+
+            for (int ic = 0; ic < C; ++ic) {
+                const float* src = in + ic * plane;
+                // 两行卷积共用输入行 y0-1 .. y0+2；第 r 行对 acc0 是抽头行 r，对 acc1 是抽头行 r-1
+                #pragma GCC unroll 4
+                for (int r = 0; r < 4; ++r) {
+                    int iy = y0 + r - 1;
+                    if (iy < 0 || iy >= H) continue;
+                    const float* row = src + iy * W + x0;
+                    __m512 l = _mm512_maskz_loadu_ps(m.left, row - 1);
+                    __m512 c = _mm512_maskz_loadu_ps(m.center, row);
+                    __m512 rr = _mm512_maskz_loadu_ps(m.right, row + 1);
+
+                    #pragma GCC unroll 8
+                    for (int j = 0; j < NB; ++j) {
+                        const float* k = weight + (static_cast<long>(oc0 + j) * C + ic) * 9;
+                        if (r < 3) {
+                            const float* k0 = k + r * 3;
+                            acc0[j] = _mm512_fmadd_ps(_mm512_set1_ps(k0[0]), l, acc0[j]);
+                            acc0[j] = _mm512_fmadd_ps(_mm512_set1_ps(k0[1]), c, acc0[j]);
+                            acc0[j] = _mm512_fmadd_ps(_mm512_set1_ps(k0[2]), rr, acc0[j]);
+                        }
+                        if (r > 0) {
+                            const float* k1 = k + (r - 1) * 3;
+                            acc1[j] = _mm512_fmadd_ps(_mm512_set1_ps(k1[0]), l, acc1[j]);
+                            acc1[j] = _mm512_fmadd_ps(_mm512_set1_ps(k1[1]), c, acc1[j]);
+                            acc1[j] = _mm512_fmadd_ps(_mm512_set1_ps(k1[2]), rr, acc1[j]);
+                        }
+                    }
+                }
+            }
+
+            // BN + ReLU 后先做行间最大值，再把相邻两列的最大值压缩到低8个通道
+            #pragma GCC unroll 8
+            for (int j = 0; j < NB; ++j) {
+                const __m512 s = _mm512_set1_ps(scale[oc0 + j]);
+                const __m512 t = _mm512_set1_ps(shift[oc0 + j]);
+                __m512 a = _mm512_max_ps(_mm512_fmadd_ps(acc0[j], s, t), zero);
+                __m512 b = _mm512_max_ps(_mm512_fmadd_ps(acc1[j], s, t), zero);
+                __m512 v = _mm512_max_ps(a, b);
+                v = _mm512_max_ps(v, _mm512_permute_ps(v, 0xB1));
+                _mm512_mask_storeu_ps(out + (static_cast<long>(oc0 + j) * PH + py) * PW + px0,
+                                      store_mask, _mm512_permutexvar_ps(even, v));
+            }
+        }
+    }
+}
+
+// 分块布局（NCHW16c）融合块：16个输出通道 × 2行 × TW像素的累加器常驻寄存器，
+// 每次乘加广播一个输入值。Left / Right 表示该段紧贴左 / 右边界，越界的抽头在编译期去掉
+template <int TW, bool Left, bool Right>
+void nchwc_tile(const float* in, int C, int H, int W, const float* weight,
+                const float* scale, const float* shift, int y0, int x0, float* out) {
+    const long plane = static_cast<long>(H) * W * 16;
+    __m512 acc0[TW], acc1[TW];
+    #pragma GCC unroll 16
+    for (int j = 0; j < TW; ++j) {
+        acc0[j] = _mm512_setzero_ps();
+        acc1[j] = _mm512_setzero_ps();
+    }
+
+    for (int ic = 0; ic < C; ++ic) {
+        const float* src = in + (ic / 16) * plane + ic % 16;
+        const float* k = weight + static_cast<long>(ic) * 9 * 16;
+        // 两行卷积共用输入行 y0-1 .. y0+2；第 r 行对 acc0 是抽头行 r，对 acc1 是抽头行 r-1
+        #pragma GCC unroll 4
+        for (int r = 0; r < 4; ++r) {
+            const int iy = y0 + r - 1;
+            if (iy < 0 || iy >= H) continue;
+            const float* row = src + (static_cast<long>(iy) * W + x0) * 16;
+
+            #pragma GCC unroll 3
+            for (int kx = 0; kx < 3; ++kx) {
+                const __m512 w0 = r < 3 ? _mm512_loadu_ps(k + (r * 3 + kx) * 16) : _mm512_setzero_ps();
+                const __m512 w1 = r > 0 ? _mm512_loadu_ps(k + ((r - 1) * 3 + kx) * 16) : _mm512_setzero_ps();
+                #pragma GCC unroll 16
+                for (int j = 0; j < TW; ++j) {
+                    const int dx = j + kx - 1;
+                    if (Left && dx < 0) continue;
+                    if (Right && dx >= TW) continue;
+                    const __m512 v = _mm512_set1_ps(row[dx * 16]);
+                    if (r < 3) acc0[j] = _mm512_fmadd_ps(v, w0, acc0[j]);
+                    if (r > 0) acc1[j] = _mm512_fmadd_ps(v, w1, acc1[j]);
+                }
+            }
+        }
+    }
+
+    // scale 可能为负，先做BN仿射再取最大值
+    const __m512 s = _mm512_loadu_ps(scale);
+    const __m512 t = _mm512_loadu_ps(shift);
+    __m512 m = _mm512_setzero_ps();
+    const int PW = W / 2;
+    #pragma GCC unroll 8
+    for (int j = 0; j < TW; j += 2) {
+        __m512 v = _mm512_max_ps(_mm512_fmadd_ps(acc0[j], s, t), _mm512_fmadd_ps(acc0[j + 1], s, t));
+        v = _mm512_max_ps(v, _mm512_max_ps(_mm512_fmadd_ps(acc1[j], s, t), _mm512_fmadd_ps(acc1[j + 1], s, t)));
+        _mm512_storeu_ps(out + ((y0 / 2) * static_cast<long>(PW) + (x0 + j) / 2) * 16, _mm512_max_ps(v, m));
+    }
+}
+
+template <int TW>
+void nchwc_segment(const float* in, int C, int H, int W, const float* weight,
+                   const float* scale, const float* shift, int y0, int x0, float* out) {
+    const bool left = x0 == 0;
+    const bool right = x0 + TW >= W;
+    if (left && right) {
+        nchwc_tile<TW, true, true>(in, C, H, W, weight, scale, shift, y0, x0, out);
+    } else if (left) {
+        nchwc_tile<TW, true, false>(in, C, H, W, weight, scale, shift, y0, x0, out);
+    } else if (right) {
+        nchwc_tile<TW, false, true>(in, C, H, W, weight, scale, shift, y0, x0, out);
+    } else {
+        nchwc_tile<TW, false, false>(in, C, H, W, weight, scale, shift, y0, x0, out);
+    }
+}
+
+} // namespace
+
+void conv3x3_bn_relu_pool2_avx512(const float* in, int C, int H, int W, const float* weight,
+                                  const float* scale, const float* shift, int OC, float* out) {
+    int oc = 0;
+    for (; oc + 4 <= OC; oc += 4) {
+        pool_block<4>(in, C, H, W, weight, scale, shift, oc, out);
+    }
+    for (; oc < OC; ++oc) {
+        pool_block<1>(in, C, H, W, weight, scale, shift, oc, out);
+    }
+}
+
+void conv3x3_s1p1_avx512(const float* in, int C, int H, int W,
+                         const float* weight, const float* bias, int OC, float* out) {
+    int oc = 0;
+    for (; oc + 4 <= OC; oc += 4) {
+        conv_block<4>(in, C, H, W, weight, bias, oc, out);
+    }
+    for (; oc < OC; ++oc) {
+        conv_block<1>(in, C, H, W, weight, bias, oc, out);
+    }
+}
+
+void conv3x3_bn_relu_pool2_nchw16c_avx512(const float* in, int C, int H, int W, const float* weight,
+                                          const float* scale, const float* shift, int OC, float* out,
+                                          int row_begin, int row_end) {
+    const int PH = H / 2;
+    const int PW = W / 2;
+    // 只计算池化用到的 2·PW 列：先按 8 列一段，余下的按2列一段
+    const int wide = 2 * PW / 8 * 8;
+    for (int ocb = 0; ocb < OC / 16; ++ocb) {
+        const float* k = weight + static_cast<long>(ocb) * C * 9 * 16;
+        const float* s = scale + ocb * 16;
+        const float* t = shift + ocb * 16;
+        float* dst = out + static_cast<long>(ocb) * PH * PW * 16;
+        for (int py = row_begin; py < row_end; ++py) {
+            int x0 = 0;
+            for (; x0 < wide; x0 += 8) {
+                nchwc_segment<8>(in, C, H, W, k, s, t, 2 * py, x0, dst);
+            }
+            for (; x0 < 2 * PW; x0 += 2) {
+                nchwc_segment<2>(in, C, H, W, k, s, t, 2 * py, x0, dst);
+            }
+        }
+    }
+}
+
+} // namespace detail
+} // namespace kernels
@@ -0,0 +1,37 @@
+#pragma once
+// 各指令集实现的内部声明。每个实现位于单独的翻译单元并以对应的编译选项编译，
+// 因此这些翻译单元只包含 <immintrin.h>，不实例化任何标准库模板，避免高指令集代码
+// 通过ODR合并被低指令集路径调用。
+
+namespace kernels {
+namespace detail {
+
+// 单个输出像素（含全部输入通道），越界的输入视为0
+float conv3x3_pixel(const float* in, int C, int H, int W, const float* weight_oc, int y, int x);
+
+void conv3x3_s1p1_scalar(const float* in, int C, int H, int W,
+                         const float* weight, const float* bias, int OC, float* out);
+void conv3x3_s1p1_sse42(const float* in, int C, int H, int W,
+                        const float* weight, const float* bias, int OC, float* out);
+void conv3x3_s1p1_avx2(const float* in, int C, int H, int W,
+                       const float* weight, const float* bias, int OC, float* out);
+void conv3x3_s1p1_avx512(const float* in, int C, int H, int W,
+                         const float* weight, const float* bias, int OC, float* out);
+
+// 融合 Conv -> BN -> ReLU -> MaxPool 2×2，见 ConvBlock.hpp
+void conv3x3_bn_relu_pool2_avx2(const float* in, int C, int H, int W, const float* weight,
+                                const float* scale, const float* shift, int OC, float* out);
+void conv3x3_bn_relu_pool2_avx512(const float* in, int C, int H, int W, const float* weight,
+                                  const float* scale, const float* shift, int OC, float* out);
+
+// 分块布局的融合块，weight 为 [OC/cb][C][3][3][cb]（cb：AVX2 为8，AVX-512 为16），
+// 只计算池化后的第 row_begin..row_end-1 行
+void conv3x3_bn_relu_pool2_nchw8c_avx2(const float* in, int C, int H, int W, const float* weight,
+                                       const float* scale, const float* shift, int OC, float* out,
+                                       int row_begin, int row_end);
+void conv3x3_bn_relu_pool2_nchw16c_avx512(const float* in, int C, int H, int W, const float* weight,
+                                          const float* scale, const float* shift, int OC, float* out,
+                                          int row_begin, int row_end);
+
+} // namespace detail
+} // namespace kernels
@@ -0,0 +1,85 @@
+// SSE4.2 实现：每次计算4个输出通道 × 4个相邻像素。
+// 行首/行尾的段通过移位补0得到越界的左/右邻，宽度不是4的倍数时剩余列用标量计算
+#include "engine/kernels/Conv3x3Impl.hpp"
+#include <immintrin.h>
+
+namespace kernels {
+namespace detail {
+namespace {
+
+template <int NB>
+void conv_block(const float* in, int C, int H, int W,
+                const float* weight, const float* bias, int oc0, float* out) {
+    const long plane = static_cast<long>(H) * W;
+
+    for (int y = 0; y < H; ++y) {
+        int x = 0;
+        for (; x + 4 <= W; x += 4) {
+            const bool leftEdge = x == 0;
+            const bool rightEdge = x + 4 == W;
+
+            __m128 acc[NB];
+            #pragma GCC unroll 8
+            for (int j = 0; j < NB; ++j) {
+                acc[j] = _mm_set1_ps(bias ? bias[oc0 + j] : 0.0f);
+            }
+
+            for (int ic = 0; ic < C; ++ic) {
+                const float* src = in + ic * plane;
+                for (int ky = 0; ky < 3; ++ky) {
+                    int iy = y + ky - 1;
+                    if (iy < 0 || iy >= H) continue;
+                    const float* row = src + iy * W + x;
+                    __m128 c = _mm_loadu_ps(row);
+                    __m128 l = leftEdge
+                        ? _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(c), 4))
+                        : _mm_loadu_ps(row - 1);
+                    __m128 r = rightEdge
+                        ? _mm_castsi128_ps(_mm_srli_si128(_mm_castps_si128(c), 4))
+                        : _mm_loadu_ps(row + 1);
+
+                    #pragma GCC unroll 8
+                    for (int j = 0; j < NB; ++j) {
+                        const float* k = weight + (static_cast<long>(oc0 + j) * C + ic) * 9 + ky * 3;
+                        acc[j] = _mm_add_ps(acc[j], _mm_mul_ps(_mm_set1_ps(k[0]), l));
+                        acc[j] = _mm_add_ps(acc[j], _mm_mul_ps(_mm_set1_ps(k[1]), c));
+                        acc[j] = _mm_add_ps(acc[j], _mm_mul_ps(_mm_set1_ps(k[2]), r));
+                    }
+                }
+            }
+
+            #pragma GCC unroll 8
+            for (int j = 0; j < NB; ++j) {
+                _mm_storeu_ps(out + (oc0 + j) * plane + y * W + x, acc[j]);
+            }
+        }
+
+        // 剩余列
+        if (x == W) continue;
+        #pragma GCC unroll 8
+        for (int j = 0; j < NB; ++j) {
+            const float* w = weight + static_cast<long>(oc0 + j) * C * 9;
+            float* dst = out + (oc0 + j) * plane + y * W;
+            float b = bias ? bias[oc0 + j] : 0.0f;
+            for (int xr = x; xr < W; ++xr) {
+                dst[xr] = b + conv3x3_pixel(in, C, H, W, w, y, xr);
+            }
+        }
+    }
+}
+
+} // namespace
+
+void conv3x3_s1p1_sse42(const float* in, int C, int H, int W,
+                        const float* weight, const float* bias, int OC, float* out) {
+    int oc = 0;
+    for (; oc + 4 <= OC; oc += 4) {
+        conv_block<4>(in, C, H, W, weight, bias, oc, out);
+    }
+    for (; oc < OC; ++oc) {
+        conv_block<1>(in, C, H, W, weight, bias, oc, out);
+    }
+}
+
+} // namespace detail
+} // namespace kernels
@@ -0,0 +1,144 @@
+#include "engine/kernels/ConvBlock.hpp"
+#include "engine/kernels/Conv3x3.hpp"
+#include "engine/kernels/Conv3x3Impl.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace kernels {
+
+namespace {
+
+// 分块布局融合块的标量实现（没有对应指令集的 cb 时使用），越界的输入视为0
+void conv3x3_bn_relu_pool2_nchwc_scalar(const float* in, int C, int H, int W, const float* weight,
+                                        const float* scale, const float* shift, int OC, int cb, float* out,
+                                        int row_begin, int row_end) {
+    const int PH = H / 2;
+    const int PW = W / 2;
+    const size_t plane = static_cast<size_t>(H) * W * cb;
+    for (int oc = 0; oc < OC; ++oc) {
+        const float* k = weight + static_cast<size_t>(oc / cb) * C * 9 * cb + oc % cb;
+        float* dst = out + static_cast<size_t>(oc / cb) * PH * PW * cb + oc % cb;
+        for (int py = row_begin; py < row_end; ++py) {
+            for (int px = 0; px < PW; ++px) {
+                float m = 0.0f;   // ReLU 之后的最大值不小于0
+                for (int dy = 0; dy < 2; ++dy) {
+                    for (int dx = 0; dx < 2; ++dx) {
+                        const int y = 2 * py + dy;
+                        const int x = 2 * px + dx;
+                        float sum = 0.0f;
+                        for (int ic = 0; ic < C; ++ic) {
+                            const float* src = in + (ic / cb) * plane + ic % cb;
+                            for (int t = 0; t < 9; ++t) {
+                                const int iy = y + t / 3 - 1;
+                                const int ix = x + t % 3 - 1;
+                                if (iy < 0 || iy >= H || ix < 0 || ix >= W) continue;
+                                sum += src[(static_cast<size_t>(iy) * W + ix) * cb] * k[(ic * 9 + t) * cb];
+                            }
+                        }
+                        m = std::max(m, sum * scale[oc] + shift[oc]);
+                    }
+                }
+                dst[(static_cast<size_t>(py) * PW + px) * cb] = m;
+            }
+        }
+    }
+}
+
+} // namespace
+
+void bn_relu_pool2(const float* in, int C, int H, int W,
+                   const float* scale, const float* shift, float* out) {
+    const int PH = H / 2;
+    const int PW = W / 2;
+    for (int c = 0; c < C; ++c) {
+        const float* src = in + static_cast<size_t>(c) * H * W;
+        float* dst = out + static_cast<size_t>(c) * PH * PW;
+        const float s = scale[c];
+        const float t = shift[c];
+        for (int py = 0; py < PH; ++py) {
+            const float* r0 = src + 2 * py * W;
+            const float* r1 = r0 + W;
+            for (int px = 0; px < PW; ++px) {
+                // scale 可能为负，必须先做仿射再取最大值
+                float a = std::max(r0[2 * px] * s + t, r0[2 * px + 1] * s + t);
+                float b = std::max(r1[2 * px] * s + t, r1[2 * px + 1] * s + t);
+                dst[py * PW + px] = std::max(std::max(a, b), 0.0f);
+            }
+        }
+    }
+}
+
+void conv3x3_bn_relu_pool2(const float* in, int C, int H, int W, const float* weight,
+                           const float* scale, const float* shift, int OC, float* out) {
+    Isa isa = best_isa();
+    // 与 conv3x3_s1p1 相同：宽度不超过8时AVX2更快
+    if (isa == Isa::AVX512 && W <= 8) isa = Isa::AVX2;
+    conv3x3_bn_relu_pool2(in, C, H, W, weight, scale, shift, OC, out, isa);
+}
+
+void conv3x3_bn_relu_pool2(const float* in, int C, int H, int W, const float* weight,
+                           const float* scale, const float* shift, int OC, float* out, Isa isa) {
+    if (H < 2 || W < 2) {
+        return;
+    }
+#if defined(BCNN_X86_KERNELS)
+    if (isa_supported(isa)) {
+        switch (isa) {
+            case Isa::AVX2:
+                detail::conv3x3_bn_relu_pool2_avx2(in, C, H, W, weight, scale, shift, OC, out);
+                return;
+            case Isa::AVX512:
+                detail::conv3x3_bn_relu_pool2_avx512(in, C, H, W, weight, scale, shift, OC, out);
+                return;
+            default:
+                break;
+        }
+    }
+#endif
+
+    thread_local std::vector<float> conv;
+    conv.resize(static_cast<size_t>(OC) * H * W);
+    conv3x3_s1p1(in, C, H, W, weight, nullptr, OC, conv.data(), isa);
+    bn_relu_pool2(conv.data(), OC, H, W, scale, shift, out);
+}
+
+void pack_conv3x3_weights_nchwc(const float* weight, int OC, int C, int cb, std::vector<float>& out) {
+    // [OC][C][3][3] -> [OC/cb][C][3][3][cb]
+    out.assign(static_cast<size_t>(OC) * C * 9, 0.0f);
+    for (int oc = 0; oc < OC; ++oc) {
+        float* dst = out.data() + static_cast<size_t>(oc / cb) * C * 9 * cb + oc % cb;
+        for (int i = 0; i < C * 9; ++i) {
+            dst[static_cast<size_t>(i) * cb] = weight[static_cast<size_t>(oc) * C * 9 + i];
+        }
+    }
+}
+
+void conv3x3_bn_relu_pool2_nchwc(const float* in, int C, int H, int W, const float* weight,
+                                 const float* scale, const float* shift, int OC, int cb, float* out) {
+    conv3x3_bn_relu_pool2_nchwc(in, C, H, W, weight, scale, shift, OC, cb, out, 0, H / 2);
+}
+
+void conv3x3_bn_relu_pool2_nchwc(const float* in, int C, int H, int W, const float* weight,
+                                 const float* scale, const float* shift, int OC, int cb, float* out,
+                                 int row_begin, int row_end) {
+    row_begin = std::max(row_begin, 0);
+    row_end = std::min(row_end, H / 2);
+    if (row_begin >= row_end) {
+        return;
+    }
+#if defined(BCNN_X86_KERNELS)
+    if (cb == 16 && isa_supported(Isa::AVX512)) {
+        detail::conv3x3_bn_relu_pool2_nchw16c_avx512(in, C, H, W, weight, scale, shift, OC, out,
+                                                     row_begin, row_end);
+        return;
+    }
+    if (cb == 8 && isa_supported(Isa::AVX2)) {
+        detail::conv3x3_bn_relu_pool2_nchw8c_avx2(in, C, H, W, weight, scale, shift, OC, out,
+                                                  row_begin, row_end);
+        return;
+    }
+#endif
+    conv3x3_bn_relu_pool2_nchwc_scalar(in, C, H, W, weight, scale, shift, OC, cb, out, row_begin, row_end);
+}
+
+} // namespace kernels
@@ -0,0 +1,39 @@
+#pragma once
+#include <vector>
+#include "engine/kernels/Isa.hpp"
+
+// BadgeCNN 卷积块 Conv 3×3 s1 p1 -> BatchNorm -> ReLU -> MaxPool 2×2 s2 的融合内核
+// BN 按推理时的逐通道仿射 y = x * scale + shift 计算，卷积偏置需预先并入 shift。
+// 输出为池化后的 OC×(H/2)×(W/2)（向下取整，与 PyTorch 一致），池化前的特征图不写回内存。
+namespace kernels {
+
+// out 需容纳 OC*(H/2)*(W/2) 个float
+void conv3x3_bn_relu_pool2(const float* in, int C, int H, int W, const float* weight,
+                           const float* scale, const float* shift, int OC, float* out);
+
+// 指定指令集；SSE4.2和标量没有融合实现，先卷积到临时缓冲区再执行 bn_relu_pool2
+void conv3x3_bn_relu_pool2(const float* in, int C, int H, int W, const float* weight,
+                           const float* scale, const float* shift, int OC, float* out, Isa isa);
+
+// 卷积输出已在内存中时（Gemm / Winograd）的单趟后处理：BN仿射 + ReLU + 2×2最大池化
+// in 为 C×H×W，out 需容纳 C*(H/2)*(W/2) 个float
+void bn_relu_pool2(const float* in, int C, int H, int W,
+                   const float* scale, const float* shift, float* out);
+
+// 分块布局（NCHWc，见 Layout.hpp）的融合卷积块：in 为 C/cb 组 [H][W][cb]，out 为 OC/cb 组 [H/2][W/2][cb]。
+// 一个向量对应 cb 个输出通道，每次乘加广播一个输入值，卷积、BN、ReLU 和池化都沿输出通道向量化，
+// 适合通道多、宽度小的层（平面布局按像素向量化，宽度8时AVX-512只用满一半）。
+// cb 为 channel_block(best_isa())（16：AVX-512，8：AVX2），C 和 OC 须为 cb 的倍数。
+// weight 为 pack_conv3x3_weights_nchwc 的结果
+void pack_conv3x3_weights_nchwc(const float* weight, int OC, int C, int cb, std::vector<float>& out);
+
+void conv3x3_bn_relu_pool2_nchwc(const float* in, int C, int H, int W, const float* weight,
+                                 const float* scale, const float* shift, int OC, int cb, float* out);
+
+// 只计算池化后的第 row_begin..row_end-1 行（out 仍为整张输出的起始地址），用于按行分块并行；
+// 输入的上下相邻行直接读取，不当作边界补0
+void conv3x3_bn_relu_pool2_nchwc(const float* in, int C, int H, int W, const float* weight,
+                                 const float* scale, const float* shift, int OC, int cb, float* out,
+                                 int row_begin, int row_end);
+
+} // namespace kernels
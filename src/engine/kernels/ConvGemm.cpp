@@ -0,0 +1,151 @@
+#include "engine/kernels/ConvGemm.hpp"
+#include <algorithm>
+
+namespace kernels {
+
+namespace {
+
+// 一次展开的列矩阵大小上限（约为L2容量的一半）
+constexpr size_t kColumnBlockBytes = 512 * 1024;
+
+// 一个输出行在打包后B中的连续片段：行内 [begin, begin+count) 列
+// 位于同一个面板，offset 为第0行（kidx=0）时的写入位置
+struct PanelSegment {
+    int begin;
+    int count;
+    size_t offset;
+};
+
+// 计算从第 n 列开始的 count 个连续列跨越的面板片段
+void panel_segments(int n, int count, int K, int nr, std::vector<PanelSegment>& segments) {
+    segments.clear();
+    int begin = 0;
+    while (count > 0) {
+        const int lane = n % nr;
+        const int chunk = std::min(nr - lane, count);
+        segments.push_back({begin, chunk, static_cast<size_t>(n / nr) * K * nr + lane});
+        begin += chunk;
+        n += chunk;
+        count -= chunk;
+    }
+}
+
+// 把一行数据写入打包后B的第 kidx 行
+inline void scatter_row(const float* values, const std::vector<PanelSegment>& segments,
+                        int kidx, int nr, float* packed) {
+    const size_t rowOffset = static_cast<size_t>(kidx) * nr;
+    for (const PanelSegment& seg : segments) {
+        std::copy(values + seg.begin, values + seg.begin + seg.count, packed + seg.offset + rowOffset);
+    }
+}
+
+// 把一张输入展开为B的第 [col0, col0 + OH·OW) 列，直接写成SGEMM的面板格式，
+// 避免先生成行优先的列矩阵再打包。越界位置填0。
+void im2col_packed(const float* in, int C, int H, int W, int kernel, int stride, int padding,
+                   int OH, int OW, int col0, int nr, float* packed) {
+    const int K = C * kernel * kernel;
+    thread_local std::vector<float> row;
+    thread_local std::vector<PanelSegment> segments;
+    row.resize(OW);
+
+    // 按输出行遍历，同一输出行的 K 行依次写入相同的面板区域，写入基本连续
+    for (int oy = 0; oy < OH; ++oy) {
+        panel_segments(col0 + oy * OW, OW, K, nr, segments);
+        for (int c = 0; c < C; ++c) {
+            const float* src = in + static_cast<long>(c) * H * W;
+            for (int ky = 0; ky < kernel; ++ky) {
+                const int iy = oy * stride + ky - padding;
+                const float* srow = (iy >= 0 && iy < H) ? src + iy * W : nullptr;
+
+                for (int kx = 0; kx < kernel; ++kx) {
+                    const int kidx = (c * kernel + ky) * kernel + kx;
+                    if (!srow) {
+                        std::fill(row.begin(), row.end(), 0.0f);
+                    } else if (stride == 1) {
+                        // 有效的x范围是连续区间，两侧补0
+                        const int x0 = std::min(OW, std::max(0, padding - kx));
+                        const int x1 = std::max(x0, std::min(OW, W + padding - kx));
+                        if (x0 == 0 && x1 == OW) {
+                            scatter_row(srow + kx - padding, segments, kidx, nr, packed);
+                            continue;
+                        }
+                        std::fill(row.begin(), row.begin() + x0, 0.0f);
+                        std::copy(srow + x0 + kx - padding, srow + x1 + kx - padding, row.begin() + x0);
+                        std::fill(row.begin() + x1, row.end(), 0.0f);
+                    } else {
+                        for (int ox = 0; ox < OW; ++ox) {
+                            int ix = ox * stride + kx - padding;
+                            row[ox] = (ix >= 0 && ix < W) ? srow[ix] : 0.0f;
+                        }
+                    }
+                    scatter_row(row.data(), segments, kidx, nr, packed);
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+void pack_conv_weights(const float* weight, int OC, int C, int kernel, PackedMatrix& out) {
+    const int K = C * kernel * kernel;
+    pack_matrix_a(weight, OC, K, K, out);
+}
+
+void conv2d_gemm(const float* const* inputs, int batch, int C, int H, int W,
+                 int kernel, int stride, int padding,
+                 const PackedMatrix& weights, const float* bias,
+                 float* const* outputs) {
+    const int OH = (H + 2 * padding - kernel) / stride + 1;
+    const int OW = (W + 2 * padding - kernel) / stride + 1;
+    const int plane = OH * OW;
+    const int K = C * kernel * kernel;
+    const int OC = weights.rows;
+
+    const Isa isa = best_isa();
+    const int nr = sgemm_panel_width(isa);
+
+    // 每次展开的图像数：打包后的列矩阵不超过 kColumnBlockBytes，
+    // 使im2col写入的数据在GEMM读取时仍在L2中
+    const size_t bytesPerImage = static_cast<size_t>(K) * plane * sizeof(float);
+    const int chunk = static_cast<int>(std::max<size_t>(1, kColumnBlockBytes / std::max<size_t>(1, bytesPerImage)));
+
+    // 打包后的列矩阵和批量输出的缓冲区按线程复用
+    thread_local std::vector<float> packedCols;
+    thread_local std::vector<float> result;
+
+    for (int b0 = 0; b0 < batch; b0 += chunk) {
+        const int count = std::min(chunk, batch - b0);
+        const int N = count * plane;
+        const int panels = (N + nr - 1) / nr;
+        packedCols.resize(static_cast<size_t>(panels) * K * nr);
+
+        // 最后一个面板中超出N的列补0
+        if (N % nr != 0) {
+            float* last = packedCols.data() + static_cast<size_t>(panels - 1) * K * nr;
+            std::fill(last, last + static_cast<size_t>(K) * nr, 0.0f);
+        }
+        for (int b = 0; b < count; ++b) {
+            im2col_packed(inputs[b0 + b], C, H, W, kernel, stride, padding, OH, OW,
+                          b * plane, nr, packedCols.data());
+        }
+
+        // 单张图像时GEMM结果本身就是 OC×OH×OW，直接写入输出
+        if (count == 1) {
+            sgemm_prepacked(weights, packedCols.data(), N, bias, outputs[b0], N, isa);
+            continue;
+        }
+
+        // 多张图像：结果为 OC×(count·plane)，再拆分到各自的输出
+        result.resize(static_cast<size_t>(OC) * N);
+        sgemm_prepacked(weights, packedCols.data(), N, bias, result.data(), N, isa);
+        for (int b = 0; b < count; ++b) {
+            for (int oc = 0; oc < OC; ++oc) {
+                const float* src = result.data() + static_cast<size_t>(oc) * N + b * plane;
+                std::copy(src, src + plane, outputs[b0 + b] + static_cast<size_t>(oc) * plane);
+            }
+        }
+    }
+}
+
+} // namespace kernels
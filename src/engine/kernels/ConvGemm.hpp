@@ -0,0 +1,20 @@
+#pragma once
+#include "engine/kernels/Sgemm.hpp"
+
+// im2col + SGEMM 卷积
+// 权重 [OC][C][K][K] 视为 OC×(C·K·K) 的矩阵，加载时打包一次；
+// 输入展开为 (C·K·K)×(batch·OH·OW) 的列矩阵，一次GEMM完成整批图像。
+// 对通道数较多的层（conv3/conv4）比直接卷积更好地复用缓存。
+namespace kernels {
+
+// 打包卷积权重，weight 为 PyTorch 的 [OC][C][K][K] 布局
+void pack_conv_weights(const float* weight, int OC, int C, int kernel, PackedMatrix& out);
+
+// 对 batch 张 C×H×W 的输入做卷积，outputs[b] 需容纳 OC×OH×OW 个float
+// weights 为 pack_conv_weights 的结果，bias 可为 nullptr
+void conv2d_gemm(const float* const* inputs, int batch, int C, int H, int W,
+                 int kernel, int stride, int padding,
+                 const PackedMatrix& weights, const float* bias,
+                 float* const* outputs);
+
+} // namespace kernels
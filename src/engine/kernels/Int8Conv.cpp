@@ -0,0 +1,187 @@
+#include "engine/kernels/Int8Conv.hpp"
+#include "engine/kernels/Int8ConvImpl.hpp"
+#include "engine/kernels/Isa.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace kernels {
+
+namespace {
+
+// 单个卷积输出像素的int32和，越界的输入视为0
+int32_t conv_int8_pixel(const uint8_t* in, int G, int H, int W, const int8_t* weight_oc, int y, int x) {
+    const size_t plane = static_cast<size_t>(H) * W * 4;
+    int32_t sum = 0;
+    for (int g = 0; g < G; ++g) {
+        const uint8_t* src = in + g * plane;
+        const int8_t* k = weight_oc + g * 36;
+        for (int ky = 0; ky < 3; ++ky) {
+            int iy = y + ky - 1;
+            if (iy < 0 || iy >= H) continue;
+            for (int kx = 0; kx < 3; ++kx) {
+                int ix = x + kx - 1;
+                if (ix < 0 || ix >= W) continue;
+                const uint8_t* a = src + (static_cast<size_t>(iy) * W + ix) * 4;
+                const int8_t* b = k + (ky * 3 + kx) * 4;
+                sum += a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+            }
+        }
+    }
+    return sum;
+}
+
+void conv3x3_int8_bn_relu_pool2_scalar(const uint8_t* in, int G, int H, int W, const int8_t* weight,
+                                       int OC, const float* scale, const float* shift, float* out) {
+    const int PH = H / 2;
+    const int PW = W / 2;
+    for (int oc = 0; oc < OC; ++oc) {
+        const int8_t* k = weight + static_cast<size_t>(oc) * G * 36;
+        float* dst = out + static_cast<size_t>(oc) * PH * PW;
+        for (int py = 0; py < PH; ++py) {
+            for (int px = 0; px < PW; ++px) {
+                float m = 0.0f;   // ReLU 之后的最大值不小于0
+                for (int dy = 0; dy < 2; ++dy) {
+                    for (int dx = 0; dx < 2; ++dx) {
+                        int32_t acc = conv_int8_pixel(in, G, H, W, k, 2 * py + dy, 2 * px + dx);
+                        m = std::max(m, acc * scale[oc] + shift[oc]);
+                    }
+                }
+                dst[py * PW + px] = m;
+            }
+        }
+    }
+}
+
+bool cpu_has_vnni() {
+#if defined(BCNN_X86_KERNELS)
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vnni");
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
+Int8Isa best_int8_isa() {
+    // 跟随 best_isa()（含 BCNN_ISA 降级）：AVX-512 且支持VNNI时用vpdpbusd，否则用AVX2
+    Isa isa = best_isa();
+    if (isa == Isa::AVX512 && cpu_has_vnni()) return Int8Isa::AVX512VNNI;
+    if (isa == Isa::AVX2 || isa == Isa::AVX512) return Int8Isa::AVX2;
+    return Int8Isa::Scalar;
+}
+
+bool int8_isa_supported(Int8Isa isa) {
+    switch (isa) {
+        case Int8Isa::Scalar: return true;
+        case Int8Isa::AVX2: return isa_supported(Isa::AVX2);
+        case Int8Isa::AVX512VNNI: return cpu_has_vnni();
+    }
+    return false;
+}
+
+const char* int8_isa_name(Int8Isa isa) {
+    switch (isa) {
+        case Int8Isa::Scalar: return "scalar";
+        case Int8Isa::AVX2: return "avx2";
+        case Int8Isa::AVX512VNNI: return "avx512vnni";
+    }
+    return "unknown";
+}
+
+void quantize_conv3x3_weights(const float* weight, int OC, int C, QuantizedConvWeights& out) {
+    const int G = (C + 3) / 4;
+    out.out_channels = OC;
+    out.in_channels = C;
+    out.channel_groups = G;
+    out.data.assign(static_cast<size_t>(OC) * G * 36, 0);
+    out.scales.resize(OC);
+
+    for (int oc = 0; oc < OC; ++oc) {
+        const float* w = weight + static_cast<size_t>(oc) * C * 9;
+        float max_abs = 0.0f;
+        for (int i = 0; i < C * 9; ++i) {
+            max_abs = std::max(max_abs, std::fabs(w[i]));
+        }
+        const float s = max_abs > 0.0f ? max_abs / 127.0f : 1.0f;
+        out.scales[oc] = s;
+
+        // [C][3][3] -> [C/4][3][3][4]
+        int8_t* dst = out.data.data() + static_cast<size_t>(oc) * G * 36;
+        for (int c = 0; c < C; ++c) {
+            for (int t = 0; t < 9; ++t) {
+                float q = std::nearbyint(w[c * 9 + t] / s);
+                dst[(c / 4) * 36 + t * 4 + c % 4] = static_cast<int8_t>(std::clamp(q, -127.0f, 127.0f));
+            }
+        }
+    }
+}
+
+void quantize_activations(const float* in, int C, int H, int W, float scale, uint8_t* out) {
+    const int G = (C + 3) / 4;
+    const size_t plane = static_cast<size_t>(H) * W;
+    const float inv = 1.0f / scale;
+    const float qmax = static_cast<float>(kInt8ActivationMax);
+#if defined(BCNN_X86_KERNELS)
+    const Int8Isa isa = best_int8_isa();
+#endif
+
+    for (int g = 0; g < G; ++g) {
+        uint8_t* dst = out + g * plane * 4;
+        const float* src[4];
+        for (int l = 0; l < 4; ++l) {
+            src[l] = g * 4 + l < C ? in + (g * 4 + l) * plane : nullptr;
+        }
+
+#if defined(BCNN_X86_KERNELS)
+        if (src[3] && isa == Int8Isa::AVX512VNNI) {
+            detail::quantize_group_avx512(src, static_cast<long>(plane), inv, dst);
+            continue;
+        }
+        if (src[3] && isa == Int8Isa::AVX2) {
+            detail::quantize_group_avx2(src, static_cast<long>(plane), inv, dst);
+            continue;
+        }
+#endif
+        // 标量实现；不足4的通道补0，负值（ReLU之前不会出现）截为0
+        for (size_t i = 0; i < plane; ++i) {
+            for (int l = 0; l < 4; ++l) {
+                float q = src[l] ? std::min(std::max(src[l][i] * inv + 0.5f, 0.0f), qmax) : 0.0f;
+                dst[i * 4 + l] = static_cast<uint8_t>(static_cast<int>(q));
+            }
+        }
+    }
+}
+
+void conv3x3_int8_bn_relu_pool2(const uint8_t* in, int H, int W, const QuantizedConvWeights& weights,
+                                const float* scale, const float* shift, float* out) {
+    conv3x3_int8_bn_relu_pool2(in, H, W, weights, scale, shift, out, best_int8_isa());
+}
+
+void conv3x3_int8_bn_relu_pool2(const uint8_t* in, int H, int W, const QuantizedConvWeights& weights,
+                                const float* scale, const float* shift, float* out, Int8Isa isa) {
+    if (H < 2 || W < 2) {
+        return;
+    }
+    const int G = weights.channel_groups;
+    const int OC = weights.out_channels;
+    const int8_t* w = weights.data.data();
+#if defined(BCNN_X86_KERNELS)
+    if (int8_isa_supported(isa)) {
+        switch (isa) {
+            case Int8Isa::AVX2:
+                detail::conv3x3_int8_bn_relu_pool2_avx2(in, G, H, W, w, OC, scale, shift, out);
+                return;
+            case Int8Isa::AVX512VNNI:
+                detail::conv3x3_int8_bn_relu_pool2_vnni(in, G, H, W, w, OC, scale, shift, out);
+                return;
+            default:
+                break;
+        }
+    }
+#else
+    (void)isa;
+#endif
+    conv3x3_int8_bn_relu_pool2_scalar(in, G, H, W, w, OC, scale, shift, out);
+}
+
+} // namespace kernels
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// INT8 卷积块（Conv 3×3 s1 p1 -> 逐通道仿射 -> ReLU -> MaxPool 2×2 s2），用于训练后量化推理
+// 权重按输出通道对称量化为 int8（[-127, 127]）；激活值按张量量化为 0..127，只用于ReLU之后的
+// 非负输入，7位范围保证 vpmaddubsw 的16位中间和不会饱和。
+// 激活值按 [C/4][H][W][4] 排列，相邻4个输入通道组成一次4元素点积（VNNI vpdpbusd）。
+namespace kernels {
+
+constexpr int kInt8ActivationMax = 127;
+
+// INT8 点积实现
+enum class Int8Isa {
+    Scalar,
+    AVX2,           // vpmaddubsw + vpmaddwd
+    AVX512VNNI      // vpdpbusd
+};
+
+// 当前CPU支持的最佳实现（受环境变量 BCNN_ISA 限制：avx2 及以下不使用AVX-512）
+Int8Isa best_int8_isa();
+bool int8_isa_supported(Int8Isa isa);
+const char* int8_isa_name(Int8Isa isa);
+
+struct QuantizedConvWeights {
+    int out_channels = 0;
+    int in_channels = 0;
+    int channel_groups = 0;           // ceil(in_channels / 4)
+    std::vector<int8_t> data;         // [OC][C/4][3][3][4]，不足4的通道补0
+    std::vector<float> scales;        // 每输出通道 max|w| / 127
+
+    bool empty() const { return data.empty(); }
+};
+
+// weight 为 [OC][C][3][3]
+void quantize_conv3x3_weights(const float* weight, int OC, int C, QuantizedConvWeights& out);
+
+// in 为 C×H×W；q = clamp(round(x / scale), 0, 127)，out 需容纳 ceil(C/4)·H·W·4 字节
+void quantize_activations(const float* in, int C, int H, int W, float scale, uint8_t* out);
+
+// in 为 quantize_activations 的结果；acc 为 int32 卷积和，
+// out[oc] = maxpool2(relu(acc[oc] · scale[oc] + shift[oc]))，为 OC×(H/2)×(W/2) float
+// scale 通常为 输入scale × 权重scale[oc]（× BN scale）
+void conv3x3_int8_bn_relu_pool2(const uint8_t* in, int H, int W, const QuantizedConvWeights& weights,
+                                const float* scale, const float* shift, float* out);
+
+void conv3x3_int8_bn_relu_pool2(const uint8_t* in, int H, int W, const QuantizedConvWeights& weights,
+                                const float* scale, const float* shift, float* out, Int8Isa isa);
+
+} // namespace kernels
@@ -0,0 +1,183 @@
+// AVX2 实现：每次计算4个输出通道 × 2行 × 8像素。
+// 每个32位通道是一个像素的4个输入通道：vpmaddubsw 求相邻两对 u8×s8 乘积之和（int16，
+// 激活值不超过127因此不会饱和），vpmaddwd 再与1相乘把两个int16合并为int32。
+// BN仿射、ReLU和2×2池化在寄存器中完成，只写回池化结果。
+#include "engine/kernels/Int8ConvImpl.hpp"
+#include <immintrin.h>
+
+namespace kernels {
+namespace detail {
+namespace {
+
+// 一个8像素段的加载掩码：左邻(x-1)、中心(x)、右邻(x+1)
+struct SegmentMasks {
+    __m256i left;
+    __m256i center;
+    __m256i right;
+};
+
+SegmentMasks segment_masks(int x0, int W) {
+    alignas(32) int l[8], c[8], r[8];
+    for (int i = 0; i < 8; ++i) {
+        int x = x0 + i;
+        l[i] = (x - 1 >= 0 && x - 1 < W) ? -1 : 0;
+        c[i] = x < W ? -1 : 0;
+        r[i] = x + 1 < W ? -1 : 0;
+    }
+    SegmentMasks m;
+    m.left = _mm256_load_si256(reinterpret_cast<const __m256i*>(l));
+    m.center = _mm256_load_si256(reinterpret_cast<const __m256i*>(c));
+    m.right = _mm256_load_si256(reinterpret_cast<const __m256i*>(r));
+    return m;
+}
+
+inline __m256i broadcast4(const int8_t* k) {
+    int v;
+    __builtin_memcpy(&v, k, 4);
+    return _mm256_set1_epi32(v);
+}
+
+// acc += 每个32位通道内4个 u8×s8 乘积之和
+inline __m256i dot4(__m256i acc, __m256i a, __m256i b, __m256i ones) {
+    return _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_maddubs_epi16(a, b), ones));
+}
+
+template <int NB, bool Edge>
+void block_segment(const uint8_t* in, int G, int H, int W, const int8_t* weight,
+                   const float* scale, const float* shift, int oc0, int py, int x0,
+                   const SegmentMasks& m, int PH, int PW, float* out) {
+    const long plane = static_cast<long>(H) * W * 4;
+    const int y0 = 2 * py;
+    const __m256i ones = _mm256_set1_epi16(1);
+
+    // acc0 / acc1：卷积输出第 y0 / y0+1 行
+    __m256i acc0[NB], acc1[NB];
+    #pragma GCC unroll 8
+    for (int j = 0; j < NB; ++j) {
+        acc0[j] = _mm256_setzero_si256();
+        acc1[j] = _mm256_setzero_si256();
+    }
+
+    for (int g = 0; g < G; ++g) {
+        const uint8_t* src = in + g * plane;
+        // 两行卷积共用输入行 y0-1 .. y0+2；第 r 行对 acc0 是抽头行 r，对 acc1 是抽头行 r-1
+        #pragma GCC unroll 4
+        for (int r = 0; r < 4; ++r) {
+            int iy = y0 + r - 1;
+            if (iy < 0 || iy >= H) continue;
+            const int* row = reinterpret_cast<const int*>(src + (static_cast<long>(iy) * W + x0) * 4);
+            __m256i l, c, rr;
+            if (Edge) {
+                l = _mm256_maskload_epi32(row - 1, m.left);
+                c = _mm256_maskload_epi32(row, m.center);
+                rr = _mm256_maskload_epi32(row + 1, m.right);
+            } else {
+                l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row - 1));
+                c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row));
+                rr = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + 1));
+            }
+
+            #pragma GCC unroll 8
+            for (int j = 0; j < NB; ++j) {
+                const int8_t* k = weight + (static_cast<long>(oc0 + j) * G + g) * 36;
+                if (r < 3) {
+                    const int8_t* k0 = k + r * 12;
+                    acc0[j] = dot4(acc0[j], l, broadcast4(k0), ones);
+                    acc0[j] = dot4(acc0[j], c, broadcast4(k0 + 4), ones);
+                    acc0[j] = dot4(acc0[j], rr, broadcast4(k0 + 8), ones);
+                }
+                if (r > 0) {
+                    const int8_t* k1 = k + (r - 1) * 12;
+                    acc1[j] = dot4(acc1[j], l, broadcast4(k1), ones);
+                    acc1[j] = dot4(acc1[j], c, broadcast4(k1 + 4), ones);
+                    acc1[j] = dot4(acc1[j], rr, broadcast4(k1 + 8), ones);
+                }
+            }
+        }
+    }
+
+    // 反量化 + BN + ReLU，行间最大值后把相邻两列的最大值压缩到低4个通道
+    const __m256i even = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    const __m256 zero = _mm256_setzero_ps();
+    const int px0 = x0 / 2;
+    const int count = PW - px0 < 4 ? PW - px0 : 4;
+    const __m128i store_mask = _mm_cmpgt_epi32(_mm_set1_epi32(count), _mm_setr_epi32(0, 1, 2, 3));
+
+    #pragma GCC unroll 8
+    for (int j = 0; j < NB; ++j) {
+        const __m256 s = _mm256_set1_ps(scale[oc0 + j]);
+        const __m256 t = _mm256_set1_ps(shift[oc0 + j]);
+        __m256 a = _mm256_max_ps(_mm256_fmadd_ps(_mm256_cvtepi32_ps(acc0[j]), s, t), zero);
+        __m256 b = _mm256_max_ps(_mm256_fmadd_ps(_mm256_cvtepi32_ps(acc1[j]), s, t), zero);
+        __m256 v = _mm256_max_ps(a, b);
+        v = _mm256_max_ps(v, _mm256_permute_ps(v, 0xB1));
+        __m128 pooled = _mm256_castps256_ps128(_mm256_permutevar8x32_ps(v, even));
+
+        float* dst = out + (static_cast<long>(oc0 + j) * PH + py) * PW + px0;
+        if (count == 4) {
+            _mm_storeu_ps(dst, pooled);
+        } else {
+            _mm_maskstore_ps(dst, store_mask, pooled);
+        }
+    }
+}
+
+template <int NB>
+void pool_block(const uint8_t* in, int G, int H, int W, const int8_t* weight,
+                const float* scale, const float* shift, int oc0, float* out) {
+    const int PH = H / 2;
+    const int PW = W / 2;
+    for (int py = 0; py < PH; ++py) {
+        for (int x0 = 0; x0 < 2 * PW; x0 += 8) {
+            if (x0 >= 1 && x0 + 9 <= W) {
+                block_segment<NB, false>(in, G, H, W, weight, scale, shift, oc0, py, x0,
+                                         SegmentMasks(), PH, PW, out);
+            } else {
+                block_segment<NB, true>(in, G, H, W, weight, scale, shift, oc0, py, x0,
+                                        segment_masks(x0, W), PH, PW, out);
+            }
+        }
+    }
+}
+
+} // namespace
+
+void quantize_group_avx2(const float* const* src, long n, float inv, uint8_t* out) {
+    const __m256 scale = _mm256_set1_ps(inv);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 qmax = _mm256_set1_ps(127.0f);
+    long i = 0;
+    for (; i + 8 <= n; i += 8) {
+        // 每个像素的4个通道拼成一个32位整数：c0 | c1 << 8 | c2 << 16 | c3 << 24
+        __m256i packed = _mm256_setzero_si256();
+        #pragma GCC unroll 4
+        for (int l = 0; l < 4; ++l) {
+            __m256 v = _mm256_fmadd_ps(_mm256_loadu_ps(src[l] + i), scale, half);
+            v = _mm256_min_ps(_mm256_max_ps(v, zero), qmax);
+            packed = _mm256_or_si256(packed, _mm256_slli_epi32(_mm256_cvttps_epi32(v), 8 * l));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 4), packed);
+    }
+    for (; i < n; ++i) {
+        for (int l = 0; l < 4; ++l) {
+            float q = src[l][i] * inv + 0.5f;
+            q = q < 0.0f ? 0.0f : (q > 127.0f ? 127.0f : q);
+            out[i * 4 + l] = static_cast<uint8_t>(static_cast<int>(q));
+        }
+    }
+}
+
+void conv3x3_int8_bn_relu_pool2_avx2(const uint8_t* in, int G, int H, int W, const int8_t* weight,
+                                     int OC, const float* scale, const float* shift, float* out) {
+    int oc = 0;
+    for (; oc + 4 <= OC; oc += 4) {
+        pool_block<4>(in, G, H, W, weight, scale, shift, oc, out);
+    }
+    for (; oc < OC; ++oc) {
+        pool_block<1>(in, G, H, W, weight, scale, shift, oc, out);
+    }
+}
+
+} // namespace detail
+} // namespace kernels
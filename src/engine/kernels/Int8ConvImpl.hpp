@@ -0,0 +1,20 @@
+#pragma once
+// INT8 卷积各指令集实现的内部声明，规则同 Conv3x3Impl.hpp：
+// 每个实现位于单独的翻译单元，只包含 <immintrin.h>。
+#include <cstdint>
+
+namespace kernels {
+namespace detail {
+
+// in: [G][H][W][4] uint8，weight: [OC][G][3][3][4] int8
+void conv3x3_int8_bn_relu_pool2_avx2(const uint8_t* in, int G, int H, int W, const int8_t* weight,
+                                     int OC, const float* scale, const float* shift, float* out);
+void conv3x3_int8_bn_relu_pool2_vnni(const uint8_t* in, int G, int H, int W, const int8_t* weight,
+                                     int OC, const float* scale, const float* shift, float* out);
+
+// 把4个通道各 n 个值量化后交错写入 out[n][4]
+void quantize_group_avx2(const float* const* src, long n, float inv, uint8_t* out);
+void quantize_group_avx512(const float* const* src, long n, float inv, uint8_t* out);
+
+} // namespace detail
+} // namespace kernels
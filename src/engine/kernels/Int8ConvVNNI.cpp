@@ -0,0 +1,144 @@
+// AVX-512 VNNI 实现：每次计算4个输出通道 × 2行 × 16像素，
+// 每个32位通道是一个像素的4个输入通道，vpdpbusd 一次完成4元素 u8×s8 点积并累加到int32。
+// BN仿射、ReLU和2×2池化在寄存器中完成，只写回池化结果。
+#include "engine/kernels/Int8ConvImpl.hpp"
+#include <immintrin.h>
+
+namespace kernels {
+namespace detail {
+namespace {
+
+// 一个16像素段的加载掩码：左邻(x-1)、中心(x)、右邻(x+1)
+struct SegmentMasks {
+    __mmask16 left = 0;
+    __mmask16 center = 0;
+    __mmask16 right = 0;
+};
+
+SegmentMasks segment_masks(int x0, int W) {
+    SegmentMasks m;
+    for (int i = 0; i < 16; ++i) {
+        int x = x0 + i;
+        if (x - 1 >= 0 && x - 1 < W) m.left |= static_cast<__mmask16>(1u << i);
+        if (x < W) m.center |= static_cast<__mmask16>(1u << i);
+        if (x + 1 < W) m.right |= static_cast<__mmask16>(1u << i);
+    }
+    return m;
+}
+
+// 4个int8权重（同一抽头的4个输入通道）广播到每个32位通道
+inline __m512i broadcast4(const int8_t* k) {
+    int v;
+    __builtin_memcpy(&v, k, 4);
+    return _mm512_set1_epi32(v);
+}
+
+template <int NB>
+void pool_block(const uint8_t* in, int G, int H, int W, const int8_t* weight,
+                const float* scale, const float* shift, int oc0, float* out) {
+    const long plane = static_cast<long>(H) * W * 4;
+    const int PH = H / 2;
+    const int PW = W / 2;
+    const __m512i even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 0, 2, 4, 6, 8, 10, 12, 14);
+    const __m512 zero = _mm512_setzero_ps();
+
+    // 只计算池化用到的 2·PW 列
+    for (int x0 = 0; x0 < 2 * PW; x0 += 16) {
+        const SegmentMasks m = segment_masks(x0, W);
+        const int px0 = x0 / 2;
+        const int count = PW - px0 < 8 ? PW - px0 : 8;
+        const __mmask16 store_mask = static_cast<__mmask16>((1u << count) - 1);
+
+        for (int py = 0; py < PH; ++py) {
+            const int y0 = 2 * py;
+
+            // acc0 / acc1：卷积输出第 y0 / y0+1 行
+            __m512i acc0[NB], acc1[NB];
+            #pragma GCC unroll 8
+            for (int j = 0; j < NB; ++j) {
+                acc0[j] = _mm512_setzero_si512();
+                acc1[j] = _mm512_setzero_si512();
+            }
+
+            for (int g = 0; g < G; ++g) {
+                const uint8_t* src = in + g * plane;
+                // 两行卷积共用输入行 y0-1 .. y0+2；第 r 行对 acc0 是抽头行 r，对 acc1 是抽头行 r-1
+                #pragma GCC unroll 4
+                for (int r = 0; r < 4; ++r) {
+                    int iy = y0 + r - 1;
+                    if (iy < 0 || iy >= H) continue;
+                    const uint8_t* row = src + (static_cast<long>(iy) * W + x0) * 4;
+                    __m512i l = _mm512_maskz_loadu_epi32(m.left, row - 4);
+                    __m512i c = _mm512_maskz_loadu_epi32(m.center, row);
+                    __m512i rr = _mm512_maskz_loadu_epi32(m.right, row + 4);
+
+                    #pragma GCC unroll 8
+                    for (int j = 0; j < NB; ++j) {
+                        const int8_t* k = weight + (static_cast<long>(oc0 + j) * G + g) * 36;
+                        if (r < 3) {
+                            const int8_t* k0 = k + r * 12;
+                            acc0[j] = _mm512_dpbusd_epi32(acc0[j], l, broadcast4(k0));
+                            acc0[j] = _mm512_dpbusd_epi32(acc0[j], c, broadcast4(k0 + 4));
+                            acc0[j] = _mm512_dpbusd_epi32(acc0[j], rr, broadcast4(k0 + 8));
+                        }
+                        if (r > 0) {
+                            const int8_t* k1 = k + (r - 1) * 12;
+                            acc1[j] = _mm512_dpbusd_epi32(acc1[j], l, broadcast4(k1));
+                            acc1[j] = _mm512_dpbusd_epi32(acc1[j], c, broadcast4(k1 + 4));
+                            acc1[j] = _mm512_dpbusd_epi32(acc1[j], rr, broadcast4(k1 + 8));
+                        }
+                    }
+                }
+            }
+
+            // 反量化 + BN + ReLU，行间最大值后把相邻两列的最大值压缩到低8个通道
+            #pragma GCC unroll 8
+            for (int j = 0; j < NB; ++j) {
+                const __m512 s = _mm512_set1_ps(scale[oc0 + j]);
+                const __m512 t = _mm512_set1_ps(shift[oc0 + j]);
+                __m512 a = _mm512_max_ps(_mm512_fmadd_ps(_mm512_cvtepi32_ps(acc0[j]), s, t), zero);
+                __m512 b = _mm512_max_ps(_mm512_fmadd_ps(_mm512_cvtepi32_ps(acc1[j]), s, t), zero);
+                __m512 v = _mm512_max_ps(a, b);
+                v = _mm512_max_ps(v, _mm512_permute_ps(v, 0xB1));
+                _mm512_mask_storeu_ps(out + (static_cast<long>(oc0 + j) * PH + py) * PW + px0,
+                                      store_mask, _mm512_permutexvar_ps(even, v));
+            }
+        }
+    }
+}
+
+} // namespace
+
+void quantize_group_avx512(const float* const* src, long n, float inv, uint8_t* out) {
+    const __m512 scale = _mm512_set1_ps(inv);
+    const __m512 half = _mm512_set1_ps(0.5f);
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 qmax = _mm512_set1_ps(127.0f);
+    for (long i = 0; i < n; i += 16) {
+        const __mmask16 mask = n - i >= 16 ? static_cast<__mmask16>(0xFFFF)
+                                           : static_cast<__mmask16>((1u << (n - i)) - 1);
+        // 每个像素的4个通道拼成一个32位整数：c0 | c1 << 8 | c2 << 16 | c3 << 24
+        __m512i packed = _mm512_setzero_si512();
+        #pragma GCC unroll 4
+        for (int l = 0; l < 4; ++l) {
+            __m512 v = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, src[l] + i), scale, half);
+            v = _mm512_min_ps(_mm512_max_ps(v, zero), qmax);
+            packed = _mm512_or_si512(packed, _mm512_slli_epi32(_mm512_cvttps_epi32(v), 8 * l));
+        }
+        _mm512_mask_storeu_epi32(out + i * 4, mask, packed);
+    }
+}
+
+void conv3x3_int8_bn_relu_pool2_vnni(const uint8_t* in, int G, int H, int W, const int8_t* weight,
+                                     int OC, const float* scale, const float* shift, float* out) {
+    int oc = 0;
+    for (; oc + 4 <= OC; oc += 4) {
+        pool_block<4>(in, G, H, W, weight, scale, shift, oc, out);
+    }
+    for (; oc < OC; ++oc) {
+        pool_block<1>(in, G, H, W, weight, scale, shift, oc, out);
+    }
+}
+
+} // namespace detail
+} // namespace kernels
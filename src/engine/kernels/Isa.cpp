@@ -0,0 +1,66 @@
+#include "engine/kernels/Isa.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace kernels {
+
+namespace {
+
+bool cpu_has(Isa isa) {
+#if defined(BCNN_X86_KERNELS)
+    switch (isa) {
+        case Isa::Scalar: return true;
+        case Isa::SSE42: return __builtin_cpu_supports("sse4.2");
+        case Isa::AVX2: return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case Isa::AVX512: return __builtin_cpu_supports("avx512f");
+    }
+    return false;
+#else
+    return isa == Isa::Scalar;
+#endif
+}
+
+Isa detect_best() {
+    Isa best = Isa::Scalar;
+    for (Isa isa : {Isa::SSE42, Isa::AVX2, Isa::AVX512}) {
+        if (cpu_has(isa)) best = isa;
+    }
+
+    // 允许通过环境变量降级，便于对比各实现
+    if (const char* env = std::getenv("BCNN_ISA")) {
+        for (Isa isa : {Isa::Scalar, Isa::SSE42, Isa::AVX2, Isa::AVX512}) {
+            if (std::strcmp(env, isa_name(isa)) == 0) {
+                if (cpu_has(isa)) {
+                    best = isa;
+                } else {
+                    std::cerr << "BCNN_ISA=" << env << " 不受支持，使用 " << isa_name(best) << std::endl;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+Isa best_isa() {
+    static const Isa isa = detect_best();
+    return isa;
+}
+
+bool isa_supported(Isa isa) {
+    return cpu_has(isa);
+}
+
+const char* isa_name(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar: return "scalar";
+        case Isa::SSE42: return "sse42";
+        case Isa::AVX2: return "avx2";
+        case Isa::AVX512: return "avx512";
+    }
+    return "unknown";
+}
+
+} // namespace kernels
@@ -0,0 +1,21 @@
+#pragma once
+
+// 运行时指令集选择（各计算内核共用）
+namespace kernels {
+
+enum class Isa {
+    Scalar,
+    SSE42,
+    AVX2,       // AVX2 + FMA
+    AVX512      // AVX-512F
+};
+
+// 当前CPU支持的最佳指令集（可用环境变量 BCNN_ISA=scalar|sse42|avx2|avx512 降级）
+Isa best_isa();
+
+// CPU和编译配置是否支持指定指令集
+bool isa_supported(Isa isa);
+
+const char* isa_name(Isa isa);
+
+} // namespace kernels
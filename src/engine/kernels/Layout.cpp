@@ -0,0 +1,84 @@
+#include "engine/kernels/Layout.hpp"
+#include <algorithm>
+
+namespace kernels {
+
+int channel_block(Isa isa) {
+#if defined(BCNN_X86_KERNELS)
+    switch (isa) {
+        case Isa::AVX512: return 16;
+        case Isa::AVX2: return 8;
+        default: break;
+    }
+#else
+    (void)isa;
+#endif
+    return 0;
+}
+
+void reorder_nchw_to_nchwc(const float* in, int C, int H, int W, int cb, float* out) {
+    const size_t plane = static_cast<size_t>(H) * W;
+    const int groups = (C + cb - 1) / cb;
+    for (int g = 0; g < groups; ++g) {
+        float* dst = out + g * plane * cb;
+        for (int l = 0; l < cb; ++l) {
+            const int c = g * cb + l;
+            if (c >= C) {
+                for (size_t i = 0; i < plane; ++i) dst[i * cb + l] = 0.0f;
+                continue;
+            }
+            const float* src = in + c * plane;
+            for (size_t i = 0; i < plane; ++i) dst[i * cb + l] = src[i];
+        }
+    }
+}
+
+void reorder_nchwc_to_nchw(const float* in, int C, int H, int W, int cb, float* out) {
+    const size_t plane = static_cast<size_t>(H) * W;
+    for (int c = 0; c < C; ++c) {
+        const float* src = in + (c / cb) * plane * cb + c % cb;
+        float* dst = out + c * plane;
+        for (size_t i = 0; i < plane; ++i) dst[i] = src[i * cb];
+    }
+}
+
+void global_avg_pool_nchwc(const float* in, int C, int H, int W, int cb, float* out) {
+    const size_t plane = static_cast<size_t>(H) * W;
+    const int groups = (C + cb - 1) / cb;
+    // 每组的 cb 个通道在像素内相邻，按像素顺序累加即可向量化
+    double sum[16];
+    for (int g = 0; g < groups; ++g) {
+        const float* src = in + g * plane * cb;
+        std::fill(sum, sum + cb, 0.0);
+        for (size_t i = 0; i < plane; ++i) {
+            for (int l = 0; l < cb; ++l) sum[l] += src[i * cb + l];
+        }
+        for (int l = 0; l < cb && g * cb + l < C; ++l) {
+            out[g * cb + l] = static_cast<float>(sum[l] / plane);
+        }
+    }
+}
+
+ChannelView channel_view_nchw(const float* data, int C, int H, int W, int channel) {
+    ChannelView view;
+    if (!data || channel < 0 || channel >= C) return view;
+    view.data = data + static_cast<size_t>(channel) * H * W;
+    view.width = W;
+    view.height = H;
+    view.x_stride = 1;
+    view.y_stride = W;
+    return view;
+}
+
+ChannelView channel_view_nchwc(const float* data, int C, int H, int W, int cb, int channel) {
+    ChannelView view;
+    if (!data || cb <= 0 || channel < 0 || channel >= C) return view;
+    view.data = data + static_cast<size_t>(channel / cb) * H * W * cb + channel % cb;
+    view.width = W;
+    view.height = H;
+    view.x_stride = cb;
+    view.y_stride = static_cast<size_t>(W) * cb;
+    return view;
+}
+
+} // namespace kernels
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include "engine/kernels/Isa.hpp"
+
+// 激活值内存布局
+// NCHW：每个通道一个连续的 H×W 平面（PyTorch 及导出的激活值都是这种布局）
+// NCHWc：通道按 cb 个一组（cb = 8 / 16），每组存为 [H][W][cb]，同一像素的 cb 个通道相邻，
+//        一个向量正好对应 cb 个通道；通道数不是 cb 的倍数时最后一组补0
+namespace kernels {
+
+// 指令集对应的通道块大小：AVX-512 为16，AVX2 为8，其余为0（不使用分块布局）
+int channel_block(Isa isa);
+
+inline size_t nchwc_size(int C, int H, int W, int cb) {
+    return static_cast<size_t>((C + cb - 1) / cb) * cb * H * W;
+}
+
+// 布局转换；out 的大小分别为 nchwc_size(C, H, W, cb) 和 C·H·W
+void reorder_nchw_to_nchwc(const float* in, int C, int H, int W, int cb, float* out);
+void reorder_nchwc_to_nchw(const float* in, int C, int H, int W, int cb, float* out);
+
+// NCHWc 输入的全局平均池化，输出按通道顺序的 C 个值
+void global_avg_pool_nchwc(const float* in, int C, int H, int W, int cb, float* out);
+
+// 单个通道的只读跨步视图，直接引用原数据，不复制
+struct ChannelView {
+    const float* data = nullptr;
+    int width = 0;
+    int height = 0;
+    size_t x_stride = 1;              // 相邻像素的间隔（float个数）
+    size_t y_stride = 0;              // 相邻行的间隔
+
+    bool valid() const { return data != nullptr; }
+    float at(int x, int y) const { return data[y * y_stride + x * x_stride]; }
+};
+
+// channel 越界时返回无效视图
+ChannelView channel_view_nchw(const float* data, int C, int H, int W, int channel);
+ChannelView channel_view_nchwc(const float* data, int C, int H, int W, int cb, int channel);
+
+} // namespace kernels
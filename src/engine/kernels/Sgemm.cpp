@@ -0,0 +1,149 @@
+#include "engine/kernels/Sgemm.hpp"
+#include "engine/kernels/SgemmImpl.hpp"
+#include <algorithm>
+
+namespace kernels {
+namespace detail {
+
+void sgemm_ukernel_scalar(int kc, const float* a, const float* b, float* c, int ldc,
+                          int m, int n, bool accumulate, const float* bias) {
+    constexpr int MR = detail::kGemmMR;
+    constexpr int NR = kGemmNRScalar;
+
+    float acc[MR][NR] = {};
+    for (int k = 0; k < kc; ++k) {
+        for (int i = 0; i < MR; ++i) {
+            float ai = a[i];
+            for (int j = 0; j < NR; ++j) {
+                acc[i][j] += ai * b[j];
+            }
+        }
+        a += MR;
+        b += NR;
+    }
+
+    for (int i = 0; i < m; ++i) {
+        float* ci = c + static_cast<long>(i) * ldc;
+        float base = bias ? bias[i] : 0.0f;
+        for (int j = 0; j < n; ++j) {
+            ci[j] = (accumulate ? ci[j] : base) + acc[i][j];
+        }
+    }
+}
+
+} // namespace detail
+
+namespace {
+
+// 分块参数：B 的 KC×NR 微面板留在L1，KC×NC 块留在L2
+constexpr int kKC = 256;
+constexpr int kNC = 512;
+
+struct Microkernel {
+    detail::SgemmMicrokernel fn;
+    int nr;
+};
+
+Microkernel select_microkernel(Isa isa) {
+#if defined(BCNN_X86_KERNELS)
+    if (isa_supported(isa)) {
+        // SSE4.2 没有FMA，使用可被编译器自动向量化的标量微内核
+        switch (isa) {
+            case Isa::AVX2: return {detail::sgemm_ukernel_avx2, detail::kGemmNRAVX2};
+            case Isa::AVX512: return {detail::sgemm_ukernel_avx512, detail::kGemmNRAVX512};
+            default: break;
+        }
+    }
+#else
+    (void)isa;
+#endif
+    return {detail::sgemm_ukernel_scalar, detail::kGemmNRScalar};
+}
+
+} // namespace
+
+void pack_matrix_a(const float* A, int M, int K, int lda, PackedMatrix& out) {
+    constexpr int MR = detail::kGemmMR;
+    const int panels = (M + MR - 1) / MR;
+
+    out.rows = M;
+    out.depth = K;
+    out.data.assign(static_cast<size_t>(panels) * K * MR, 0.0f);
+
+    for (int p = 0; p < panels; ++p) {
+        float* panel = out.data.data() + static_cast<size_t>(p) * K * MR;
+        for (int i = 0; i < MR && p * MR + i < M; ++i) {
+            const float* row = A + static_cast<long>(p * MR + i) * lda;
+            for (int k = 0; k < K; ++k) {
+                panel[k * MR + i] = row[k];
+            }
+        }
+    }
+}
+
+int sgemm_panel_width(Isa isa) {
+    return select_microkernel(isa).nr;
+}
+
+void pack_matrix_b(const float* B, int K, int N, int ldb, int nr, float* packed) {
+    for (int j0 = 0; j0 < N; j0 += nr) {
+        const int n = std::min(nr, N - j0);
+        for (int k = 0; k < K; ++k) {
+            const float* src = B + static_cast<long>(k) * ldb + j0;
+            float* dst = packed + k * nr;
+            std::copy(src, src + n, dst);
+            std::fill(dst + n, dst + nr, 0.0f);
+        }
+        packed += static_cast<size_t>(K) * nr;
+    }
+}
+
+void sgemm_packed(const PackedMatrix& A, const float* B, int N, int ldb,
+                  const float* bias, float* C, int ldc) {
+    sgemm_packed(A, B, N, ldb, bias, C, ldc, best_isa());
+}
+
+void sgemm_packed(const PackedMatrix& A, const float* B, int N, int ldb,
+                  const float* bias, float* C, int ldc, Isa isa) {
+    const int nr = sgemm_panel_width(isa);
+    const int K = A.depth;
+
+    // B 的打包缓冲区按线程复用
+    thread_local std::vector<float> packedB;
+    packedB.resize(static_cast<size_t>(K) * ((N + nr - 1) / nr) * nr);
+    pack_matrix_b(B, K, N, ldb, nr, packedB.data());
+    sgemm_prepacked(A, packedB.data(), N, bias, C, ldc, isa);
+}
+
+void sgemm_prepacked(const PackedMatrix& A, const float* packedB, int N,
+                     const float* bias, float* C, int ldc, Isa isa) {
+    constexpr int MR = detail::kGemmMR;
+    const int M = A.rows;
+    const int K = A.depth;
+    const int panels = (M + MR - 1) / MR;
+    const Microkernel uk = select_microkernel(isa);
+
+    // kNC 是各微内核 NR 的整数倍，列分块总是从微面板边界开始
+    for (int jc = 0; jc < N; jc += kNC) {
+        const int nc = std::min(kNC, N - jc);
+
+        for (int pc = 0; pc < K; pc += kKC) {
+            const int kc = std::min(kKC, K - pc);
+
+            for (int jr = 0; jr < nc; jr += uk.nr) {
+                const float* bPanel = packedB + (static_cast<size_t>(jc + jr) / uk.nr * K + pc) * uk.nr;
+                const int n = std::min(uk.nr, nc - jr);
+
+                for (int p = 0; p < panels; ++p) {
+                    const float* aPanel = A.data.data() + (static_cast<size_t>(p) * K + pc) * MR;
+                    const int m = std::min(MR, M - p * MR);
+                    float* cTile = C + static_cast<long>(p * MR) * ldc + jc + jr;
+                    uk.fn(kc, aPanel, bPanel, cTile, ldc, m, n, pc > 0,
+                          bias ? bias + p * MR : nullptr);
+                }
+            }
+        }
+    }
+}
+
+} // namespace kernels
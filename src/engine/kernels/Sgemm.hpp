@@ -0,0 +1,42 @@
+#pragma once
+#include "engine/kernels/Isa.hpp"
+#include <vector>
+
+// 单精度矩阵乘 C[M×N] = A[M×K] · B[K×N] (+ bias[m])
+// A 为权重矩阵，在加载模型时一次性打包成按 MR 行分组的面板；
+// B 打包成宽度为 NR 的列面板（NR 取决于指令集），计算时按 KC×NC 分块遍历，
+// 微内核在寄存器中计算 MR×NR 的输出块。
+namespace kernels {
+
+// 打包后的A：ceil(M/MR) 个面板，每个面板为 K×MR（按k优先），不足MR行的部分补0
+struct PackedMatrix {
+    int rows = 0;
+    int depth = 0;
+    std::vector<float> data;
+
+    bool empty() const { return data.empty(); }
+};
+
+// 打包行优先矩阵 A（lda 为行跨度）
+void pack_matrix_a(const float* A, int M, int K, int lda, PackedMatrix& out);
+
+// 打包后B的列面板宽度 NR
+int sgemm_panel_width(Isa isa);
+
+// 把行优先的 B[K×N] 打包为 ceil(N/nr) 个 K×nr 面板（按k优先），越界列补0
+void pack_matrix_b(const float* B, int K, int N, int ldb, int nr, float* packed);
+
+// C = A·B (+ bias)，B 行优先（ldb 为行跨度），C 行优先（ldc 为行跨度）
+// bias 可为 nullptr
+void sgemm_packed(const PackedMatrix& A, const float* B, int N, int ldb,
+                  const float* bias, float* C, int ldc);
+
+// 指定指令集（不支持时退回标量微内核）
+void sgemm_packed(const PackedMatrix& A, const float* B, int N, int ldb,
+                  const float* bias, float* C, int ldc, Isa isa);
+
+// B 已按 sgemm_panel_width(isa) 打包（例如由im2col直接写成面板格式）
+void sgemm_prepacked(const PackedMatrix& A, const float* packedB, int N,
+                     const float* bias, float* C, int ldc, Isa isa);
+
+} // namespace kernels
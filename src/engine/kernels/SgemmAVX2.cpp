@@ -0,0 +1,67 @@
+// AVX2 + FMA 微内核：6×16 输出块，12个累加寄存器
+#include "engine/kernels/SgemmImpl.hpp"
+#include <immintrin.h>
+
+namespace kernels {
+namespace detail {
+
+void sgemm_ukernel_avx2(int kc, const float* a, const float* b, float* c, int ldc,
+                        int m, int n, bool accumulate, const float* bias) {
+    constexpr int MR = kGemmMR;
+    constexpr int NR = kGemmNRAVX2;
+
+    __m256 acc[MR][2];
+    #pragma GCC unroll 8
+    for (int i = 0; i < MR; ++i) {
+        acc[i][0] = _mm256_setzero_ps();
+        acc[i][1] = _mm256_setzero_ps();
+    }
+
+    for (int k = 0; k < kc; ++k) {
+        __m256 b0 = _mm256_loadu_ps(b);
+        __m256 b1 = _mm256_loadu_ps(b + 8);
+        #pragma GCC unroll 8
+        for (int i = 0; i < MR; ++i) {
+            __m256 ai = _mm256_broadcast_ss(a + i);
+            acc[i][0] = _mm256_fmadd_ps(ai, b0, acc[i][0]);
+            acc[i][1] = _mm256_fmadd_ps(ai, b1, acc[i][1]);
+        }
+        a += MR;
+        b += NR;
+    }
+
+    if (m == MR && n == NR) {
+        #pragma GCC unroll 8
+        for (int i = 0; i < MR; ++i) {
+            float* ci = c + static_cast<long>(i) * ldc;
+            __m256 base0, base1;
+            if (accumulate) {
+                base0 = _mm256_loadu_ps(ci);
+                base1 = _mm256_loadu_ps(ci + 8);
+            } else {
+                base0 = base1 = _mm256_set1_ps(bias ? bias[i] : 0.0f);
+            }
+            _mm256_storeu_ps(ci, _mm256_add_ps(base0, acc[i][0]));
+            _mm256_storeu_ps(ci + 8, _mm256_add_ps(base1, acc[i][1]));
+        }
+        return;
+    }
+
+    // 边缘块：先写到临时块再按有效范围合并
+    alignas(32) float tile[MR][NR];
+    #pragma GCC unroll 8
+    for (int i = 0; i < MR; ++i) {
+        _mm256_store_ps(tile[i], acc[i][0]);
+        _mm256_store_ps(tile[i] + 8, acc[i][1]);
+    }
+    for (int i = 0; i < m; ++i) {
+        float* ci = c + static_cast<long>(i) * ldc;
+        float base = bias ? bias[i] : 0.0f;
+        for (int j = 0; j < n; ++j) {
+            ci[j] = (accumulate ? ci[j] : base) + tile[i][j];
+        }
+    }
+}
+
+} // namespace detail
+} // namespace kernels
@@ -0,0 +1,54 @@
+// AVX-512F 微内核：6×32 输出块，12个累加寄存器；边缘块用掩码加载/存储
+#include "engine/kernels/SgemmImpl.hpp"
+#include <immintrin.h>
+
+namespace kernels {
+namespace detail {
+
+void sgemm_ukernel_avx512(int kc, const float* a, const float* b, float* c, int ldc,
+                          int m, int n, bool accumulate, const float* bias) {
+    constexpr int MR = kGemmMR;
+    constexpr int NR = kGemmNRAVX512;
+
+    __m512 acc[MR][2];
+    #pragma GCC unroll 8
+    for (int i = 0; i < MR; ++i) {
+        acc[i][0] = _mm512_setzero_ps();
+        acc[i][1] = _mm512_setzero_ps();
+    }
+
+    for (int k = 0; k < kc; ++k) {
+        __m512 b0 = _mm512_loadu_ps(b);
+        __m512 b1 = _mm512_loadu_ps(b + 16);
+        #pragma GCC unroll 8
+        for (int i = 0; i < MR; ++i) {
+            __m512 ai = _mm512_set1_ps(a[i]);
+            acc[i][0] = _mm512_fmadd_ps(ai, b0, acc[i][0]);
+            acc[i][1] = _mm512_fmadd_ps(ai, b1, acc[i][1]);
+        }
+        a += MR;
+        b += NR;
+    }
+
+    // 列方向的有效掩码
+    const int n0 = n < 16 ? n : 16;
+    const int n1 = n > 16 ? n - 16 : 0;
+    const __mmask16 mask0 = static_cast<__mmask16>((1u << n0) - 1u);
+    const __mmask16 mask1 = static_cast<__mmask16>((1u << n1) - 1u);
+
+    for (int i = 0; i < m; ++i) {
+        float* ci = c + static_cast<long>(i) * ldc;
+        __m512 base0, base1;
+        if (accumulate) {
+            base0 = _mm512_maskz_loadu_ps(mask0, ci);
+            base1 = _mm512_maskz_loadu_ps(mask1, ci + 16);
+        } else {
+            base0 = base1 = _mm512_set1_ps(bias ? bias[i] : 0.0f);
+        }
+        _mm512_mask_storeu_ps(ci, mask0, _mm512_add_ps(base0, acc[i][0]));
+        _mm512_mask_storeu_ps(ci + 16, mask1, _mm512_add_ps(base1, acc[i][1]));
+    }
+}
+
+} // namespace detail
+} // namespace kernels
@@ -0,0 +1,29 @@
+#pragma once
+// SGEMM 微内核的内部声明。与 Conv3x3Impl.hpp 相同，各指令集实现位于单独的
+// 翻译单元，只包含 <immintrin.h>。
+
+namespace kernels {
+namespace detail {
+
+// 打包A面板的行数（各微内核共用）与各微内核的输出块列数
+constexpr int kGemmMR = 6;
+constexpr int kGemmNRScalar = 8;
+constexpr int kGemmNRAVX2 = 16;
+constexpr int kGemmNRAVX512 = 32;
+
+// 计算 MR×NR 输出块：a 为 kc×MR 面板，b 为 kc×NR 面板（均按k优先）。
+// accumulate 为 true 时累加到 C，否则写入 bias[i]（bias 为 nullptr 时为0）加上乘积；
+// m、n 为该块实际有效的行数和列数。
+using SgemmMicrokernel = void (*)(int kc, const float* a, const float* b,
+                                  float* c, int ldc, int m, int n,
+                                  bool accumulate, const float* bias);
+
+void sgemm_ukernel_scalar(int kc, const float* a, const float* b, float* c, int ldc,
+                          int m, int n, bool accumulate, const float* bias);
+void sgemm_ukernel_avx2(int kc, const float* a, const float* b, float* c, int ldc,
+                        int m, int n, bool accumulate, const float* bias);
+void sgemm_ukernel_avx512(int kc, const float* a, const float* b, float* c, int ldc,
+                          int m, int n, bool accumulate, const float* bias);
+
+} // namespace detail
+} // namespace kernels
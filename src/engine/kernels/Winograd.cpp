@@ -0,0 +1,267 @@
+#include "engine/kernels/Winograd.hpp"
+#include "engine/kernels/Sgemm.hpp"
+#include "engine/kernels/SgemmImpl.hpp"
+#include <algorithm>
+
+namespace kernels {
+
+namespace {
+
+// 一次变换的输入块数上限：变换域数据（α²·块数·C）不超过约512KB，保持在L2中
+constexpr size_t kTransformBlockBytes = 512 * 1024;
+
+// 一维变换：对 n 个通道同时计算，src[k] / dst[k] 指向第k个元素的 n 个通道值
+
+// F(2,3) 输入变换 Bᵀ（4 → 4）
+void input_1d_f2(const float* const* s, float* const* d, int n) {
+    for (int c = 0; c < n; ++c) {
+        float s0 = s[0][c], s1 = s[1][c], s2 = s[2][c], s3 = s[3][c];
+        d[0][c] = s0 - s2;
+        d[1][c] = s1 + s2;
+        d[2][c] = s2 - s1;
+        d[3][c] = s1 - s3;
+    }
+}
+
+// F(4,3) 输入变换 Bᵀ（6 → 6）
+void input_1d_f4(const float* const* s, float* const* d, int n) {
+    for (int c = 0; c < n; ++c) {
+        float s0 = s[0][c], s1 = s[1][c], s2 = s[2][c], s3 = s[3][c], s4 = s[4][c], s5 = s[5][c];
+        d[0][c] = 4.0f * s0 - 5.0f * s2 + s4;
+        d[1][c] = -4.0f * (s1 + s2) + s3 + s4;
+        d[2][c] = 4.0f * (s1 - s2) - s3 + s4;
+        d[3][c] = -2.0f * (s1 - s3) - s2 + s4;
+        d[4][c] = 2.0f * (s1 - s3) - s2 + s4;
+        d[5][c] = 4.0f * s1 - 5.0f * s3 + s5;
+    }
+}
+
+// F(2,3) 输出变换 Aᵀ（4 → 2）
+void output_1d_f2(const float* const* s, float* const* d, int n) {
+    for (int c = 0; c < n; ++c) {
+        float s0 = s[0][c], s1 = s[1][c], s2 = s[2][c], s3 = s[3][c];
+        d[0][c] = s0 + s1 + s2;
+        d[1][c] = s1 - s2 - s3;
+    }
+}
+
+// F(4,3) 输出变换 Aᵀ（6 → 4）
+void output_1d_f4(const float* const* s, float* const* d, int n) {
+    for (int c = 0; c < n; ++c) {
+        float s0 = s[0][c], s1 = s[1][c], s2 = s[2][c], s3 = s[3][c], s4 = s[4][c], s5 = s[5][c];
+        float a = s1 + s2, b = s1 - s2;
+        float p = s3 + s4, q = s3 - s4;
+        d[0][c] = s0 + a + p;
+        d[1][c] = b + 2.0f * q;
+        d[2][c] = a + 4.0f * p;
+        d[3][c] = b + 8.0f * q + s5;
+    }
+}
+
+// 滤波器一维变换 G（3 → α）
+void filter_1d(const float* g, int stride, int m, float* u, int ustride) {
+    float g0 = g[0], g1 = g[stride], g2 = g[2 * stride];
+    if (m == 2) {
+        u[0] = g0;
+        u[ustride] = 0.5f * (g0 + g1 + g2);
+        u[2 * ustride] = 0.5f * (g0 - g1 + g2);
+        u[3 * ustride] = g2;
+    } else {
+        u[0] = 0.25f * g0;
+        u[ustride] = -(g0 + g1 + g2) / 6.0f;
+        u[2 * ustride] = -(g0 - g1 + g2) / 6.0f;
+        u[3 * ustride] = g0 / 24.0f + g1 / 12.0f + g2 / 6.0f;
+        u[4 * ustride] = g0 / 24.0f - g1 / 12.0f + g2 / 6.0f;
+        u[5 * ustride] = g2;
+    }
+}
+
+using Transform1d = void (*)(const float* const*, float* const*, int);
+
+// 二维变换 Y = T·X·Tᵀ：X 为 rows_in×rows_in 个通道向量（行优先），
+// 先对每列做一维变换，再对每行做一维变换，Y 为 rows_out×rows_out 个通道向量
+void transform_2d(Transform1d fn, int rows_in, int rows_out, const float* x, float* tmp, float* y, int n) {
+    const float* src[6];
+    float* dst[6];
+
+    // 列变换：tmp[rows_out][rows_in]
+    for (int j = 0; j < rows_in; ++j) {
+        for (int k = 0; k < rows_in; ++k) src[k] = x + (k * rows_in + j) * n;
+        for (int k = 0; k < rows_out; ++k) dst[k] = tmp + (k * rows_in + j) * n;
+        fn(src, dst, n);
+    }
+    // 行变换：y[rows_out][rows_out]
+    for (int i = 0; i < rows_out; ++i) {
+        for (int k = 0; k < rows_in; ++k) src[k] = tmp + (i * rows_in + k) * n;
+        for (int k = 0; k < rows_out; ++k) dst[k] = y + (i * rows_out + k) * n;
+        fn(src, dst, n);
+    }
+}
+
+} // namespace
+
+void winograd_transform_filter(const float* weight, int OC, int C, int m, float* out) {
+    const int alpha = winograd_alpha(m);
+    float tmp[6 * 3];
+    float u[6 * 6];
+
+    for (int oc = 0; oc < OC; ++oc) {
+        for (int c = 0; c < C; ++c) {
+            const float* g = weight + (static_cast<size_t>(oc) * C + c) * 9;
+            // tmp = G·g（α×3），u = tmp·Gᵀ（α×α）
+            for (int j = 0; j < 3; ++j) filter_1d(g + j, 3, m, tmp + j, 3);
+            for (int i = 0; i < alpha; ++i) filter_1d(tmp + i * 3, 1, m, u + i * alpha, 1);
+
+            for (int xi = 0; xi < alpha * alpha; ++xi) {
+                out[(static_cast<size_t>(xi) * C + c) * OC + oc] = u[xi];
+            }
+        }
+    }
+}
+
+void pack_winograd_weights(const float* transformed, int C, int OC, int m, WinogradWeights& out) {
+    const int alpha = winograd_alpha(m);
+    out.tile = m;
+    out.in_channels = C;
+    out.out_channels = OC;
+    out.isa = best_isa();
+
+    const int nr = sgemm_panel_width(out.isa);
+    const size_t panelSize = static_cast<size_t>(C) * ((OC + nr - 1) / nr) * nr;
+    out.panels.assign(panelSize * alpha * alpha, 0.0f);
+    for (int xi = 0; xi < alpha * alpha; ++xi) {
+        pack_matrix_b(transformed + static_cast<size_t>(xi) * C * OC, C, OC, OC, nr,
+                      out.panels.data() + xi * panelSize);
+    }
+}
+
+void conv3x3_winograd(const float* const* inputs, int batch, int C, int H, int W,
+                      const WinogradWeights& weights, const float* bias,
+                      float* const* outputs) {
+    const int m = weights.tile;
+    const int alpha = winograd_alpha(m);
+    const int alpha2 = alpha * alpha;
+    const int OC = weights.out_channels;
+    const int tilesY = (H + m - 1) / m;
+    const int tilesX = (W + m - 1) / m;
+    const int tilesPerImage = tilesY * tilesX;
+    const int totalTiles = batch * tilesPerImage;
+    const size_t plane = static_cast<size_t>(H) * W;
+
+    const Transform1d inputFn = m == 2 ? input_1d_f2 : input_1d_f4;
+    const Transform1d outputFn = m == 2 ? output_1d_f2 : output_1d_f4;
+    const int nr = sgemm_panel_width(weights.isa);
+    const size_t panelSize = static_cast<size_t>(C) * ((OC + nr - 1) / nr) * nr;
+
+    const size_t bytesPerTile = static_cast<size_t>(alpha2) * std::max(C, OC) * sizeof(float);
+    const int chunk = static_cast<int>(std::max<size_t>(1, kTransformBlockBytes / bytesPerTile));
+
+    // 变换域数据按线程复用：
+    // Vᵀ[ξ] 为 块×C 矩阵，输入变换直接写成SGEMM的A面板格式；Mᵀ[α²][块][OC] 为行优先
+    constexpr int MR = detail::kGemmMR;
+    thread_local std::vector<PackedMatrix> vt;
+    thread_local std::vector<float> mt;
+    thread_local std::vector<float> patch;
+    thread_local std::vector<float> tmp;
+    thread_local std::vector<float> tile;
+
+    vt.resize(alpha2);
+    patch.resize(static_cast<size_t>(alpha2) * std::max(C, OC));
+    tmp.resize(static_cast<size_t>(alpha2) * std::max(C, OC));
+    tile.resize(static_cast<size_t>(alpha2) * std::max(C, OC));
+
+    for (int t0 = 0; t0 < totalTiles; t0 += chunk) {
+        const int count = std::min(chunk, totalTiles - t0);
+        const size_t packedSize = static_cast<size_t>((count + MR - 1) / MR) * C * MR;
+        for (PackedMatrix& v : vt) {
+            v.rows = count;
+            v.depth = C;
+            v.data.resize(packedSize);
+        }
+        mt.resize(static_cast<size_t>(alpha2) * count * OC);
+
+        // 1. 输入块变换：d[α][α][C] -> V[α][α][C]
+        for (int t = 0; t < count; ++t) {
+            const int g = t0 + t;
+            const int b = g / tilesPerImage;
+            const int ty = (g % tilesPerImage) / tilesX;
+            const int tx = g % tilesX;
+            const int y0 = ty * m - 1;
+            const int x0 = tx * m - 1;
+            const float* in = inputs[b];
+
+            // 取出 α×α 输入块（越界补0），通道为最内层
+            const bool interior = y0 >= 0 && x0 >= 0 && y0 + alpha <= H && x0 + alpha <= W;
+            for (int c = 0; c < C; ++c) {
+                const float* src = in + c * plane;
+                float* dst = patch.data() + c;
+                if (interior) {
+                    for (int i = 0; i < alpha; ++i) {
+                        const float* row = src + (y0 + i) * W + x0;
+                        for (int j = 0; j < alpha; ++j) {
+                            dst[(i * alpha + j) * C] = row[j];
+                        }
+                    }
+                    continue;
+                }
+                for (int i = 0; i < alpha; ++i) {
+                    const int y = y0 + i;
+                    for (int j = 0; j < alpha; ++j) {
+                        const int x = x0 + j;
+                        dst[(i * alpha + j) * C] =
+                            (y >= 0 && y < H && x >= 0 && x < W) ? src[y * W + x] : 0.0f;
+                    }
+                }
+            }
+
+            transform_2d(inputFn, alpha, alpha, patch.data(), tmp.data(), tile.data(), C);
+
+            // 写入A面板：第 t 行位于面板 t/MR 的第 t%MR 列
+            const size_t offset = static_cast<size_t>(t / MR) * C * MR + t % MR;
+            for (int xi = 0; xi < alpha2; ++xi) {
+                const float* v = tile.data() + xi * C;
+                float* dst = vt[xi].data.data() + offset;
+                for (int c = 0; c < C; ++c) {
+                    dst[c * MR] = v[c];
+                }
+            }
+        }
+
+        // 2. 变换域逐元素乘加：Mᵀ[ξ] (块×OC) = Vᵀ[ξ] (块×C) · Uᵀ[ξ] (C×OC)
+        for (int xi = 0; xi < alpha2; ++xi) {
+            sgemm_prepacked(vt[xi], weights.panels.data() + xi * panelSize, OC, nullptr,
+                            mt.data() + static_cast<size_t>(xi) * count * OC, OC, weights.isa);
+        }
+
+        // 3. 输出块变换：M[α][α][OC] -> Y[m][m][OC]，加偏置后写回 CHW
+        for (int t = 0; t < count; ++t) {
+            const int g = t0 + t;
+            const int b = g / tilesPerImage;
+            const int ty = (g % tilesPerImage) / tilesX;
+            const int tx = g % tilesX;
+
+            for (int xi = 0; xi < alpha2; ++xi) {
+                const float* src = mt.data() + (static_cast<size_t>(xi) * count + t) * OC;
+                std::copy(src, src + OC, patch.data() + xi * OC);
+            }
+            transform_2d(outputFn, alpha, m, patch.data(), tmp.data(), tile.data(), OC);
+
+            // 右/下边缘的块可能只有部分在输出范围内
+            const int rows = std::min(m, H - ty * m);
+            const int cols = std::min(m, W - tx * m);
+            float* out = outputs[b] + ty * m * W + tx * m;
+            for (int oc = 0; oc < OC; ++oc) {
+                const float bv = bias ? bias[oc] : 0.0f;
+                const float* v = tile.data() + oc;
+                float* dst = out + oc * plane;
+                for (int i = 0; i < rows; ++i) {
+                    for (int j = 0; j < cols; ++j) {
+                        dst[i * W + j] = v[(i * m + j) * OC] + bv;
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace kernels
@@ -0,0 +1,40 @@
+#pragma once
+#include "engine/kernels/Isa.hpp"
+#include <vector>
+
+// Winograd F(m×m, 3×3) 卷积（stride 1、padding 1），m = 2 或 4
+// 每个 α×α（α = m + 2）输入块变换为 V = Bᵀ·d·B，滤波器变换为 U = G·g·Gᵀ，
+// 变换域中的逐元素乘加按 α² 组矩阵乘完成，再用 Aᵀ·M·A 得到 m×m 输出块。
+// F(2,3) 乘法次数为直接卷积的 1/2.25，F(4,3) 为 1/4。
+// 输入/输出块变换以通道为最内层维度，对通道向量化。
+namespace kernels {
+
+// 输出块大小 m 对应的输入块大小 α
+inline int winograd_alpha(int m) { return m + 2; }
+
+// 是否支持该输出块大小
+inline bool winograd_supported(int m) { return m == 2 || m == 4; }
+
+// 滤波器变换：weight 为 [OC][C][3][3]，out 为 [α²][C][OC]（需容纳 α²·C·OC 个float）
+void winograd_transform_filter(const float* weight, int OC, int C, int m, float* out);
+
+// 打包后的变换域权重（α² 组 C×OC 矩阵，按SGEMM的B面板格式打包）
+struct WinogradWeights {
+    int tile = 0;
+    int in_channels = 0;
+    int out_channels = 0;
+    Isa isa = Isa::Scalar;            // 打包时使用的指令集（决定面板宽度）
+    std::vector<float> panels;
+
+    bool empty() const { return panels.empty(); }
+};
+
+// transformed 为 winograd_transform_filter 的结果
+void pack_winograd_weights(const float* transformed, int C, int OC, int m, WinogradWeights& out);
+
+// 对 batch 张 C×H×W 输入做 3×3 s1 p1 卷积，outputs[b] 需容纳 OC×H×W 个float；bias 可为 nullptr
+void conv3x3_winograd(const float* const* inputs, int batch, int C, int H, int W,
+                      const WinogradWeights& weights, const float* bias,
+                      float* const* outputs);
+
+} // namespace kernels
@@ -0,0 +1,203 @@
+// 根据模型元数据生成 StaticNetwork 使用的编译期层形状头文件（CMake 选项 BCNN_STATIC_NETWORK）
+// 用法: bcnn_static_shapes <model.bcnn|model.json> <输出头文件>
+// 输入为单文件容器时读取其中的 JSON 元数据，为旧版 model.json 时直接读取。
+// 只接受 BadgeCNN 形式的结构：若干个 Conv 3×3 s1 p1 (+BN) +ReLU -> MaxPool 2×2 块，
+// 之后是全局平均池化和一个全连接层；卷积输出通道数须为16的倍数（AVX-512 的通道块大小）。
+#include "loader/ModelContainer.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace {
+
+struct Block {
+    std::string name;
+    int in_channels = 0;
+    int out_channels = 0;
+};
+
+int int_or(const json& layer, const char* key, int fallback) {
+    return layer.contains(key) && layer[key].is_number_integer() ? layer[key].get<int>() : fallback;
+}
+
+bool fail(const std::string& message) {
+    std::cerr << "bcnn_static_shapes: " << message << std::endl;
+    return false;
+}
+
+bool parse_structure(const json& structure, std::vector<Block>& blocks, std::string& classifier,
+                     int& num_classes) {
+    size_t i = 0;
+    while (i < structure.size() && structure[i].value("type", "") == "conv2d") {
+        const json& conv = structure[i];
+        Block block;
+        block.name = conv.value("name", "");
+        block.in_channels = int_or(conv, "in_channels", 0);
+        block.out_channels = int_or(conv, "out_channels", 0);
+        if (int_or(conv, "kernel_size", 3) != 3 || int_or(conv, "stride", 1) != 1 ||
+            int_or(conv, "padding", 0) != 1 || conv.value("activation", "") != "relu") {
+            return fail("仅支持 Conv 3×3 s1 p1 + ReLU: " + block.name);
+        }
+        if (block.out_channels <= 0 || block.out_channels % 16 != 0) {
+            return fail("卷积输出通道数须为16的倍数: " + block.name);
+        }
+        if (!blocks.empty() && block.in_channels != blocks.back().out_channels) {
+            return fail("通道数不连续: " + block.name);
+        }
+        ++i;
+
+        if (i < structure.size() && structure[i].value("type", "") == "batchnorm2d") {
+            ++i;
+        }
+        if (i >= structure.size() || structure[i].value("type", "") != "maxpool2d" ||
+            int_or(structure[i], "kernel_size", 2) != 2 ||
+            int_or(structure[i], "stride", 2) != 2) {
+            return fail("卷积块须以 MaxPool 2×2 s2 结尾: " + block.name);
+        }
+        ++i;
+        blocks.push_back(block);
+    }
+
+    if (blocks.empty()) {
+        return fail("结构中没有卷积块");
+    }
+    if (i >= structure.size() || structure[i].value("type", "") != "adaptive_avg_pool2d" ||
+        int_or(structure[i], "output_size", 1) != 1) {
+        return fail("卷积块之后须为全局平均池化");
+    }
+    ++i;
+    if (i + 1 != structure.size() || structure[i].value("type", "") != "linear") {
+        return fail("全局平均池化之后须为唯一的全连接层");
+    }
+    const json& fc = structure[i];
+    if (int_or(fc, "in_features", 0) != blocks.back().out_channels) {
+        return fail("全连接输入维度与最后一个卷积块不符");
+    }
+    classifier = fc.value("name", "");
+    num_classes = int_or(fc, "out_features", 0);
+    return num_classes > 0 || fail("全连接输出维度无效");
+}
+
+// 读取模型元数据：model.bcnn 取文件头指向的 JSON 段，其余按 model.json 解析
+bool read_metadata(const char* path, json& model) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return fail(std::string("无法打开 ") + path);
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    container::ContainerHeader header{};
+    if (text.size() >= sizeof(header) && std::memcmp(text.data(), container::kMagic, sizeof(container::kMagic)) == 0) {
+        std::memcpy(&header, text.data(), sizeof(header));
+        if (header.version != container::kVersion || header.metadata_offset > text.size() ||
+            header.metadata_size > text.size() - header.metadata_offset) {
+            return fail(std::string("模型容器文件头无效: ") + path);
+        }
+        text = text.substr(header.metadata_offset, header.metadata_size);
+    }
+
+    try {
+        model = json::parse(text);
+    } catch (const std::exception& e) {
+        return fail(std::string("JSON解析错误: ") + e.what());
+    }
+    return true;
+}
+
+std::string int_list(const std::vector<int>& values) {
+    std::ostringstream os;
+    for (size_t i = 0; i < values.size(); ++i) {
+        os << (i ? ", " : "") << values[i];
+    }
+    return os.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "用法: bcnn_static_shapes <model.bcnn|model.json> <输出头文件>" << std::endl;
+        return 1;
+    }
+
+    json model;
+    if (!read_metadata(argv[1], model)) {
+        return 1;
+    }
+
+    std::vector<int> input;
+    if (model.contains("model_info") && model["model_info"].contains("input_size")) {
+        input = model["model_info"]["input_size"].get<std::vector<int>>();
+    }
+    if (input.size() != 3) {
+        fail("model_info.input_size 须为 [C, H, W]");
+        return 1;
+    }
+
+    std::vector<Block> blocks;
+    std::string classifier;
+    int num_classes = 0;
+    if (!model.contains("structure") || !parse_structure(model["structure"], blocks, classifier, num_classes)) {
+        return 1;
+    }
+    if (blocks.front().in_channels != input[0]) {
+        fail("第一个卷积的输入通道数与 input_size 不符");
+        return 1;
+    }
+
+    // 各块输入的通道数和空间尺寸（最后一项为最后一个块的输出）
+    std::vector<int> channels = {input[0]};
+    std::vector<int> heights = {input[1]};
+    std::vector<int> widths = {input[2]};
+    for (const Block& block : blocks) {
+        if (heights.back() < 2 || widths.back() < 2) {
+            fail("输入尺寸不足以完成全部池化: " + block.name);
+            return 1;
+        }
+        channels.push_back(block.out_channels);
+        heights.push_back(heights.back() / 2);
+        widths.push_back(widths.back() / 2);
+    }
+
+    std::ostringstream out;
+    out << "#pragma once\n"
+        << "// 由 bcnn_static_shapes 根据 " << model["model_info"].value("description", "model.json")
+        << " 的模型元数据生成，请勿手动修改\n\n"
+        << "namespace static_net {\n\n"
+        << "constexpr int kNumBlocks = " << blocks.size() << ";\n"
+        << "constexpr int kNumClasses = " << num_classes << ";\n\n"
+        << "// 第 i 个卷积块的输入为 kChannels[i] × kHeights[i] × kWidths[i]，输出为第 i+1 项\n"
+        << "constexpr int kChannels[kNumBlocks + 1] = {" << int_list(channels) << "};\n"
+        << "constexpr int kHeights[kNumBlocks + 1] = {" << int_list(heights) << "};\n"
+        << "constexpr int kWidths[kNumBlocks + 1] = {" << int_list(widths) << "};\n\n"
+        << "constexpr const char* kConvNames[kNumBlocks] = {";
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        out << (i ? ", " : "") << '"' << blocks[i].name << '"';
+    }
+    out << "};\n"
+        << "constexpr const char* kClassifierName = \"" << classifier << "\";\n\n"
+        << "} // namespace static_net\n";
+
+    // 内容未变时不改写，避免触发重新编译
+    std::ifstream existing(argv[2]);
+    std::stringstream previous;
+    previous << existing.rdbuf();
+    if (existing && previous.str() == out.str()) {
+        return 0;
+    }
+    std::ofstream file(argv[2]);
+    if (!(file << out.str())) {
+        fail(std::string("无法写入 ") + argv[2]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include "engine/static/StaticNetwork.hpp"
+#include "engine/kernels/ConvBlock.hpp"
+#include "engine/kernels/Layout.hpp"
+#include "engine/static/StaticNetworkImpl.hpp"
+#include <iostream>
+
+namespace {
+
+using namespace static_net;
+
+constexpr int max_activation() {
+    int size = 0;
+    for (int i = 0; i <= kNumBlocks; ++i) {
+        const int s = kChannels[i] * kHeights[i] * kWidths[i];
+        if (s > size) size = s;
+    }
+    return size;
+}
+
+// 没有可用SIMD实现时的平面布局前向：形状仍为编译期常量，逐块调用通用融合内核
+void forward_generic(const detail::Weights& weights, const float* input, float* logits) {
+    alignas(64) float buffers[2][max_activation()];
+    const float* in = input;
+    for (int b = 0; b < kNumBlocks; ++b) {
+        float* out = buffers[b % 2];
+        kernels::conv3x3_bn_relu_pool2(in, kChannels[b], kHeights[b], kWidths[b], weights.conv[b],
+                                       weights.scale[b], weights.shift[b], kChannels[b + 1], out);
+        in = out;
+    }
+
+    constexpr int C = kChannels[kNumBlocks];
+    constexpr int plane = kHeights[kNumBlocks] * kWidths[kNumBlocks];
+    float mean[C];
+    for (int c = 0; c < C; ++c) {
+        float sum = 0.0f;
+        for (int i = 0; i < plane; ++i) sum += in[c * plane + i];
+        mean[c] = sum / plane;
+    }
+    for (int o = 0; o < kNumClasses; ++o) {
+        const float* w = weights.fc_weight + o * C;
+        float acc = weights.fc_bias ? weights.fc_bias[o] : 0.0f;
+        for (int c = 0; c < C; ++c) acc += w[c] * mean[c];
+        logits[o] = acc;
+    }
+}
+
+} // namespace
+
+bool StaticNetwork::load(const InferenceEngine& engine) {
+    ready = false;
+    if (!engine.is_ready()) {
+        return false;
+    }
+
+    const std::vector<int>& input = engine.get_input_shape();
+    if (input.size() != 3 || input[0] != kInputChannels || input[1] != kInputHeight ||
+        input[2] != kInputWidth) {
+        std::cerr << "StaticNetwork: 模型输入尺寸与生成的形状不符" << std::endl;
+        return false;
+    }
+
+    std::vector<InferenceEngine::BlockParams> blocks = engine.get_fused_blocks();
+    InferenceEngine::LinearParams fc;
+    if (static_cast<int>(blocks.size()) != kNumBlocks || !engine.get_classifier(fc) ||
+        fc.in_features != kChannels[kNumBlocks] || fc.out_features != kNumClasses) {
+        std::cerr << "StaticNetwork: 模型结构与生成的形状不符（需重新构建以更新 StaticShapes.hpp）"
+                  << std::endl;
+        return false;
+    }
+    for (int b = 0; b < kNumBlocks; ++b) {
+        if (blocks[b].in_channels != kChannels[b] || blocks[b].out_channels != kChannels[b + 1]) {
+            std::cerr << "StaticNetwork: 卷积块 " << blocks[b].name << " 的通道数与生成的形状不符"
+                      << std::endl;
+            return false;
+        }
+    }
+
+    block = kernels::channel_block(kernels::best_isa());
+    for (int b = 0; b < kNumBlocks; ++b) {
+        const InferenceEngine::BlockParams& p = blocks[b];
+        const size_t count = static_cast<size_t>(p.out_channels) * p.in_channels * 9;
+        if (block > 0) {
+            kernels::pack_conv3x3_weights_nchwc(p.weight, p.out_channels, p.in_channels, block,
+                                                conv_weight[b]);
+        } else {
+            conv_weight[b].assign(p.weight, p.weight + count);
+        }
+        scale[b].assign(p.scale, p.scale + p.out_channels);
+        shift[b].assign(p.shift, p.shift + p.out_channels);
+    }
+    fc_weight.assign(fc.weight, fc.weight + static_cast<size_t>(fc.out_features) * fc.in_features);
+    if (fc.bias) {
+        fc_bias.assign(fc.bias, fc.bias + fc.out_features);
+    } else {
+        fc_bias.clear();
+    }
+
+    ready = true;
+    return true;
+}
+
+bool StaticNetwork::forward(const float* input, float* logits) const {
+    if (!ready || !input || !logits) {
+        return false;
+    }
+
+    detail::Weights weights;
+    for (int b = 0; b < kNumBlocks; ++b) {
+        weights.conv[b] = conv_weight[b].data();
+        weights.scale[b] = scale[b].data();
+        weights.shift[b] = shift[b].data();
+    }
+    weights.fc_weight = fc_weight.data();
+    weights.fc_bias = fc_bias.empty() ? nullptr : fc_bias.data();
+
+#if defined(BCNN_X86_KERNELS)
+    switch (block) {
+        case 16: detail::forward_avx512(weights, input, logits); return true;
+        case 8: detail::forward_avx2(weights, input, logits); return true;
+        default: break;
+    }
+#endif
+    forward_generic(weights, input, logits);
+    return true;
+}
+
+const char* StaticNetwork::kernel_name() const {
+    switch (block) {
+        case 16: return "avx512";
+        case 8: return "avx2";
+        default: return "generic";
+    }
+}
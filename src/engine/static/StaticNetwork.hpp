@@ -0,0 +1,36 @@
+#pragma once
+#include <vector>
+#include "engine/static/StaticShapes.hpp"
+#include "engine/InferenceEngine.hpp"
+
+// 编译期特化的 BadgeCNN 单图前向（CMake 选项 BCNN_STATIC_NETWORK）
+// 层形状由 bcnn_static_shapes 在构建时根据 model.json 生成为 constexpr 常量（StaticShapes.hpp），
+// 卷积循环边界、步长和各层激活值大小在编译期确定，激活值放在栈上，不做运行时形状检查和内存规划。
+// 参数从构建好的 InferenceEngine 复制（融合卷积块的BN已并入逐通道仿射），加载后与引擎和 ModelLoader 无关。
+// 只支持生成时的网络结构；load 时发现模型与生成的形状不符会返回 false，调用方应回退到 InferenceEngine。
+class StaticNetwork {
+public:
+    static constexpr int kInputChannels = static_net::kChannels[0];
+    static constexpr int kInputHeight = static_net::kHeights[0];
+    static constexpr int kInputWidth = static_net::kWidths[0];
+    static constexpr int kInputSize = kInputChannels * kInputHeight * kInputWidth;
+    static constexpr int kNumClasses = static_net::kNumClasses;
+
+    bool load(const InferenceEngine& engine);
+    bool is_ready() const { return ready; }
+
+    // input 为 kInputChannels×kInputHeight×kInputWidth（NCHW），logits 需容纳 kNumClasses 个float
+    bool forward(const float* input, float* logits) const;
+
+    // 前向使用的实现："avx512" / "avx2" / "generic"
+    const char* kernel_name() const;
+
+private:
+    bool ready = false;
+    int block = 0;                                     // 通道块大小，0 为平面布局（通用实现）
+    std::vector<float> conv_weight[static_net::kNumBlocks];
+    std::vector<float> scale[static_net::kNumBlocks];
+    std::vector<float> shift[static_net::kNumBlocks];
+    std::vector<float> fc_weight;
+    std::vector<float> fc_bias;
+};
@@ -0,0 +1,143 @@
+// AVX-512F 实现：NCHW16c 布局，每次计算16个输出通道 × 2行 × 8像素并在寄存器中完成BN、ReLU和池化。
+// 所有形状都是模板参数，步长和循环边界在编译期确定，各层激活值按常量大小分配在栈上。
+#include "engine/static/StaticNetworkImpl.hpp"
+#include <immintrin.h>
+
+namespace static_net {
+namespace detail {
+namespace {
+
+constexpr int kBlock = 16;
+
+// CBI 为输入的通道块大小：第一个块直接读取 NCHW 输入（CBI = 1），之后为 kBlock
+template <int C, int CBI, int H, int W, int TW, bool Left, bool Right>
+inline void tile(const float* in, const float* weight, __m512 s, __m512 t, int y0, int x0, float* out) {
+    constexpr long plane = static_cast<long>(H) * W * CBI;
+    constexpr int PW = W / 2;
+    __m512 acc0[TW], acc1[TW];
+    #pragma GCC unroll 16
+    for (int j = 0; j < TW; ++j) {
+        acc0[j] = _mm512_setzero_ps();
+        acc1[j] = _mm512_setzero_ps();
+    }
+
+    for (int ic = 0; ic < C; ++ic) {
+        const float* src = in + (ic / CBI) * plane + ic % CBI;
+        const float* k = weight + ic * 9 * kBlock;
+        // 两行卷积共用输入行 y0-1 .. y0+2；第 r 行对 acc0 是抽头行 r，对 acc1 是抽头行 r-1
+        #pragma GCC unroll 4
+        for (int r = 0; r < 4; ++r) {
+            const int iy = y0 + r - 1;
+            if (iy < 0 || iy >= H) continue;
+            const float* row = src + (iy * W + x0) * CBI;
+
+            #pragma GCC unroll 3
+            for (int kx = 0; kx < 3; ++kx) {
+                const __m512 w0 = r < 3 ? _mm512_loadu_ps(k + (r * 3 + kx) * kBlock) : _mm512_setzero_ps();
+                const __m512 w1 = r > 0 ? _mm512_loadu_ps(k + ((r - 1) * 3 + kx) * kBlock) : _mm512_setzero_ps();
+                #pragma GCC unroll 16
+                for (int j = 0; j < TW; ++j) {
+                    const int dx = j + kx - 1;
+                    if (Left && dx < 0) continue;
+                    if (Right && dx >= TW) continue;
+                    const __m512 v = _mm512_set1_ps(row[dx * CBI]);
+                    if (r < 3) acc0[j] = _mm512_fmadd_ps(v, w0, acc0[j]);
+                    if (r > 0) acc1[j] = _mm512_fmadd_ps(v, w1, acc1[j]);
+                }
+            }
+        }
+    }
+
+    // scale 可能为负，先做BN仿射再取最大值
+    const __m512 zero = _mm512_setzero_ps();
+    #pragma GCC unroll 8
+    for (int j = 0; j < TW; j += 2) {
+        __m512 v = _mm512_max_ps(_mm512_fmadd_ps(acc0[j], s, t), _mm512_fmadd_ps(acc0[j + 1], s, t));
+        v = _mm512_max_ps(v, _mm512_max_ps(_mm512_fmadd_ps(acc1[j], s, t), _mm512_fmadd_ps(acc1[j + 1], s, t)));
+        _mm512_storeu_ps(out + ((y0 / 2) * PW + (x0 + j) / 2) * kBlock, _mm512_max_ps(v, zero));
+    }
+}
+
+template <int C, int CBI, int H, int W, int TW>
+inline void segment(const float* in, const float* weight, __m512 s, __m512 t, int y0, int x0, float* out) {
+    const bool left = x0 == 0;
+    const bool right = x0 + TW >= W;
+    if (left && right) {
+        tile<C, CBI, H, W, TW, true, true>(in, weight, s, t, y0, x0, out);
+    } else if (left) {
+        tile<C, CBI, H, W, TW, true, false>(in, weight, s, t, y0, x0, out);
+    } else if (right) {
+        tile<C, CBI, H, W, TW, false, true>(in, weight, s, t, y0, x0, out);
+    } else {
+        tile<C, CBI, H, W, TW, false, false>(in, weight, s, t, y0, x0, out);
+    }
+}
+
+// Conv 3×3 s1 p1 -> BN -> ReLU -> MaxPool 2×2，输出 OC/kBlock 组 [H/2][W/2][kBlock]
+template <int C, int CBI, int H, int W, int OC>
+void conv_block(const float* in, const float* weight, const float* scale, const float* shift, float* out) {
+    static_assert(OC % kBlock == 0, "输出通道数须为通道块大小的倍数");
+    constexpr int PH = H / 2;
+    constexpr int PW = W / 2;
+    // 只计算池化用到的 2·PW 列：先按 8 列一段，余下的按2列一段
+    constexpr int wide = 2 * PW / 8 * 8;
+    for (int ocb = 0; ocb < OC / kBlock; ++ocb) {
+        const float* k = weight + ocb * C * 9 * kBlock;
+        const __m512 s = _mm512_loadu_ps(scale + ocb * kBlock);
+        const __m512 t = _mm512_loadu_ps(shift + ocb * kBlock);
+        float* dst = out + ocb * PH * PW * kBlock;
+        for (int py = 0; py < PH; ++py) {
+            int x0 = 0;
+            for (; x0 < wide; x0 += 8) {
+                segment<C, CBI, H, W, 8>(in, k, s, t, 2 * py, x0, dst);
+            }
+            for (; x0 < 2 * PW; x0 += 2) {
+                segment<C, CBI, H, W, 2>(in, k, s, t, 2 * py, x0, dst);
+            }
+        }
+    }
+}
+
+// 全局平均池化（直接读取 NCHWc）+ 全连接
+template <int C, int H, int W>
+void gap_linear(const float* in, const Weights& weights, float* logits) {
+    alignas(64) float mean[C];
+    const __m512 inv = _mm512_set1_ps(1.0f / (H * W));
+    for (int cb = 0; cb < C / kBlock; ++cb) {
+        const float* src = in + cb * H * W * kBlock;
+        __m512 sum = _mm512_setzero_ps();
+        for (int i = 0; i < H * W; ++i) {
+            sum = _mm512_add_ps(sum, _mm512_loadu_ps(src + i * kBlock));
+        }
+        _mm512_storeu_ps(mean + cb * kBlock, _mm512_mul_ps(sum, inv));
+    }
+    for (int o = 0; o < kNumClasses; ++o) {
+        const float* w = weights.fc_weight + o * C;
+        float acc = weights.fc_bias ? weights.fc_bias[o] : 0.0f;
+        for (int c = 0; c < C; ++c) acc += w[c] * mean[c];
+        logits[o] = acc;
+    }
+}
+
+template <int B>
+void run_blocks(const Weights& weights, const float* in, float* logits) {
+    constexpr int C = kChannels[B];
+    constexpr int OC = kChannels[B + 1];
+    alignas(64) float out[OC * kHeights[B + 1] * kWidths[B + 1]];
+    conv_block<C, B == 0 ? 1 : kBlock, kHeights[B], kWidths[B], OC>(
+        in, weights.conv[B], weights.scale[B], weights.shift[B], out);
+    if constexpr (B + 1 < kNumBlocks) {
+        run_blocks<B + 1>(weights, out, logits);
+    } else {
+        gap_linear<OC, kHeights[B + 1], kWidths[B + 1]>(out, weights, logits);
+    }
+}
+
+} // namespace
+
+void forward_avx512(const Weights& weights, const float* input, float* logits) {
+    run_blocks<0>(weights, input, logits);
+}
+
+} // namespace detail
+} // namespace static_net
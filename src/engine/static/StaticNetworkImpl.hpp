@@ -0,0 +1,22 @@
+#pragma once
+// StaticNetwork 各指令集实现的内部声明。与 kernels/Conv3x3Impl.hpp 相同，
+// 各实现的翻译单元只包含 <immintrin.h> 和本头文件，不实例化标准库模板。
+#include "engine/static/StaticShapes.hpp"
+
+namespace static_net {
+namespace detail {
+
+struct Weights {
+    const float* conv[kNumBlocks];      // [OC/cb][C][3][3][cb]
+    const float* scale[kNumBlocks];     // 并入BN后的逐通道仿射
+    const float* shift[kNumBlocks];
+    const float* fc_weight;             // [kNumClasses][kChannels[kNumBlocks]]
+    const float* fc_bias;
+};
+
+// input 为 NCHW 的网络输入；中间激活值为 NCHWc（cb：AVX2 为8，AVX-512 为16）
+void forward_avx2(const Weights& weights, const float* input, float* logits);
+void forward_avx512(const Weights& weights, const float* input, float* logits);
+
+} // namespace detail
+} // namespace static_net
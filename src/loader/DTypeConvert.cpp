@@ -0,0 +1,141 @@
+#include "loader/DTypeConvert.hpp"
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define DTYPE_X86_SIMD 1
+#endif
+
+namespace dtype {
+
+float fp16_to_fp32(uint16_t h) {
+    uint32_t sign = static_cast<uint32_t>(h & 0x8000) << 16;
+    uint32_t exponent = (h >> 10) & 0x1f;
+    uint32_t mantissa = h & 0x3ff;
+    uint32_t bits;
+
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        } else {
+            // 非规格化数：规格化后再转换
+            exponent = 127 - 15 + 1;
+            while ((mantissa & 0x400) == 0) {
+                mantissa <<= 1;
+                --exponent;
+            }
+            mantissa &= 0x3ff;
+            bits = sign | (exponent << 23) | (mantissa << 13);
+        }
+    } else if (exponent == 0x1f) {
+        bits = sign | 0x7f800000 | (mantissa << 13);  // Inf / NaN
+    } else {
+        bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+float bf16_to_fp32(uint16_t b) {
+    uint32_t bits = static_cast<uint32_t>(b) << 16;
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+#ifdef DTYPE_X86_SIMD
+
+namespace {
+
+__attribute__((target("avx,f16c")))
+void fp16_to_fp32_f16c(const uint16_t* src, float* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+    }
+    for (; i < count; ++i) {
+        dst[i] = fp16_to_fp32(src[i]);
+    }
+}
+
+__attribute__((target("avx2")))
+void bf16_to_fp32_avx2(const uint16_t* src, float* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m256i bits = _mm256_slli_epi32(_mm256_cvtepu16_epi32(b), 16);
+        _mm256_storeu_ps(dst + i, _mm256_castsi256_ps(bits));
+    }
+    for (; i < count; ++i) {
+        dst[i] = bf16_to_fp32(src[i]);
+    }
+}
+
+__attribute__((target("avx2")))
+void int8_to_fp32_avx2(const int8_t* src, float scale, float* dst, size_t count) {
+    __m256 s = _mm256_set1_ps(scale);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i q = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+        __m256 f = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(q));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(f, s));
+    }
+    for (; i < count; ++i) {
+        dst[i] = src[i] * scale;
+    }
+}
+
+bool has_f16c() {
+    static const bool supported = __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+    return supported;
+}
+
+bool has_avx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+} // namespace
+
+#endif
+
+void fp16_to_fp32(const uint16_t* src, float* dst, size_t count) {
+#ifdef DTYPE_X86_SIMD
+    if (has_f16c()) {
+        fp16_to_fp32_f16c(src, dst, count);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = fp16_to_fp32(src[i]);
+    }
+}
+
+void bf16_to_fp32(const uint16_t* src, float* dst, size_t count) {
+#ifdef DTYPE_X86_SIMD
+    if (has_avx2()) {
+        bf16_to_fp32_avx2(src, dst, count);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = bf16_to_fp32(src[i]);
+    }
+}
+
+void int8_to_fp32(const int8_t* src, float scale, float* dst, size_t count) {
+#ifdef DTYPE_X86_SIMD
+    if (has_avx2()) {
+        int8_to_fp32_avx2(src, scale, dst, count);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = src[i] * scale;
+    }
+}
+
+} // namespace dtype
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// 低精度权重到 float32 的转换
+// x86 上运行时检测 F16C / AVX2，不支持时退回标量实现。
+namespace dtype {
+
+// IEEE 754 半精度 -> float32
+void fp16_to_fp32(const uint16_t* src, float* dst, size_t count);
+
+// bfloat16 -> float32
+void bf16_to_fp32(const uint16_t* src, float* dst, size_t count);
+
+// 对称量化 int8 -> float32（dst[i] = src[i] * scale）
+void int8_to_fp32(const int8_t* src, float scale, float* dst, size_t count);
+
+// 单个元素的标量转换
+float fp16_to_fp32(uint16_t h);
+float bf16_to_fp32(uint16_t b);
+
+} // namespace dtype
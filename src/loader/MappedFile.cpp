@@ -0,0 +1,110 @@
+#include "loader/MappedFile.hpp"
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        fallback_ = std::move(other.fallback_);
+        data_ = other.mapped_ ? other.data_ : fallback_.data();
+        size_ = other.size_;
+        open_ = other.open_;
+        mapped_ = other.mapped_;
+
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.open_ = false;
+        other.mapped_ = false;
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#if !defined(_WIN32)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "无法打开文件: " << path << std::endl;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        std::cerr << "无法获取文件大小: " << path << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ == 0) {
+        // 空文件无法映射，视为打开成功但没有数据
+        ::close(fd);
+        open_ = true;
+        return true;
+    }
+
+    void* addr = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // 映射建立后即可关闭描述符
+
+    if (addr != MAP_FAILED) {
+        data_ = static_cast<const char*>(addr);
+        mapped_ = true;
+        open_ = true;
+        return true;
+    }
+
+    std::cerr << "mmap失败，改为读取整个文件: " << path << std::endl;
+#endif
+
+    std::ifstream f(path, std::ios::binary | std::ios::ate);
+    if (!f.is_open()) {
+        std::cerr << "无法打开文件: " << path << std::endl;
+        size_ = 0;
+        return false;
+    }
+
+    size_ = static_cast<size_t>(f.tellg());
+    f.seekg(0, std::ios::beg);
+    fallback_.resize(size_);
+    if (size_ > 0 && !f.read(fallback_.data(), size_)) {
+        std::cerr << "读取文件失败: " << path << std::endl;
+        fallback_.clear();
+        size_ = 0;
+        return false;
+    }
+
+    data_ = fallback_.data();
+    open_ = true;
+    return true;
+}
+
+void MappedFile::close() {
+#if !defined(_WIN32)
+    if (mapped_ && data_) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+    fallback_.clear();
+    fallback_.shrink_to_fit();
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+    mapped_ = false;
+}
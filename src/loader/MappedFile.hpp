@@ -0,0 +1,36 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// 只读文件映射
+// POSIX 平台使用 mmap 共享只读页，多个进程打开同一份权重文件时不会各自持有一份堆拷贝；
+// 其他平台退化为一次性读入内存。
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // 打开并映射文件（会先关闭之前的映射）
+    bool open(const std::string& path);
+    void close();
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool is_open() const { return open_; }
+
+    // 是否真正使用了内存映射（false 表示退化为堆内存读取）
+    bool is_mapped() const { return mapped_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool open_ = false;
+    bool mapped_ = false;
+    std::vector<char> fallback_;  // 无法映射时的后备缓冲区
+};
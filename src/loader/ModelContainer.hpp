@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+// 单文件模型容器格式（由 bridge/export_model.py 写出）
+//
+//   [ContainerHeader]        64 字节，位于文件开头
+//   [TensorEntry x N]        张量表，紧跟文件头
+//   [metadata]               UTF-8 JSON：model_info / structure / layers / hotspots
+//   [tensor data]            每个张量按 64 字节对齐，便于 SIMD 直接访问
+//
+// 所有整数均为小端序，张量偏移为相对文件开头的绝对偏移。
+namespace container {
+
+constexpr char kMagic[8] = {'B', 'C', 'N', 'N', 'M', 'D', 'L', '\0'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kAlignment = 64;
+constexpr size_t kMaxDims = 6;
+constexpr size_t kMaxNameLength = 96;
+
+// 张量数据类型编码
+enum DTypeCode : uint32_t {
+    kFloat32 = 0,
+    kFloat16 = 1,   // IEEE 754 半精度
+    kBFloat16 = 2,  // float32 的高16位
+    kInt8 = 3,      // 对称量化，按第0维（输出通道）各一个 float32 缩放系数
+};
+
+struct ContainerHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t tensor_count;
+    uint32_t tensor_entry_size;
+    uint64_t tensor_table_offset;
+    uint64_t metadata_offset;
+    uint64_t metadata_size;
+    uint64_t data_offset;
+    uint64_t data_size;
+};
+
+struct TensorEntry {
+    char name[kMaxNameLength];      // 以'\0'结尾
+    uint32_t dtype;                 // DTypeCode
+    uint32_t ndim;
+    uint32_t shape[kMaxDims];
+    uint32_t strides[kMaxDims];     // 以元素为单位
+    uint64_t offset;                // 绝对偏移，64字节对齐
+    uint64_t size_bytes;
+    uint64_t scale_offset;          // kInt8：float32[shape[0]] 缩放系数的绝对偏移，其余类型为0
+    uint64_t checksum;              // 数据（kInt8 含缩放系数）的 FNV-1a 64 校验和，较早的文件为0
+    uint8_t reserved[8];
+};
+
+static_assert(sizeof(ContainerHeader) == 64, "ContainerHeader must be 64 bytes");
+static_assert(sizeof(TensorEntry) == 192, "TensorEntry must be 192 bytes");
+
+} // namespace container
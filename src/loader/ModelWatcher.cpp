@@ -0,0 +1,250 @@
+#include "loader/ModelWatcher.hpp"
+#include <iostream>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// 会触发重载的模型文件
+const char* const kWatchedFiles[] = {"model.bcnn", "model.json", "weights.bin"};
+
+bool is_watched_file(const std::string& name) {
+    for (const char* file : kWatchedFiles) {
+        if (name == file) return true;
+    }
+    return false;
+}
+
+// FNV-1a 64位哈希
+uint64_t fnv1a(const char* data, size_t size) {
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// 参考激活值在哈希表中的键前缀
+const std::string kActivationPrefix = "activations/";
+
+// 层名第一个'.'之前的部分即模块名，与热点名称一致；参考激活值统一归入 activations
+std::string module_of(const std::string& name) {
+    if (name.compare(0, kActivationPrefix.size(), kActivationPrefix) == 0) {
+        return "activations";
+    }
+    return name.substr(0, name.find('.'));
+}
+
+} // namespace
+
+ModelWatcher::~ModelWatcher() {
+    if (pending_.valid()) {
+        pending_.wait();
+    }
+#ifdef __linux__
+    if (inotifyFd_ >= 0) {
+        close(inotifyFd_);
+    }
+#endif
+}
+
+bool ModelWatcher::start(const std::string& dir, std::shared_ptr<const ModelLoader> current) {
+    dir_ = dir;
+    current_ = std::move(current);
+
+#ifdef __linux__
+    inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd_ >= 0 &&
+        inotify_add_watch(inotifyFd_, dir_.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) >= 0) {
+        std::cout << "监视模型目录: " << dir_ << std::endl;
+        return true;
+    }
+    std::cerr << "inotify不可用，改为轮询模型文件修改时间" << std::endl;
+    if (inotifyFd_ >= 0) {
+        close(inotifyFd_);
+        inotifyFd_ = -1;
+    }
+#endif
+
+    // 轮询模式：记录当前修改时间
+    std::error_code ec;
+    for (const char* file : kWatchedFiles) {
+        auto path = std::filesystem::path(dir_) / file;
+        auto mtime = std::filesystem::last_write_time(path, ec);
+        if (!ec) {
+            mtimes_[file] = mtime;
+        }
+    }
+    lastScan_ = std::chrono::steady_clock::now();
+    std::cout << "轮询模型目录: " << dir_ << std::endl;
+    return true;
+}
+
+bool ModelWatcher::checkChanges() {
+    bool changed = false;
+
+#ifdef __linux__
+    if (inotifyFd_ >= 0) {
+        alignas(inotify_event) char buffer[4096];
+        for (;;) {
+            ssize_t len = read(inotifyFd_, buffer, sizeof(buffer));
+            if (len <= 0) break;
+            for (char* p = buffer; p < buffer + len;) {
+                auto* event = reinterpret_cast<inotify_event*>(p);
+                if (event->len > 0 && is_watched_file(event->name)) {
+                    changed = true;
+                }
+                p += sizeof(inotify_event) + event->len;
+            }
+        }
+        return changed;
+    }
+#endif
+
+    // 每秒检查一次修改时间
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastScan_ < std::chrono::seconds(1)) {
+        return false;
+    }
+    lastScan_ = now;
+
+    std::error_code ec;
+    for (const char* file : kWatchedFiles) {
+        auto path = std::filesystem::path(dir_) / file;
+        auto mtime = std::filesystem::last_write_time(path, ec);
+        if (ec) continue;
+        auto it = mtimes_.find(file);
+        if (it == mtimes_.end() || it->second != mtime) {
+            mtimes_[file] = mtime;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+bool ModelWatcher::poll(Update& update) {
+    if (dir_.empty()) {
+        return false;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (checkChanges()) {
+        dirty_ = true;
+        lastChange_ = now;
+    }
+
+    // 上一次重载完成：交给渲染线程替换
+    if (pending_.valid() &&
+        pending_.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        ReloadResult result = pending_.get();
+        if (!result.model) {
+            return false;
+        }
+
+        currentTable_ = std::move(result.table);
+        current_ = result.model;
+        if (result.changedModules.empty()) {
+            std::cout << "模型文件已更新，但张量内容没有变化" << std::endl;
+            return false;
+        }
+
+        update.model = std::move(result.model);
+        update.changedModules = std::move(result.changedModules);
+        return true;
+    }
+
+    // 文件稳定一段时间后才开始重载
+    if (dirty_ && !pending_.valid() && now - lastChange_ >= kDebounce) {
+        dirty_ = false;
+        startReload();
+    }
+    return false;
+}
+
+void ModelWatcher::startReload() {
+    std::cout << "检测到模型文件变化，后台重新加载..." << std::endl;
+
+    std::string dir = dir_;
+    std::shared_ptr<const ModelLoader> previous = current_;
+    TensorTable previousTable = currentTable_;
+
+    pending_ = std::async(std::launch::async,
+        [dir, previous, previousTable]() mutable {
+            ReloadResult result;
+
+            auto model = std::make_shared<ModelLoader>();
+            if (!model->load_from_dir(dir)) {
+                std::cerr << "模型重新加载失败，继续使用旧模型" << std::endl;
+                return result;
+            }
+
+            // 第一次重载时才读取旧模型的张量表
+            if (previousTable.empty() && previous) {
+                previousTable = readTable(*previous);
+            }
+            result.table = readTable(*model);
+
+            // 内容变化、新增或删除的张量所在的模块都需要重建
+            for (auto& [name, entry] : result.table) {
+                auto it = previousTable.find(name);
+                if (it == previousTable.end()) {
+                    result.changedModules.insert(module_of(name));
+                    continue;
+                }
+
+                TensorSignature& old = it->second;
+                bool changed = false;
+                if (entry.dtype != old.dtype || entry.shape != old.shape || entry.size_bytes != old.size_bytes) {
+                    changed = true;
+                } else if (entry.checksum != 0 && old.checksum != 0) {
+                    changed = entry.checksum != old.checksum;
+                } else {
+                    // 没有存储校验和：只对表项相同的张量比较内容哈希
+                    if (!old.hashed && previous) {
+                        old.hash = hashTensor(*previous, name);
+                        old.hashed = true;
+                    }
+                    entry.hash = hashTensor(*model, name);
+                    entry.hashed = true;
+                    changed = entry.hash != old.hash;
+                }
+                if (changed) {
+                    result.changedModules.insert(module_of(name));
+                }
+            }
+            for (const auto& [name, entry] : previousTable) {
+                if (result.table.find(name) == result.table.end()) {
+                    result.changedModules.insert(module_of(name));
+                }
+            }
+
+            result.model = std::move(model);
+            return result;
+        });
+}
+
+ModelWatcher::TensorTable ModelWatcher::readTable(const ModelLoader& model) {
+    TensorTable table;
+    auto add = [&](const Layer& layer, const std::string& key) {
+        TensorSignature& entry = table[key];
+        entry.dtype = layer.dtype;
+        entry.shape = layer.shape;
+        entry.size_bytes = layer.size_bytes;
+        entry.checksum = layer.checksum;
+    };
+    for (const auto& layer : model.layers) add(layer, layer.name);
+    for (const auto& tensor : model.activations) add(tensor, kActivationPrefix + tensor.name);
+    return table;
+}
+
+uint64_t ModelWatcher::hashTensor(const ModelLoader& model, const std::string& key) {
+    const Layer* layer = key.compare(0, kActivationPrefix.size(), kActivationPrefix) == 0
+                             ? model.find_activation(key.substr(kActivationPrefix.size()))
+                             : model.find_layer(key);
+    const char* data = layer ? model.get_layer_data(*layer) : nullptr;
+    return data ? fnv1a(data, layer->size_bytes) : 0;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "loader/ModelLoader.hpp"
+#include <chrono>
+#include <filesystem>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// 模型目录热重载
+// 监视模型目录（Linux下使用inotify，其他平台按修改时间轮询），文件稳定后
+// 在后台线程加载新的ModelLoader快照，并比较张量表找出发生变化的模块：
+// 容器中带校验和的张量只比较表项（类型、形状、大小、校验和），不读取数据；
+// 没有校验和的旧版 weights.bin 只对表项相同的张量计算内容哈希。
+// 渲染线程在帧与帧之间调用poll()取得新快照并替换，旧快照在无人引用后释放。
+class ModelWatcher {
+public:
+    // 新的模型快照及其变化的模块（如 conv2、classifier；参考激活值变化记为 activations）
+    struct Update {
+        std::shared_ptr<const ModelLoader> model;
+        std::unordered_set<std::string> changedModules;
+    };
+
+    ModelWatcher() = default;
+    ~ModelWatcher();
+
+    ModelWatcher(const ModelWatcher&) = delete;
+    ModelWatcher& operator=(const ModelWatcher&) = delete;
+
+    // 开始监视目录，current为当前正在使用的模型
+    bool start(const std::string& dir, std::shared_ptr<const ModelLoader> current);
+
+    // 在渲染线程每帧调用；有新快照就绪时填写update并返回true
+    bool poll(Update& update);
+
+    bool isReloading() const { return pending_.valid(); }
+
+private:
+    // 张量表项；hash 为没有校验和时按需计算的内容哈希
+    struct TensorSignature {
+        std::string dtype;
+        std::vector<int> shape;
+        size_t size_bytes = 0;
+        uint64_t checksum = 0;        // 容器中存储的校验和，0 表示未提供
+        uint64_t hash = 0;
+        bool hashed = false;
+    };
+    using TensorTable = std::unordered_map<std::string, TensorSignature>;
+
+    struct ReloadResult {
+        std::shared_ptr<const ModelLoader> model;
+        TensorTable table;
+        std::unordered_set<std::string> changedModules;
+    };
+
+    // 检查是否有模型文件发生变化（不阻塞）
+    bool checkChanges();
+    void startReload();
+
+    // 只读取张量表，不访问张量数据
+    static TensorTable readTable(const ModelLoader& model);
+    static uint64_t hashTensor(const ModelLoader& model, const std::string& key);
+
+    // 文件写入完成后等待一段时间再加载，避免导出过程中读到一半的文件
+    static constexpr std::chrono::milliseconds kDebounce{500};
+
+    std::string dir_;
+    std::shared_ptr<const ModelLoader> current_;
+    TensorTable currentTable_;
+    std::future<ReloadResult> pending_;
+
+    bool dirty_ = false;
+    std::chrono::steady_clock::time_point lastChange_;
+
+    int inotifyFd_ = -1;
+    std::chrono::steady_clock::time_point lastScan_;
+    std::unordered_map<std::string, std::filesystem::file_time_type> mtimes_;
+};
@@ -1,192 +1,715 @@
 #include "modelloader.hpp"
+#include "loader/DTypeConvert.hpp"
+#include "engine/kernels/Winograd.hpp"
 #include <iostream>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
 
-bool ModelLoader::load(const std::string& jsonPath, const std::string& binPath) {
-    // 清空之前的数据
+namespace {
+
+// 行优先连续存储的元素步长
+std::vector<int> contiguous_strides(const std::vector<int>& shape) {
+    std::vector<int> strides(shape.size(), 1);
+    for (int i = static_cast<int>(shape.size()) - 2; i >= 0; --i) {
+        strides[i] = strides[i + 1] * shape[i + 1];
+    }
+    return strides;
+}
+
+} // namespace
+
+DType parse_dtype(const std::string& dtype) {
+    if (dtype == "float32") return DType::Float32;
+    if (dtype == "float16") return DType::Float16;
+    if (dtype == "bfloat16") return DType::BFloat16;
+    if (dtype == "int8") return DType::Int8;
+    return DType::Unknown;
+}
+
+size_t dtype_size(DType dtype) {
+    switch (dtype) {
+        case DType::Float32: return 4;
+        case DType::Float16:
+        case DType::BFloat16: return 2;
+        case DType::Int8: return 1;
+        default: return 0;
+    }
+}
+
+void ModelLoader::reset() {
     layers.clear();
-    weights.clear();
+    activations.clear();
+    layer_index.clear();
+    activation_index.clear();
+    module_index.clear();
+    conv_index.clear();
+    fc_index.clear();
+    bias_index.clear();
+    folded_weights.clear();
+    winograd_filters.clear();
+    weights_file.close();
+    weights_data = nullptr;
+    weights_size = 0;
     hotspots.clear();
     structure.clear();
+    model_dir.clear();
+}
 
-    // 加载JSON文件
-    std::ifstream jf(jsonPath);
-    if (!jf.is_open()) {
-        std::cerr << "无法打开JSON文件: " << jsonPath << std::endl;
-        return false;
+bool ModelLoader::parse_metadata(const json& j) {
+    // 解析模型信息
+    if (j.contains("model_info")) {
+        auto& info = j["model_info"];
+        model_info.input_size = info["input_size"].get<std::vector<int>>();
+        model_info.output_size = info["output_size"];
+        model_info.num_classes = info["num_classes"];
+        model_info.description = info["description"];
+        
+        std::cout << "加载模型: " << model_info.description << std::endl;
+        std::cout << "输入尺寸: " << model_info.input_size[0] << "x" 
+                  << model_info.input_size[1] << "x" << model_info.input_size[2] << std::endl;
+        std::cout << "输出类别: " << model_info.num_classes << std::endl;
     }
 
-    try {
-        json j;
-        jf >> j;
-
-        // 解析模型信息
-        if (j.contains("model_info")) {
-            auto& info = j["model_info"];
-            model_info.input_size = info["input_size"].get<std::vector<int>>();
-            model_info.output_size = info["output_size"];
-            model_info.num_classes = info["num_classes"];
-            model_info.description = info["description"];
+    // 解析网络结构
+    if (j.contains("structure")) {
+        for (auto& s : j["structure"]) {
+            LayerStructure layer_struct;
+            layer_struct.name = s["name"];
+            layer_struct.type = s["type"];
             
-            std::cout << "加载模型: " << model_info.description << std::endl;
-            std::cout << "输入尺寸: " << model_info.input_size[0] << "x" 
-                      << model_info.input_size[1] << "x" << model_info.input_size[2] << std::endl;
-            std::cout << "输出类别: " << model_info.num_classes << std::endl;
-        }
-
-        // 解析网络结构
-        if (j.contains("structure")) {
-            for (auto& s : j["structure"]) {
-                LayerStructure layer_struct;
-                layer_struct.name = s["name"];
-                layer_struct.type = s["type"];
-                
-                // 解析参数
-                for (auto it = s.begin(); it != s.end(); ++it) {
-                    if (it.key() != "name" && it.key() != "type") {
-                        if (it.value().is_number()) {
-                            layer_struct.parameters[it.key()] = it.value();
-                        }
+            // 解析参数
+            for (auto it = s.begin(); it != s.end(); ++it) {
+                if (it.key() != "name" && it.key() != "type") {
+                    if (it.value().is_number_integer()) {
+                        layer_struct.parameters[it.key()] = it.value();
+                    } else if (it.value().is_number_float()) {
+                        layer_struct.float_parameters[it.key()] = it.value();
+                    } else if (it.value().is_string()) {
+                        layer_struct.attributes[it.key()] = it.value();
                     }
                 }
-                structure.push_back(layer_struct);
             }
-            std::cout << "网络结构层数: " << structure.size() << std::endl;
+            structure.push_back(layer_struct);
         }
+        std::cout << "网络结构层数: " << structure.size() << std::endl;
+    }
 
-        // 解析网络层参数
-        for (auto& l : j["layers"]) {
-            Layer lay;
-            lay.name = l["name"];
-            lay.shape = l["shape"].get<std::vector<int>>();
-            lay.offset = l["offset"];
-            lay.size_bytes = l["size_bytes"];
-            lay.type = l["type"];
-            
-            if (l.contains("dtype")) {
-                lay.dtype = l["dtype"];
-            }
+    // 解析网络层参数
+    for (auto& l : j.at("layers")) {
+        Layer lay;
+        lay.name = l["name"];
+        lay.shape = l["shape"].get<std::vector<int>>();
+        // 单文件容器中偏移由张量表给出
+        lay.offset = l.value("offset", size_t(0));
+        lay.size_bytes = l.value("size_bytes", size_t(0));
+        lay.type = l["type"];
+        
+        if (l.contains("dtype")) {
+            lay.dtype = l["dtype"];
+        }
 
-            // 解析热点区域
-            if (!l["hotspot"].is_null()) {
-                auto& h = l["hotspot"];
-                lay.hotspot.type = h["type"];
-                
-                // 解析坐标点
-                for (auto& p : h["pts"]) {
-                    if (p.is_array() && p.size() >= 2) {
-                        lay.hotspot.pts.emplace_back(p[0].get<float>(), p[1].get<float>());
-                    }
-                }
-                
-                if (h.contains("description")) {
-                    lay.hotspot.description = h["description"];
+        // 解析热点区域
+        if (!l["hotspot"].is_null()) {
+            auto& h = l["hotspot"];
+            lay.hotspot.type = h["type"];
+            
+            // 解析坐标点
+            for (auto& p : h["pts"]) {
+                if (p.is_array() && p.size() >= 2) {
+                    lay.hotspot.pts.push_back(Vec2f{p[0].get<float>(), p[1].get<float>()});
                 }
             }
-
-            layers.push_back(std::move(lay));
+            
+            if (h.contains("description")) {
+                lay.hotspot.description = h["description"];
+            }
         }
 
-        // 解析独立的热点区域
-        if (j.contains("hotspots")) {
-            for (auto& [key, h] : j["hotspots"].items()) {
-                HotSpot hotspot;
-                hotspot.type = h["type"];
-                
-                // 解析坐标点
-                for (auto& p : h["pts"]) {
-                    if (p.is_array() && p.size() >= 2) {
-                        hotspot.pts.emplace_back(p[0].get<float>(), p[1].get<float>());
-                    }
-                }
-                
-                if (h.contains("description")) {
-                    hotspot.description = h["description"];
+        lay.strides = contiguous_strides(lay.shape);
+        layers.push_back(std::move(lay));
+    }
+
+    // 解析独立的热点区域
+    if (j.contains("hotspots")) {
+        for (auto& [key, h] : j["hotspots"].items()) {
+            HotSpot hotspot;
+            hotspot.type = h["type"];
+            
+            // 解析坐标点
+            for (auto& p : h["pts"]) {
+                if (p.is_array() && p.size() >= 2) {
+                    hotspot.pts.push_back(Vec2f{p[0].get<float>(), p[1].get<float>()});
                 }
-                
-                hotspots[key] = hotspot;
             }
+            
+            if (h.contains("description")) {
+                hotspot.description = h["description"];
+            }
+            
+            hotspots[key] = hotspot;
         }
+    }
 
-        std::cout << "成功加载 " << layers.size() << " 个参数层" << std::endl;
-        std::cout << "成功加载 " << hotspots.size() << " 个热点区域" << std::endl;
+    std::cout << "成功加载 " << layers.size() << " 个参数层" << std::endl;
+    std::cout << "成功加载 " << hotspots.size() << " 个热点区域" << std::endl;
+    return true;
+}
+
+bool ModelLoader::load(const std::string& jsonPath, const std::string& binPath) {
+    // 清空之前的数据
+    reset();
+
+    model_dir = std::filesystem::path(jsonPath).parent_path().string();
+
+    // 加载JSON文件
+    std::ifstream jf(jsonPath);
+    if (!jf.is_open()) {
+        std::cerr << "无法打开JSON文件: " << jsonPath << std::endl;
+        return false;
+    }
 
+    try {
+        json j;
+        jf >> j;
+        parse_metadata(j);
     } catch (const std::exception& e) {
         std::cerr << "JSON解析错误: " << e.what() << std::endl;
         return false;
     }
 
-    // 加载二进制权重文件
-    std::ifstream bf(binPath, std::ios::binary);
-    if (!bf.is_open()) {
-        std::cerr << "无法打开BIN文件: " << binPath << std::endl;
+    // weights.bin 只存放 float32，低精度存储仅由单文件容器支持
+    for (const auto& layer : layers) {
+        if (parse_dtype(layer.dtype) != DType::Float32) {
+            std::cerr << "weights.bin 不支持的数据类型: " << layer.name << " (" << layer.dtype << ")" << std::endl;
+            reset();
+            return false;
+        }
+    }
+
+    // 映射二进制权重文件
+    if (!map_weights(binPath)) {
+        return false;
+    }
+
+    build_index();
+    precompute_winograd();
+    return !layers.empty() && weights_size > 0;
+}
+
+bool ModelLoader::load_container(const std::string& path) {
+    using namespace container;
+
+    reset();
+    model_dir = std::filesystem::path(path).parent_path().string();
+
+    if (!weights_file.open(path)) {
+        std::cerr << "无法打开模型容器: " << path << std::endl;
         return false;
     }
 
+    const char* base = weights_file.data();
+    size_t file_size = weights_file.size();
+
+    auto fail = [&](const char* reason) {
+        std::cerr << "模型容器格式错误 (" << reason << "): " << path << std::endl;
+        reset();
+        return false;
+    };
+
+    // 解析文件头
+    ContainerHeader header;
+    if (file_size < sizeof(ContainerHeader)) return fail("文件过小");
+    std::memcpy(&header, base, sizeof(ContainerHeader));
+
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) return fail("魔数不匹配");
+    if (header.version != kVersion) return fail("版本不支持");
+    if (header.tensor_entry_size < sizeof(TensorEntry)) return fail("张量表项过小");
+    if (header.tensor_table_offset + uint64_t(header.tensor_count) * header.tensor_entry_size > file_size) {
+        return fail("张量表越界");
+    }
+    if (header.metadata_offset + header.metadata_size > file_size) return fail("元数据越界");
+
+    // 解析元数据（结构、热点、层类型）
     try {
-        // 读取权重数量（文件头）
-        uint32_t num_weights = 0;
-        bf.read(reinterpret_cast<char*>(&num_weights), sizeof(uint32_t));
-        
-        if (num_weights > 0 && num_weights < 10000000) { // 合理的范围检查
-            // 有文件头的情况
-            weights.resize(num_weights * sizeof(float));
-            bf.read(weights.data(), num_weights * sizeof(float));
-            std::cout << "加载权重数量: " << num_weights << std::endl;
+        const char* meta = base + header.metadata_offset;
+        json j = json::parse(meta, meta + header.metadata_size);
+        parse_metadata(j);
+    } catch (const std::exception& e) {
+        std::cerr << "元数据解析错误: " << e.what() << std::endl;
+        reset();
+        return false;
+    }
+
+    // 解析张量表
+    std::unordered_map<std::string, size_t> layer_pos;
+    for (size_t i = 0; i < layers.size(); ++i) {
+        layer_pos.emplace(layers[i].name, i);
+    }
+    std::vector<bool> matched(layers.size(), false);
+    for (uint32_t i = 0; i < header.tensor_count; ++i) {
+        TensorEntry entry;
+        std::memcpy(&entry, base + header.tensor_table_offset + uint64_t(i) * header.tensor_entry_size,
+                    sizeof(TensorEntry));
+
+        if (entry.ndim > kMaxDims) return fail("维度过多");
+        if (entry.offset + entry.size_bytes > file_size) return fail("张量数据越界");
+        if (entry.offset % kAlignment != 0) return fail("张量未对齐");
+
+        Layer tensor;
+        tensor.name.assign(entry.name, strnlen(entry.name, kMaxNameLength));
+        tensor.shape.assign(entry.shape, entry.shape + entry.ndim);
+        tensor.strides.assign(entry.strides, entry.strides + entry.ndim);
+        tensor.offset = entry.offset;
+        tensor.size_bytes = entry.size_bytes;
+        tensor.checksum = entry.checksum;
+
+        switch (entry.dtype) {
+            case kFloat32: tensor.dtype = "float32"; break;
+            case kFloat16: tensor.dtype = "float16"; break;
+            case kBFloat16: tensor.dtype = "bfloat16"; break;
+            case kInt8: tensor.dtype = "int8"; break;
+            default: return fail("未知数据类型");
+        }
+
+        size_t numel = 1;
+        for (int d : tensor.shape) numel *= static_cast<size_t>(d);
+        if (numel * dtype_size(parse_dtype(tensor.dtype)) != entry.size_bytes) return fail("张量大小不符");
+
+        // int8 需要每个输出通道一个缩放系数
+        if (entry.dtype == kInt8) {
+            size_t channels = tensor.shape.empty() ? 1 : static_cast<size_t>(tensor.shape[0]);
+            if (entry.scale_offset == 0 || entry.scale_offset % sizeof(float) != 0 ||
+                entry.scale_offset + channels * sizeof(float) > file_size) {
+                return fail("缩放系数越界");
+            }
+            tensor.scale_offset = entry.scale_offset;
+        }
+
+        // 元数据中声明过的为参数层，其余为导出的参考激活值
+        auto pos = layer_pos.find(tensor.name);
+        if (pos != layer_pos.end()) {
+            Layer& layer = layers[pos->second];
+            layer.shape = std::move(tensor.shape);
+            layer.strides = std::move(tensor.strides);
+            layer.offset = tensor.offset;
+            layer.size_bytes = tensor.size_bytes;
+            layer.dtype = tensor.dtype;
+            layer.scale_offset = tensor.scale_offset;
+            layer.checksum = tensor.checksum;
+            matched[pos->second] = true;
         } else {
-            // 没有文件头的情况，读取整个文件
-            bf.seekg(0, std::ios::end);
-            size_t size = bf.tellg();
-            bf.seekg(0, std::ios::beg);
-            weights.resize(size);
-            bf.read(weights.data(), size);
-            std::cout << "加载权重文件大小: " << size << " 字节" << std::endl;
+            tensor.type = "activation";
+            activations.push_back(std::move(tensor));
         }
+    }
 
-    } catch (const std::exception& e) {
-        std::cerr << "BIN文件读取错误: " << e.what() << std::endl;
+    for (size_t i = 0; i < layers.size(); ++i) {
+        if (!matched[i]) {
+            std::cerr << "模型容器缺少张量: " << layers[i].name << std::endl;
+            return fail("张量缺失");
+        }
+    }
+
+    // 容器中的偏移为绝对偏移，数据区即整个文件
+    weights_data = base;
+    weights_size = file_size;
+    build_index();
+    precompute_winograd();
+
+    std::cout << "加载模型容器: " << path << " (" << header.tensor_count << " 个张量, "
+              << activations.size() << " 个参考激活)" << std::endl;
+
+    return !layers.empty();
+}
+
+bool ModelLoader::load_from_dir(const std::string& dir) {
+    std::filesystem::path base(dir);
+    std::filesystem::path containerPath = base / "model.bcnn";
+    if (std::filesystem::exists(containerPath)) {
+        return load_container(containerPath.string());
+    }
+    return load((base / "model.json").string(), (base / "weights.bin").string());
+}
+
+int ModelLoader::fold_batchnorm(bool allow_missing_stats) {
+    // 按名称依次查找参数（Sequential 导出为 conv1.0.weight / conv1.1.weight）
+    auto find = [this](const std::vector<std::string>& names) -> const Layer* {
+        for (const auto& name : names) {
+            if (const Layer* layer = find_layer(name)) return layer;
+        }
+        return nullptr;
+    };
+    auto numel = [](const Layer* layer) {
+        size_t n = 1;
+        for (int d : layer->shape) n *= static_cast<size_t>(d);
+        return n;
+    };
+
+    // 第一遍只检查并记录参数名，不修改任何数据：缺少统计量时整体失败
+    struct FoldPair {
+        size_t bn_index = 0;                  // BN 在 structure 中的位置
+        std::string weight, bias, gamma, beta;
+        std::string mean, var;                // 为空表示缺少统计量（仅 allow_missing_stats 时）
+        bool zero_bias = false;               // 卷积没有偏置，按0处理
+        float eps = 1e-5f;
+    };
+    std::vector<FoldPair> pairs;
+    std::vector<Layer> zero_biases;
+    bool missing_stats = false;
+    for (size_t i = 0; i + 1 < structure.size(); ++i) {
+        const LayerStructure& s = structure[i];
+        const LayerStructure& bn = structure[i + 1];
+        if (s.type != "conv2d" || bn.type != "batchnorm2d") {
+            continue;
+        }
+
+        const Layer* weight = find({s.name + ".weight", s.name + ".0.weight"});
+        const Layer* bias = find({s.name + ".bias", s.name + ".0.bias"});
+        std::vector<std::string> prefixes = {bn.name + ".", s.name + ".1."};
+        auto find_bn = [&](const std::string& suffix) {
+            return find({prefixes[0] + suffix, prefixes[1] + suffix});
+        };
+        const Layer* gamma = find_bn("weight");
+        const Layer* beta = find_bn("bias");
+        const Layer* mean = find_bn("running_mean");
+        const Layer* var = find_bn("running_var");
+
+        if (!weight || !gamma || !beta || weight->shape.empty()) {
+            std::cerr << "无法折叠BN（缺少卷积权重或BN参数）: " << bn.name << std::endl;
+            continue;
+        }
+        const size_t oc = static_cast<size_t>(weight->shape[0]);
+        if ((bias && numel(bias) != oc) || numel(gamma) != oc || numel(beta) != oc) {
+            std::cerr << "无法折叠BN（参数形状不符）: " << bn.name << std::endl;
+            continue;
+        }
+
+        // 没有 running_mean/running_var 或 eps 时折叠结果与训练时的网络不同，除非调用方明确允许，否则报错
+        const bool has_stats = mean && var && numel(mean) == oc && numel(var) == oc;
+        auto eps_it = bn.float_parameters.find("eps");
+        const bool has_eps = eps_it != bn.float_parameters.end();
+        if (!has_stats || !has_eps) {
+            const char* what = !has_stats ? "running_mean/running_var" : "eps";
+            if (!allow_missing_stats) {
+                std::cerr << "错误: " << bn.name << " 缺少 " << what
+                          << "，无法折叠（请用 bridge/export_model.py 重新导出模型）" << std::endl;
+                missing_stats = true;
+                continue;
+            }
+            std::cerr << "警告: " << bn.name << " 缺少 " << what
+                      << "，按均值0、方差1、eps=1e-5 近似折叠，结果与训练时的网络不同" << std::endl;
+        }
+
+        FoldPair pair;
+        pair.bn_index = i + 1;
+        pair.weight = weight->name;
+        pair.gamma = gamma->name;
+        pair.beta = beta->name;
+        if (has_stats) {
+            pair.mean = mean->name;
+            pair.var = var->name;
+        }
+        if (has_eps) {
+            pair.eps = eps_it->second;
+        }
+        if (bias) {
+            pair.bias = bias->name;
+        } else {
+            // 折叠后的偏置一般不为0，为其补一个只存在于 folded_weights 中的偏置层
+            Layer zero;
+            const std::string& name = weight->name;
+            zero.name = name.size() > 6 && name.compare(name.size() - 6, 6, "weight") == 0
+                            ? name.substr(0, name.size() - 6) + "bias"
+                            : s.name + ".bias";
+            zero.shape = {static_cast<int>(oc)};
+            zero.strides = {1};
+            zero.size_bytes = 0;               // 映射文件中没有数据
+            zero.type = "bias";
+            pair.bias = zero.name;
+            pair.zero_bias = true;
+            zero_biases.push_back(std::move(zero));
+        }
+        pairs.push_back(std::move(pair));
+    }
+    if (missing_stats) {
+        return -1;
+    }
+
+    if (!zero_biases.empty()) {
+        // 追加层会使指向 layers 的指针失效：此时还没有折叠结果，清空按指针索引的数据并重建索引
+        layers.insert(layers.end(), zero_biases.begin(), zero_biases.end());
+        winograd_filters.clear();
+        build_index();
+    }
+
+    int folded = 0;
+    std::vector<bool> removed(structure.size(), false);
+    for (const FoldPair& pair : pairs) {
+        const Layer* weight = find_layer(pair.weight);
+        const Layer* bias = find_layer(pair.bias);
+        const bool has_stats = !pair.mean.empty();
+        // 低精度参数反量化到视图持有的临时缓冲区，折叠后即释放
+        TensorView w_view = view_of(*weight);
+        TensorView b_view = pair.zero_bias ? TensorView() : view_of(*bias);
+        TensorView g_view = view_of(*find_layer(pair.gamma));
+        TensorView be_view = view_of(*find_layer(pair.beta));
+        TensorView m_view = has_stats ? view_of(*find_layer(pair.mean)) : TensorView();
+        TensorView v_view = has_stats ? view_of(*find_layer(pair.var)) : TensorView();
+        const float* w = w_view.data();
+        const float* b = b_view.data();
+        const float* g = g_view.data();
+        const float* be = be_view.data();
+        const float* m = m_view.data();
+        const float* v = v_view.data();
+        if (!w || (!pair.zero_bias && !b) || !g || !be || (has_stats && (!m || !v))) {
+            continue;
+        }
+
+        const size_t oc = static_cast<size_t>(weight->shape[0]);
+        const size_t per_oc = numel(weight) / oc;
+        std::vector<float> new_w(w, w + numel(weight));
+        std::vector<float> new_b(oc);
+        for (size_t c = 0; c < oc; ++c) {
+            float mu = has_stats ? m[c] : 0.0f;
+            float sigma2 = has_stats ? v[c] : 1.0f;
+            float scale = g[c] / std::sqrt(sigma2 + pair.eps);
+            for (size_t k = 0; k < per_oc; ++k) {
+                new_w[c * per_oc + k] *= scale;
+            }
+            new_b[c] = ((b ? b[c] : 0.0f) - mu) * scale + be[c];
+        }
+        folded_weights[weight] = std::move(new_w);
+        folded_weights[bias] = std::move(new_b);
+
+        // 移除已折叠的BN层；卷积上的 activation 属性保持不变（ReLU 直接接在卷积之后）
+        removed[pair.bn_index] = true;
+        ++folded;
+    }
+
+    std::vector<LayerStructure> kept;
+    kept.reserve(structure.size());
+    for (size_t i = 0; i < structure.size(); ++i) {
+        if (!removed[i]) kept.push_back(std::move(structure[i]));
+    }
+    structure = std::move(kept);
+
+    // 卷积权重已改变（或 layers 已重新分配），重新计算 Winograd 滤波器变换
+    if (folded > 0 || !zero_biases.empty()) {
+        precompute_winograd();
+    }
+    if (folded > 0) {
+        std::cout << "已将 " << folded << " 个BN层折叠进卷积" << std::endl;
+    }
+    return folded;
+}
+
+bool ModelLoader::map_weights(const std::string& binPath) {
+    if (!weights_file.open(binPath)) {
+        std::cerr << "无法打开BIN文件: " << binPath << std::endl;
+        return false;
+    }
+
+    const char* base = weights_file.data();
+    size_t file_size = weights_file.size();
+
+    // 根据JSON中的布局计算权重数据应有的字节数
+    size_t expected = 0;
+    for (const auto& layer : layers) {
+        expected = std::max(expected, layer.offset + layer.size_bytes);
+    }
+
+    // 显式判断文件头：前4字节为权重数量，且文件大小与之严格对应
+    uint32_t num_weights = 0;
+    if (file_size >= sizeof(uint32_t)) {
+        std::memcpy(&num_weights, base, sizeof(uint32_t));
+    }
+    bool has_header = file_size >= sizeof(uint32_t) &&
+                      sizeof(uint32_t) + static_cast<size_t>(num_weights) * sizeof(float) == file_size;
+
+    if (has_header) {
+        weights_data = base + sizeof(uint32_t);
+        weights_size = file_size - sizeof(uint32_t);
+        std::cout << "加载权重数量: " << num_weights << std::endl;
+    } else {
+        weights_data = base;
+        weights_size = file_size;
+        std::cout << "加载权重文件大小: " << file_size << " 字节 (无文件头)" << std::endl;
+    }
+
+    if (expected > weights_size) {
+        std::cerr << "BIN文件与JSON不匹配: 需要 " << expected
+                  << " 字节, 实际 " << weights_size << " 字节" << std::endl;
+        weights_file.close();
+        weights_data = nullptr;
+        weights_size = 0;
         return false;
     }
 
-    return !layers.empty() && !weights.empty();
+    if (!weights_file.is_mapped()) {
+        std::cout << "注意: 权重文件未能映射，已读入内存" << std::endl;
+    }
+
+    return true;
 }
 
-const float* ModelLoader::get_layer_weights(const Layer& layer) const {
-    if (layer.offset + layer.size_bytes > weights.size()) {
+const char* ModelLoader::get_layer_data(const Layer& layer) const {
+    if (layer.size_bytes == 0) {
+        return nullptr;                    // fold_batchnorm() 补的偏置层，文件中没有数据
+    }
+    if (!weights_data || layer.offset + layer.size_bytes > weights_size) {
         std::cerr << "权重数据越界: " << layer.name << std::endl;
         return nullptr;
     }
-    return reinterpret_cast<const float*>(weights.data() + layer.offset);
+    return weights_data + layer.offset;
 }
 
-std::vector<Layer> ModelLoader::get_conv_layers() const {
-    std::vector<Layer> conv_layers;
-    for (const auto& layer : layers) {
-        if (layer.type.find("conv") != std::string::npos) {
-            conv_layers.push_back(layer);
+const float* ModelLoader::get_layer_scales(const Layer& layer) const {
+    if (parse_dtype(layer.dtype) != DType::Int8 || layer.scale_offset == 0) {
+        return nullptr;
+    }
+    return reinterpret_cast<const float*>(weights_data + layer.scale_offset);
+}
+
+bool ModelLoader::dequantize(const Layer& layer, float* out) const {
+    const char* raw = get_layer_data(layer);
+    if (!raw) return false;
+
+    DType dtype = parse_dtype(layer.dtype);
+    size_t elem = dtype_size(dtype);
+    if (elem == 0) {
+        std::cerr << "未知数据类型: " << layer.name << " (" << layer.dtype << ")" << std::endl;
+        return false;
+    }
+    size_t count = layer.size_bytes / elem;
+
+    switch (dtype) {
+        case DType::Float32:
+            std::memcpy(out, raw, layer.size_bytes);
+            return true;
+        case DType::Float16:
+            dtype::fp16_to_fp32(reinterpret_cast<const uint16_t*>(raw), out, count);
+            return true;
+        case DType::BFloat16:
+            dtype::bf16_to_fp32(reinterpret_cast<const uint16_t*>(raw), out, count);
+            return true;
+        case DType::Int8: {
+            const float* scales = get_layer_scales(layer);
+            if (!scales) return false;
+            size_t channels = layer.shape.empty() ? 1 : static_cast<size_t>(layer.shape[0]);
+            size_t per_channel = channels ? count / channels : 0;
+            const int8_t* q = reinterpret_cast<const int8_t*>(raw);
+            for (size_t c = 0; c < channels; ++c) {
+                dtype::int8_to_fp32(q + c * per_channel, scales[c], out + c * per_channel, per_channel);
+            }
+            return true;
         }
+        default:
+            return false;
+    }
+}
+
+const float* ModelLoader::get_layer_weights(const Layer& layer) const {
+    auto folded = folded_weights.find(&layer);
+    if (folded != folded_weights.end()) {
+        return folded->second.data();
+    }
+
+    if (parse_dtype(layer.dtype) == DType::Float32) {
+        return reinterpret_cast<const float*>(get_layer_data(layer));
     }
-    return conv_layers;
+    return nullptr;
 }
 
-std::vector<Layer> ModelLoader::get_fc_layers() const {
-    std::vector<Layer> fc_layers;
+TensorView ModelLoader::view_of(const Layer& layer) const {
+    if (const float* data = get_layer_weights(layer)) {
+        return TensorView(data, &layer);
+    }
+
+    DType dtype = parse_dtype(layer.dtype);
+    if (dtype == DType::Float32) {
+        return TensorView();               // 数据越界或文件中没有数据
+    }
+    size_t elem = dtype_size(dtype);
+    if (elem == 0) {
+        std::cerr << "未知数据类型: " << layer.name << " (" << layer.dtype << ")" << std::endl;
+        return TensorView();
+    }
+
+    // 低精度层：反量化到由视图持有的缓冲区，ModelLoader不保留副本（多个线程可同时调用）
+    auto values = std::make_shared<std::vector<float>>(layer.size_bytes / elem);
+    if (!dequantize(layer, values->data())) {
+        return TensorView();
+    }
+    return TensorView(std::move(values), &layer);
+}
+
+void ModelLoader::build_index() {
+    layer_index.clear();
+    activation_index.clear();
+    module_index.clear();
+    conv_index.clear();
+    fc_index.clear();
+    bias_index.clear();
+
+    layer_index.reserve(layers.size());
     for (const auto& layer : layers) {
+        layer_index.emplace(layer.name, &layer);
+
+        // 同一模块保留第一个参数层
+        module_index.emplace(layer.name.substr(0, layer.name.find('.')), &layer);
+
+        if (layer.type.find("conv") != std::string::npos) {
+            conv_index.push_back(&layer);
+        }
         if (layer.type.find("fc") != std::string::npos) {
-            fc_layers.push_back(layer);
+            fc_index.push_back(&layer);
+        }
+        if (layer.type == "bias") {
+            bias_index.push_back(&layer);
         }
     }
-    return fc_layers;
+
+    activation_index.reserve(activations.size());
+    for (const auto& tensor : activations) {
+        activation_index.emplace(tensor.name, &tensor);
+    }
 }
 
-std::vector<Layer> ModelLoader::get_bias_layers() const {
-    std::vector<Layer> bias_layers;
-    for (const auto& layer : layers) {
-        if (layer.type == "bias") {
-            bias_layers.push_back(layer);
+void ModelLoader::precompute_winograd() {
+    winograd_filters.clear();
+
+    for (const Layer* layer : conv_index) {
+        const std::vector<int>& shape = layer->shape;
+        if (shape.size() != 4 || shape[2] != 3 || shape[3] != 3) {
+            continue;
+        }
+        // 低精度权重只在变换期间反量化
+        TensorView view = view_of(*layer);
+        const float* weight = view.data();
+        if (!weight) {
+            continue;
         }
+
+        const int OC = shape[0];
+        const int C = shape[1];
+        WinogradFilters& filters = winograd_filters[layer];
+        filters.f2.resize(static_cast<size_t>(16) * C * OC);
+        filters.f4.resize(static_cast<size_t>(36) * C * OC);
+        kernels::winograd_transform_filter(weight, OC, C, 2, filters.f2.data());
+        kernels::winograd_transform_filter(weight, OC, C, 4, filters.f4.data());
+    }
+}
+
+const float* ModelLoader::get_winograd_filter(const Layer& layer, int m) const {
+    auto it = winograd_filters.find(&layer);
+    if (it == winograd_filters.end()) {
+        return nullptr;
     }
-    return bias_layers;
+    if (m == 2) return it->second.f2.data();
+    if (m == 4) return it->second.f4.data();
+    return nullptr;
 }
 
 const HotSpot* ModelLoader::get_hotspot(const std::string& name) const {
@@ -194,23 +717,40 @@ const HotSpot* ModelLoader::get_hotspot(const std::string& name) const {
     return it != hotspots.end() ? &it->second : nullptr;
 }
 
-sf::Vector2i ModelLoader::get_input_size() const {
+Vec2i ModelLoader::get_input_size() const {
     if (model_info.input_size.size() >= 3) {
-        return sf::Vector2i(model_info.input_size[2], model_info.input_size[1]);
+        return Vec2i{model_info.input_size[2], model_info.input_size[1]};
     }
-    return sf::Vector2i(64, 64);
+    return Vec2i{64, 64};
 }
 
 const Layer* ModelLoader::find_layer(const std::string& name) const {
-    for (const auto& layer : layers) {
-        if (layer.name == name) {
-            return &layer;
-        }
+    auto it = layer_index.find(name);
+    return it != layer_index.end() ? it->second : nullptr;
+}
+
+const Layer* ModelLoader::find_activation(const std::string& name) const {
+    auto it = activation_index.find(name);
+    return it != activation_index.end() ? it->second : nullptr;
+}
+
+const Layer* ModelLoader::find_module_layer(const std::string& module) const {
+    auto it = module_index.find(module);
+    return it != module_index.end() ? it->second : nullptr;
+}
+
+TensorView ModelLoader::get_tensor(const std::string& name) const {
+    const Layer* layer = find_layer(name);
+    if (!layer) {
+        layer = find_activation(name);
     }
-    return nullptr;
+    if (!layer) {
+        return TensorView();
+    }
+    return view_of(*layer);
 }
 
-bool ModelLoader::is_point_in_hotspot(const std::string& hotspot_name, const sf::Vector2f& point) const {
+bool ModelLoader::is_point_in_hotspot(const std::string& hotspot_name, const Vec2f& point) const {
     auto it = hotspots.find(hotspot_name);
     if (it == hotspots.end()) return false;
     
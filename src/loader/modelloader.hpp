@@ -3,16 +3,28 @@
 #include <string>
 #include <fstream>
 #include <unordered_map>
+#include <memory>
 #include <nlohmann/json.hpp>
-#include <SFML/System/Vector2.hpp>
-#include <SFML/Graphics.hpp>
+#include "loader/MappedFile.hpp"
+#include "loader/ModelContainer.hpp"
 
 using json = nlohmann::json;
 
+// 二维点/尺寸（加载器不依赖SFML，渲染端再转换为 sf::Vector2）
+struct Vec2f {
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+struct Vec2i {
+    int x = 0;
+    int y = 0;
+};
+
 // 热点区域数据结构
 struct HotSpot {
     std::string type;                 // "rect", "poly", "circle"
-    std::vector<sf::Vector2f> pts;    // 坐标点
+    std::vector<Vec2f> pts;           // 坐标点
     std::string description;          // 描述信息
 };
 
@@ -20,13 +32,99 @@ struct HotSpot {
 struct Layer {
     std::string name;
     std::vector<int> shape;
+    std::vector<int> strides;         // 元素步长（行优先）
     size_t offset = 0;
     size_t size_bytes = 0;
-    std::string dtype = "float32";
-    std::string type;                 // "conv_weight", "fc_weight", "bias", "parameter"
+    std::string dtype = "float32";    // "float32", "float16", "bfloat16", "int8"
+    size_t scale_offset = 0;          // int8：float32[shape[0]] 缩放系数的偏移
+    uint64_t checksum = 0;            // 容器张量表中的数据校验和，0 表示未提供（旧版 weights.bin）
+    std::string type;                 // "conv_weight", "fc_weight", "bias", "parameter", "activation"
     HotSpot hotspot;
 };
 
+// 张量元素类型
+enum class DType {
+    Float32,
+    Float16,
+    BFloat16,
+    Int8,        // 按第0维的对称量化，缩放系数见 Layer::scale_offset
+    Unknown
+};
+
+// 将元数据中的dtype字符串转换为枚举
+DType parse_dtype(const std::string& dtype);
+
+// 每个元素占用的字节数（未知类型返回0）
+size_t dtype_size(DType dtype);
+
+// 只读张量视图：float32 张量直接指向ModelLoader持有的映射数据，
+// 低精度张量在创建视图时反量化到视图持有的缓冲区（ModelLoader不缓存，拷贝视图共享该缓冲区，
+// 最后一个视图销毁时释放）；dtype() 为存储类型
+// 视图的生命周期不能超过创建它的ModelLoader
+class TensorView {
+public:
+    TensorView() = default;
+    TensorView(const float* data, const Layer* layer)
+        : data_(data), layer_(layer), dtype_(parse_dtype(layer->dtype)) {}
+    TensorView(std::shared_ptr<const std::vector<float>> values, const Layer* layer)
+        : data_(values->data()), layer_(layer), dtype_(parse_dtype(layer->dtype)), values_(std::move(values)) {}
+
+    bool valid() const { return data_ != nullptr && layer_ != nullptr; }
+    const float* data() const { return data_; }
+    const std::string& name() const { return layer_->name; }
+    const std::vector<int>& shape() const { return layer_->shape; }
+    const std::vector<int>& strides() const { return layer_->strides; }
+    DType dtype() const { return dtype_; }
+    int dim(size_t i) const { return i < layer_->shape.size() ? layer_->shape[i] : 1; }
+    int stride(size_t i) const { return i < layer_->strides.size() ? layer_->strides[i] : 1; }
+
+    size_t numel() const {
+        size_t n = 1;
+        for (int d : layer_->shape) n *= static_cast<size_t>(d);
+        return n;
+    }
+
+    // 沿第0维取第index个子张量（例如卷积权重的第index个卷积核）
+    const float* slice(int index) const {
+        if (!valid() || layer_->strides.empty() || index < 0 || index >= dim(0)) return nullptr;
+        return data_ + static_cast<size_t>(index) * layer_->strides[0];
+    }
+
+private:
+    const float* data_ = nullptr;
+    const Layer* layer_ = nullptr;
+    DType dtype_ = DType::Unknown;
+    std::shared_ptr<const std::vector<float>> values_;   // 低精度张量的反量化结果
+};
+
+// 按类型索引的层列表视图：只保存指针，遍历时不拷贝Layer
+class LayerSpan {
+public:
+    class iterator {
+    public:
+        explicit iterator(const Layer* const* p) : p_(p) {}
+        const Layer& operator*() const { return **p_; }
+        const Layer* operator->() const { return *p_; }
+        iterator& operator++() { ++p_; return *this; }
+        bool operator!=(const iterator& other) const { return p_ != other.p_; }
+        bool operator==(const iterator& other) const { return p_ == other.p_; }
+
+    private:
+        const Layer* const* p_;
+    };
+
+    explicit LayerSpan(const std::vector<const Layer*>& items) : items_(&items) {}
+
+    iterator begin() const { return iterator(items_->data()); }
+    iterator end() const { return iterator(items_->data() + items_->size()); }
+    size_t size() const { return items_->size(); }
+    bool empty() const { return items_->empty(); }
+    const Layer& operator[](size_t i) const { return *(*items_)[i]; }
+
+private:
+    const std::vector<const Layer*>* items_;
+};
+
 // 模型信息结构
 struct ModelInfo {
     std::vector<int> input_size;      // [1, 64, 64]
@@ -40,22 +138,59 @@ struct LayerStructure {
     std::string name;
     std::string type;
     std::unordered_map<std::string, int> parameters;
+    std::unordered_map<std::string, float> float_parameters;  // 浮点参数，如 BN 的 eps
+    std::unordered_map<std::string, std::string> attributes;  // 字符串属性，如 activation
 };
 
 class ModelLoader {
 public:
     std::vector<Layer> layers;
-    std::vector<char> weights;
+    std::vector<Layer> activations;   // 单文件容器中导出的参考激活值
     std::unordered_map<std::string, HotSpot> hotspots;
     ModelInfo model_info;
     std::vector<LayerStructure> structure;
 
     ModelLoader() = default;
 
+    // 权重数据指向内存映射区域，禁止拷贝
+    ModelLoader(const ModelLoader&) = delete;
+    ModelLoader& operator=(const ModelLoader&) = delete;
+
     bool load(const std::string& jsonPath, const std::string& binPath);
 
-    // 获取指定层的权重数据
+    // 加载单文件模型容器（model.bcnn），一次打开、一次映射
+    bool load_container(const std::string& path);
+
+    // 从模型目录加载：优先使用 model.bcnn，旧版导出的 model.json + weights.bin 作为后备
+    bool load_from_dir(const std::string& dir);
+
+    // 加载后变换：把每个 Conv -> BatchNorm 中的BN折叠进卷积权重和偏置
+    //   W' = W·γ/√(σ²+ε)，b' = (b − μ)·γ/√(σ²+ε) + β
+    // 折叠后的参数由ModelLoader持有，get_layer_weights / get_tensor 返回折叠后的值
+    // （get_layer_data 仍为文件中的原始数据），structure 中对应的 batchnorm2d 层被移除。
+    // 没有偏置的卷积按偏置为0折叠（补一个偏置层）。
+    // 任一BN缺少 running_mean/running_var 或 eps 时不做任何修改并返回 -1；
+    // allow_missing_stats 为真时改为按均值0、方差1、eps=1e-5 近似（结果与训练时的网络不同）。
+    // 需在共享给其他线程之前调用；返回折叠的BN层数
+    int fold_batchnorm(bool allow_missing_stats = false);
+
+    // 获取指定层的 float32 权重数据，生命周期与ModelLoader相同
+    // float32 直接指向映射文件，调用 fold_batchnorm() 后卷积层返回折叠后的权重；
+    // fp16/bf16/int8 层不常驻float副本，返回nullptr（使用 get_tensor 或 dequantize）
     const float* get_layer_weights(const Layer& layer) const;
+
+    // 获取指定层按存储类型排列的原始字节
+    const char* get_layer_data(const Layer& layer) const;
+
+    // int8 层的每通道缩放系数（其余类型返回nullptr）
+    const float* get_layer_scales(const Layer& layer) const;
+
+    // 将指定层反量化到 out（至少 numel 个float）
+    bool dequantize(const Layer& layer, float* out) const;
+
+    // 3×3 卷积权重的 Winograd 滤波器变换 U = G·g·Gᵀ，加载时预先计算
+    // m 为输出块大小（2 或 4），布局为 [α²][C][OC]（α = m + 2）；其余层返回nullptr
+    const float* get_winograd_filter(const Layer& layer, int m) const;
     
     // 获取指定层的权重数据（通过索引）
     const float* get_layer_weights(int index) const {
@@ -64,13 +199,13 @@ public:
     }
 
     // 获取卷积层
-    std::vector<Layer> get_conv_layers() const;
+    LayerSpan get_conv_layers() const { return LayerSpan(conv_index); }
 
     // 获取全连接层
-    std::vector<Layer> get_fc_layers() const;
+    LayerSpan get_fc_layers() const { return LayerSpan(fc_index); }
 
     // 获取偏置层
-    std::vector<Layer> get_bias_layers() const;
+    LayerSpan get_bias_layers() const { return LayerSpan(bias_index); }
 
     // 根据名称获取热点区域
     const HotSpot* get_hotspot(const std::string& name) const;
@@ -81,7 +216,7 @@ public:
     }
 
     // 获取模型输入尺寸
-    sf::Vector2i get_input_size() const;
+    Vec2i get_input_size() const;
 
     // 获取输出类别数量
     int get_num_classes() const {
@@ -106,6 +241,56 @@ public:
     // 根据名称查找层
     const Layer* find_layer(const std::string& name) const;
 
+    // 根据名称查找参考激活值（仅单文件容器提供）
+    const Layer* find_activation(const std::string& name) const;
+
+    // 按模块名查找该模块的第一个参数层（模块名为层名第一个'.'之前的部分，如 conv1）
+    const Layer* find_module_layer(const std::string& module) const;
+
+    // 按名称获取只读张量视图（参数层或参考激活值），找不到时返回无效视图；
+    // 低精度层每次调用都重新反量化，需要反复访问时保留视图
+    TensorView get_tensor(const std::string& name) const;
+
+    // 模型文件所在目录（用于查找导出的其他资源）
+    const std::string& get_model_dir() const { return model_dir; }
+
     // 检查点是否在热点区域内
-    bool is_point_in_hotspot(const std::string& hotspot_name, const sf::Vector2f& point) const;
+    bool is_point_in_hotspot(const std::string& hotspot_name, const Vec2f& point) const;
+
+    // 权重数据区（不含文件头）
+    const char* get_weights_data() const { return weights_data; }
+    size_t get_weights_size() const { return weights_size; }
+
+private:
+    std::string model_dir;
+    MappedFile weights_file;            // weights.bin 的只读映射
+    const char* weights_data = nullptr; // 权重数据起始位置（跳过文件头）
+    size_t weights_size = 0;            // 权重数据字节数
+
+    // 名称与类型索引，加载完成后由 build_index() 建立
+    // 指针指向 layers / activations 中的元素，加载后两者不再增删
+    // （唯一例外是 fold_batchnorm() 为无偏置卷积补层，之后立即重建索引）
+    std::unordered_map<std::string, const Layer*> layer_index;
+    std::unordered_map<std::string, const Layer*> activation_index;
+    std::unordered_map<std::string, const Layer*> module_index;
+    std::vector<const Layer*> conv_index;
+    std::vector<const Layer*> fc_index;
+    std::vector<const Layer*> bias_index;
+
+    // fold_batchnorm() 生成的卷积权重与偏置，优先于映射数据
+    std::unordered_map<const Layer*, std::vector<float>> folded_weights;
+
+    // Winograd 滤波器变换结果，由 precompute_winograd() 在加载完成后建立
+    struct WinogradFilters {
+        std::vector<float> f2;        // F(2×2, 3×3)，[16][C][OC]
+        std::vector<float> f4;        // F(4×4, 3×3)，[36][C][OC]
+    };
+    std::unordered_map<const Layer*, WinogradFilters> winograd_filters;
+
+    void reset();
+    void build_index();
+    void precompute_winograd();
+    TensorView view_of(const Layer& layer) const;
+    bool parse_metadata(const json& j);
+    bool map_weights(const std::string& binPath);
 };
\ No newline at end of file
@@ -3,9 +3,12 @@
 #include <imgui.h>
 
 #include "loader/ModelLoader.hpp"
+#include "loader/ModelWatcher.hpp"
 #include "renderer/BackgroundRenderer.hpp"
 #include "renderer/HotspotRenderer.hpp"
 #include "renderer/LayerDetailRenderer.hpp"
+#include "renderer/TextureStreamer.hpp"
+#include "renderer/convanim/AnimatorLoader.hpp"
 
 #include <iostream>
 #include <filesystem>
@@ -75,6 +78,35 @@ int main() {
 
 
 
+    // 检查资源文件是否存在
+    std::filesystem::path assetsDir = "assets";
+    if (!std::filesystem::exists(assetsDir)) {
+        std::cerr << "Assets directory not found!" << std::endl;
+        std::cerr << "Current path: " << std::filesystem::current_path() << std::endl;
+        return -1;
+    }
+
+    // 先发起图片解码请求，解码在工作线程中与字体、模型加载并行进行
+    TextureStreamer textureStreamer;
+
+    std::shared_ptr<const ModelLoader> model;
+    BackgroundRenderer backgroundRenderer;
+    HotspotRenderer hotspotRenderer;
+    hotspotRenderer.setWindow(&window);
+    LayerDetailRenderer layerDetailRenderer;
+
+    // 背景上传完成后更新布局并重新构建热点
+    backgroundRenderer.loadAsync(textureStreamer, "assets/textures/total_network.jpg", [&]() {
+        backgroundRenderer.updateLayout(window.getSize());
+        hotspotRenderer.build(*model, backgroundRenderer.getSprite());
+    });
+
+    // 加载详细结构纹理
+    layerDetailRenderer.loadTextureAsync(textureStreamer, "conv1", "assets/textures/conv1.jpg");
+    layerDetailRenderer.loadTextureAsync(textureStreamer, "conv2", "assets/textures/conv2.jpg");
+    layerDetailRenderer.loadTextureAsync(textureStreamer, "conv3", "assets/textures/conv3.jpg");
+    layerDetailRenderer.loadTextureAsync(textureStreamer, "conv4", "assets/textures/conv4.jpg");
+
     // 设置中文字体
     if (!setupChineseFont()) {
         std::cerr << "中文字体设置失败，继续使用默认字体" << std::endl;
@@ -96,53 +128,21 @@ int main() {
         }
     }
 
-
-
-
-    // 检查资源文件是否存在
-    std::filesystem::path assetsDir = "assets";
-    if (!std::filesystem::exists(assetsDir)) {
-        std::cerr << "Assets directory not found!" << std::endl;
-        std::cerr << "Current path: " << std::filesystem::current_path() << std::endl;
-        return -1;
-    }
-
-    // 加载模型
-    ModelLoader modelLoader;
-    std::string modelJsonPath = "assets/model/model.json";
-    std::string weightsBinPath = "assets/model/weights.bin";
-    
-    if (!modelLoader.load(modelJsonPath, weightsBinPath)) {
+    // 加载模型（优先使用单文件模型容器，旧版导出的 json + bin 作为后备）
+    std::string modelDir = "assets/model";
+    auto loadedModel = std::make_shared<ModelLoader>();
+    if (!loadedModel->load_from_dir(modelDir)) {
         std::cerr << "Failed to load model!" << std::endl;
         return -1;
     }
+    model = loadedModel;
     std::cout << "Model loaded successfully!" << std::endl;
+    layerDetailRenderer.setModel(model);
 
-    // 加载背景
-    BackgroundRenderer backgroundRenderer;
-    std::string backgroundPath = "assets/textures/total_network.jpg";
-    
-    if (!backgroundRenderer.load(backgroundPath)) {
-        std::cerr << "Failed to load background! Using fallback..." << std::endl;
-    }
+    // 监视模型目录，重新导出后自动热重载
+    ModelWatcher modelWatcher;
+    modelWatcher.start(modelDir, model);
 
-    // 初始化热点渲染器
-    HotspotRenderer hotspotRenderer;
-    hotspotRenderer.setWindow(&window);
-    hotspotRenderer.build(modelLoader, backgroundRenderer.getSprite());
-
-    // 更新布局
-    backgroundRenderer.updateLayout(window.getSize());
-
-    // 初始化图层详细渲染器
-    LayerDetailRenderer layerDetailRenderer;
-    
-    // 加载详细结构纹理
-    layerDetailRenderer.loadTexture("conv1", "assets/textures/conv1.jpg");
-    layerDetailRenderer.loadTexture("conv2", "assets/textures/conv2.jpg"); 
-    layerDetailRenderer.loadTexture("conv3", "assets/textures/conv3.jpg");
-    layerDetailRenderer.loadTexture("conv4", "assets/textures/conv4.jpg");
-    
     // 设置热点渲染器
     hotspotRenderer.setLayerDetailRenderer(&layerDetailRenderer);
 
@@ -176,7 +176,7 @@ int main() {
                 backgroundRenderer.setView(newView);
     
                 // 重新构建热点
-                hotspotRenderer.build(modelLoader, backgroundRenderer.getSprite());
+                hotspotRenderer.build(*model, backgroundRenderer.getSprite());
             }
             else if (event.type == sf::Event::KeyPressed) {
                 if (event.key.code == sf::Keyboard::Escape) {
@@ -188,6 +188,18 @@ int main() {
             }
         }
 
+        // 模型热重载：在帧与帧之间替换快照，只重建变化模块对应的面板
+        ModelWatcher::Update modelUpdate;
+        if (modelWatcher.poll(modelUpdate)) {
+            model = modelUpdate.model;
+            layerDetailRenderer.setModel(model, modelUpdate.changedModules);
+            hotspotRenderer.build(*model, backgroundRenderer.getSprite());
+            std::cout << "模型已热重载，变化模块数: " << modelUpdate.changedModules.size() << std::endl;
+        }
+
+        // 上传已解码的纹理（每帧最多占用约4ms）
+        textureStreamer.pump(sf::milliseconds(4));
+
         // 更新ImGui
         ImGui::SFML::Update(window, deltaClock.restart());
 
@@ -216,11 +228,11 @@ int main() {
         // ImGUI 界面
         ImGui::Begin("校徽分类器控制面板");
         
-        ImGui::Text("模型信息: %s", modelLoader.get_description().c_str());
+        ImGui::Text("模型信息: %s", model->get_description().c_str());
         ImGui::Text("输入尺寸: %dx%d", 
-                   modelLoader.get_input_size().x, modelLoader.get_input_size().y);
-        ImGui::Text("输出类别: %d", modelLoader.get_num_classes());
-        ImGui::Text("网络总层数: %zu", modelLoader.get_num_layers());
+                   model->get_input_size().x, model->get_input_size().y);
+        ImGui::Text("输出类别: %d", model->get_num_classes());
+        ImGui::Text("网络总层数: %zu", model->get_num_layers());
         ImGui::Separator();
         
         ImGui::Separator();
@@ -242,7 +254,8 @@ int main() {
         window.display();
     }
 
-    // 关闭ImGui
+    // 等待卷积动画的后台加载线程结束，再关闭ImGui
+    AnimatorLoader::waitForAll();
     ImGui::SFML::Shutdown();
 
     return 0;
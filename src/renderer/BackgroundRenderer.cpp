@@ -11,9 +11,7 @@ bool BackgroundRenderer::load(const std::string& pngPath) {
         return false;
     }
     
-    tex.setSmooth(true);
-    spr.setTexture(tex);
-    imgSize = sf::Vector2f(tex.getSize().x, tex.getSize().y);
+    onTextureReady();
     
     std::cout << "背景图片加载成功: " << pngPath << std::endl;
     std::cout << "图片尺寸: " << imgSize.x << " x " << imgSize.y << std::endl;
@@ -21,6 +19,27 @@ bool BackgroundRenderer::load(const std::string& pngPath) {
     return true;
 }
 
+void BackgroundRenderer::loadAsync(TextureStreamer& streamer, const std::string& pngPath,
+                                   std::function<void()> onLoaded) {
+    streamer.request(pngPath, tex, [this, pngPath, onLoaded](bool ok) {
+        if (!ok) {
+            std::cerr << "无法加载背景图片: " << pngPath << std::endl;
+            return;
+        }
+        onTextureReady();
+        std::cout << "背景图片加载成功: " << pngPath << std::endl;
+        if (onLoaded) {
+            onLoaded();
+        }
+    });
+}
+
+void BackgroundRenderer::onTextureReady() {
+    tex.setSmooth(true);
+    spr.setTexture(tex, true);
+    imgSize = sf::Vector2f(tex.getSize().x, tex.getSize().y);
+}
+
 void BackgroundRenderer::updateLayout(const sf::Vector2u& winSize) {
     if (imgSize.x == 0 || imgSize.y == 0) return;
     
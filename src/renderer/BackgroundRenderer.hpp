@@ -1,5 +1,7 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "renderer/TextureStreamer.hpp"
+#include <functional>
 #include <string>
 
 class BackgroundRenderer {
@@ -8,6 +10,13 @@ public:
     
     // 加载背景图片
     bool load(const std::string& pngPath);
+
+    // 通过异步管线加载背景图片，上传完成后在渲染线程调用 onLoaded
+    void loadAsync(TextureStreamer& streamer, const std::string& pngPath,
+                   std::function<void()> onLoaded = nullptr);
+
+    // 背景纹理是否已就绪
+    bool isLoaded() const { return imgSize.x > 0 && imgSize.y > 0; }
     
     // 根据当前窗口大小重新计算缩放和居中
     void updateLayout(const sf::Vector2u& winSize);
@@ -41,6 +50,9 @@ public:
     sf::Vector2f getScale() const { return spr.getScale(); }
 
 private:
+    // 纹理就绪后设置精灵和尺寸
+    void onTextureReady();
+
     sf::Texture tex;
     sf::Sprite spr;
     sf::View view;
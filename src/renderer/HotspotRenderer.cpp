@@ -8,7 +8,6 @@ void HotspotRenderer::build(const ModelLoader& modelLoader, const sf::Sprite& ba
     
     // 获取热点数据
     const auto& hotspots = modelLoader.get_all_hotspots();
-    const auto& layers = modelLoader.layers;
     
     // 构建热点形状
     for (const auto& [name, hotspot] : hotspots) {
@@ -30,12 +29,9 @@ void HotspotRenderer::build(const ModelLoader& modelLoader, const sf::Sprite& ba
         hotspotShapes.emplace_back(name, std::move(shape));
         hotspotDescriptions[name] = hotspot.description;
         
-        // 关联热点和对应的层
-        for (const auto& layer : layers) {
-            if (layer.name.find(name) != std::string::npos) {
-                hotspotToLayer[name] = &layer;
-                break;
-            }
+        // 关联热点和对应的层（热点名即模块名，如 conv1 -> conv1.0.weight）
+        if (const Layer* layer = modelLoader.find_module_layer(name)) {
+            hotspotToLayer[name] = layer;
         }
     }
     
@@ -48,18 +44,18 @@ void HotspotRenderer::build(const ModelLoader& modelLoader, const sf::Sprite& ba
     showDetailButtons_["conv4"] = true;
 }
 
-sf::ConvexShape HotspotRenderer::createRectShape(const std::vector<sf::Vector2f>& pts, const sf::Transform& transform) {
+sf::ConvexShape HotspotRenderer::createRectShape(const std::vector<Vec2f>& pts, const sf::Transform& transform) {
     sf::ConvexShape rect(4);
     for (size_t i = 0; i < 4; ++i) {
-        rect.setPoint(i, transform.transformPoint(pts[i]));
+        rect.setPoint(i, transform.transformPoint(sf::Vector2f(pts[i].x, pts[i].y)));
     }
     return rect;
 }
 
-sf::ConvexShape HotspotRenderer::createPolyShape(const std::vector<sf::Vector2f>& pts, const sf::Transform& transform) {
+sf::ConvexShape HotspotRenderer::createPolyShape(const std::vector<Vec2f>& pts, const sf::Transform& transform) {
     sf::ConvexShape poly(pts.size());
     for (size_t i = 0; i < pts.size(); ++i) {
-        poly.setPoint(i, transform.transformPoint(pts[i]));
+        poly.setPoint(i, transform.transformPoint(sf::Vector2f(pts[i].x, pts[i].y)));
     }
     return poly;
 }
@@ -55,10 +55,10 @@ private:
     std::unordered_map<std::string, std::string> hotspotDescriptions;
     
     // 创建矩形热点形状
-    sf::ConvexShape createRectShape(const std::vector<sf::Vector2f>& pts, const sf::Transform& transform);
+    sf::ConvexShape createRectShape(const std::vector<Vec2f>& pts, const sf::Transform& transform);
     
     // 创建多边形热点形状
-    sf::ConvexShape createPolyShape(const std::vector<sf::Vector2f>& pts, const sf::Transform& transform);
+    sf::ConvexShape createPolyShape(const std::vector<Vec2f>& pts, const sf::Transform& transform);
     
     // 绘制详细结构按钮
     void drawDetailButton(const std::string& hotspotName, const sf::ConvexShape& shape);
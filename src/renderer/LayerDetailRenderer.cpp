@@ -1,5 +1,4 @@
 #include "renderer/LayerDetailRenderer.hpp"
-#include "renderer/LayerDetailRenderer.hpp"
 #include "renderer/detail/Conv1Detail.hpp"
 #include "renderer/detail/Conv2Detail.hpp"
 #include "renderer/detail/Conv3Detail.hpp"
@@ -13,7 +12,13 @@ void LayerDetailRenderer::createDetailRenderer(const std::string& layerName) {
         return;
     }
     
+    if (!model_) {
+        std::cerr << "错误: 模型尚未加载，无法创建 " << layerName << std::endl;
+        return;
+    }
+    
     std::cout << "创建detailRenderer: " << layerName << std::endl;
+    layers_[layerName].model = model_;
     
     if (layerName == "conv1") {
         layers_[layerName].detailRenderer = std::make_unique<Conv1Detail>();
@@ -27,7 +32,7 @@ void LayerDetailRenderer::createDetailRenderer(const std::string& layerName) {
     
     // 初始化详细交互器
     if (layers_[layerName].detailRenderer) {
-        if (layers_[layerName].detailRenderer->initialize()) {
+        if (layers_[layerName].detailRenderer->initialize(layers_[layerName].model)) {
             std::cout << layerName << " detailRenderer初始化成功" << std::endl;
             std::cout << "  热点数量: " << layers_[layerName].detailRenderer->getHotspotCount() << std::endl;
         } else {
@@ -52,10 +57,27 @@ LayerDetailRenderer::LayerDetailRenderer() {
     layers_["conv4"] = LayerDetail();
     layers_["conv4"].title = "第四卷积层详细结构";
 
-    createDetailRenderer("conv1");
-    createDetailRenderer("conv2"); 
-    createDetailRenderer("conv3");
-    createDetailRenderer("conv4");
+    // 详细交互器在首次打开对应窗口时才创建（见setVisible）
+}
+
+void LayerDetailRenderer::setModel(std::shared_ptr<const ModelLoader> model,
+                                   const std::unordered_set<std::string>& changedModules) {
+    model_ = std::move(model);
+
+    bool activationsChanged = changedModules.count("activations") > 0;
+    for (auto& [layerName, detail] : layers_) {
+        if (!detail.detailRenderer) continue;
+        if (!activationsChanged && changedModules.count(layerName) == 0) continue;
+
+        std::cout << "模型已更新，重建detailRenderer: " << layerName << std::endl;
+        detail.detailRenderer.reset();
+        detail.model.reset();
+
+        // 正在显示的窗口立即重建，其余在下次打开时创建
+        if (detail.visible) {
+            createDetailRenderer(layerName);
+        }
+    }
 }
 
 bool LayerDetailRenderer::loadTexture(const std::string& layerName, const std::string& texturePath) {
@@ -69,14 +91,37 @@ bool LayerDetailRenderer::loadTexture(const std::string& layerName, const std::s
         return false;
     }
 
+    layers_[layerName].textureReady = true;
     std::cout << "加载详细结构纹理: " << texturePath << std::endl;
     return true;
 }
 
+bool LayerDetailRenderer::loadTextureAsync(TextureStreamer& streamer, const std::string& layerName,
+                                           const std::string& texturePath) {
+    auto it = layers_.find(layerName);
+    if (it == layers_.end()) {
+        std::cerr << "未知的图层: " << layerName << std::endl;
+        return false;
+    }
+
+    // unordered_map 的元素地址在插入后保持不变，可以直接作为上传目标
+    LayerDetail& detail = it->second;
+    detail.textureReady = false;
+    streamer.request(texturePath, detail.texture, [&detail](bool ok) {
+        detail.textureReady = ok;
+    });
+    return true;
+}
+
 void LayerDetailRenderer::setVisible(const std::string& layerName, bool visible) {
     if (layers_.find(layerName) != layers_.end()) {
         if (!layers_[layerName].visible && visible) {
             layers_[layerName].justOpened = true;
+            
+            // 延迟创建详细交互器
+            if (!layers_[layerName].detailRenderer) {
+                createDetailRenderer(layerName);
+            }
         }
         layers_[layerName].visible = visible;
     }
@@ -138,12 +183,16 @@ void LayerDetailRenderer::drawDetailWindow(const std::string& layerName, LayerDe
         detail.contentSize = ImGui::GetContentRegionAvail();
         detail.imagePos = ImGui::GetCursorScreenPos();
         
-        // 显示背景图片
-        ImGui::Image(
-            (void*)(intptr_t)detail.texture.getNativeHandle(),
-            contentSize,
-            ImVec2(0, 0), ImVec2(1, 1)
-        );
+        // 显示背景图片（纹理尚未上传完成时只占位）
+        if (detail.textureReady) {
+            ImGui::Image(
+                (void*)(intptr_t)detail.texture.getNativeHandle(),
+                contentSize,
+                ImVec2(0, 0), ImVec2(1, 1)
+            );
+        } else {
+            ImGui::Dummy(contentSize);
+        }
         
         // 绘制热点
         if (detail.detailRenderer) {
@@ -1,15 +1,27 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <imgui.h>
+#include <memory>
 #include <string>
+#include <unordered_set>
 #include "renderer/detail/ConvDetailBase.hpp"
+#include "renderer/TextureStreamer.hpp"
 
 class LayerDetailRenderer {
 public:
-    LayerDetailRenderer() ;
+    LayerDetailRenderer();
+
+    // 设置模型快照；changedModules 中的模块（或参考激活值变化时全部）对应的
+    // 详细交互器会被丢弃并用新快照重建，其余继续使用各自创建时的快照
+    void setModel(std::shared_ptr<const ModelLoader> model,
+                  const std::unordered_set<std::string>& changedModules = {});
 
     // 加载图层详细背景图
     bool loadTexture(const std::string& layerName, const std::string& texturePath);
+
+    // 通过异步管线加载图层详细背景图（解码在工作线程，上传在渲染线程）
+    bool loadTextureAsync(TextureStreamer& streamer, const std::string& layerName,
+                          const std::string& texturePath);
     
     // 设置弹窗显示状态
     void setVisible(const std::string& layerName, bool visible);
@@ -34,11 +46,16 @@ public:
     void handleButtons();
 
 private:
+    std::shared_ptr<const ModelLoader> model_;
+
     struct LayerDetail {
         sf::Texture texture;
+        bool textureReady = false;
         bool visible = false;
         bool justOpened = false;
         std::string title;
+        // 详细交互器创建时使用的模型快照（交互器及其后台加载任务另外持有引用）
+        std::shared_ptr<const ModelLoader> model;
         std::unique_ptr<ConvDetailBase> detailRenderer;
 
         // 保存窗口信息
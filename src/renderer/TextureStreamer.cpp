@@ -0,0 +1,129 @@
+#include "renderer/TextureStreamer.hpp"
+#include <algorithm>
+#include <iostream>
+
+TextureStreamer::TextureStreamer(unsigned workerCount) {
+    if (workerCount == 0) {
+        workerCount = 1;
+    }
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers_.emplace_back(&TextureStreamer::workerLoop, this);
+    }
+}
+
+TextureStreamer::~TextureStreamer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void TextureStreamer::request(const std::string& path, sf::Texture& target, Callback onReady) {
+    auto job = std::make_unique<Job>();
+    job->path = path;
+    job->target = &target;
+    job->onReady = std::move(onReady);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        decodeQueue_.push_back(std::move(job));
+        ++outstanding_;
+    }
+    cv_.notify_one();
+}
+
+void TextureStreamer::workerLoop() {
+    for (;;) {
+        std::unique_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !decodeQueue_.empty(); });
+            if (stopping_) {
+                return;
+            }
+            job = std::move(decodeQueue_.front());
+            decodeQueue_.pop_front();
+        }
+
+        // 解码只涉及CPU内存，可以在工作线程中完成
+        job->decoded = job->image.loadFromFile(job->path);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        uploadQueue_.push_back(std::move(job));
+    }
+}
+
+void TextureStreamer::pump(sf::Time budget) {
+    sf::Clock clock;
+
+    for (;;) {
+        Job* job = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (uploadQueue_.empty()) {
+                return;
+            }
+            job = uploadQueue_.front().get();
+        }
+
+        if (!job->decoded) {
+            std::cerr << "无法加载纹理: " << job->path << std::endl;
+            finishFront(false);
+            continue;
+        }
+
+        sf::Vector2u size = job->image.getSize();
+        if (!job->created) {
+            if (!job->target->create(size.x, size.y)) {
+                std::cerr << "无法创建纹理: " << job->path << std::endl;
+                finishFront(false);
+                continue;
+            }
+            job->created = true;
+        }
+
+        // 按条带上传，超出预算就留到下一帧
+        const sf::Uint8* pixels = job->image.getPixelsPtr();
+        while (job->uploadedRows < size.y) {
+            unsigned rows = std::min(kRowsPerBand, size.y - job->uploadedRows);
+            job->target->update(pixels + static_cast<size_t>(job->uploadedRows) * size.x * 4,
+                                size.x, rows, 0, job->uploadedRows);
+            job->uploadedRows += rows;
+
+            if (job->uploadedRows < size.y && clock.getElapsedTime() >= budget) {
+                return;
+            }
+        }
+
+        std::cout << "纹理加载完成: " << job->path
+                  << " (" << size.x << " x " << size.y << ")" << std::endl;
+        finishFront(true);
+
+        if (clock.getElapsedTime() >= budget) {
+            return;
+        }
+    }
+}
+
+void TextureStreamer::finishFront(bool ok) {
+    // 先出队再回调，回调中可以继续发起新的请求
+    std::unique_ptr<Job> done;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done = std::move(uploadQueue_.front());
+        uploadQueue_.pop_front();
+        --outstanding_;
+    }
+    if (done->onReady) {
+        done->onReady(ok);
+    }
+}
+
+bool TextureStreamer::idle() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return outstanding_ == 0;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 异步纹理加载管线
+// 工作线程把 JPEG/PNG 解码为 sf::Image（纯CPU，不涉及OpenGL），
+// 渲染线程每帧在 pump() 中按时间预算分条带上传到纹理，
+// 这样图片解码可以与模型加载、字体图集构建并行进行。
+class TextureStreamer {
+public:
+    // 加载完成回调（在渲染线程中调用），ok 表示解码与上传是否成功
+    using Callback = std::function<void(bool ok)>;
+
+    explicit TextureStreamer(unsigned workerCount = 2);
+    ~TextureStreamer();
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    // 请求把图片加载到 target 中；target 必须在加载完成前保持有效
+    void request(const std::string& path, sf::Texture& target, Callback onReady = nullptr);
+
+    // 在渲染线程每帧调用，上传耗时不超过 budget（至少上传一个条带）
+    void pump(sf::Time budget);
+
+    // 所有请求是否都已完成
+    bool idle() const;
+
+private:
+    struct Job {
+        std::string path;
+        sf::Texture* target = nullptr;
+        Callback onReady;
+        sf::Image image;
+        bool decoded = false;
+        unsigned uploadedRows = 0;
+        bool created = false;
+    };
+
+    void workerLoop();
+    // 完成上传队列队首的任务并调用回调
+    void finishFront(bool ok);
+
+    // 每次上传的行数
+    static constexpr unsigned kRowsPerBand = 64;
+
+    std::vector<std::thread> workers_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::unique_ptr<Job>> decodeQueue_;   // 等待解码
+    std::deque<std::unique_ptr<Job>> uploadQueue_;   // 已解码，等待上传
+    size_t outstanding_ = 0;                         // 尚未完成的请求数
+    bool stopping_ = false;
+};
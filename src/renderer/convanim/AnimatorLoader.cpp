@@ -0,0 +1,69 @@
+#include "renderer/convanim/AnimatorLoader.hpp"
+#include "renderer/convanim/ConvAnimPanel.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// 进行中的后台加载线程数
+std::mutex inFlightMutex;
+std::condition_variable inFlightDone;
+int inFlight = 0;
+
+} // namespace
+
+void AnimatorLoader::request(std::shared_ptr<const ModelLoader> model) {
+    if (animator_ || pending_.valid() || failed_) {
+        return;
+    }
+
+    std::cout << "后台加载conv" << layer_ << "卷积动画..." << std::endl;
+
+    // std::async 返回的future析构时会等待任务结束，这里改用分离线程 + promise
+    int layer = layer_;
+    std::promise<std::unique_ptr<ConvAnimBase>> promise;
+    pending_ = promise.get_future();
+    {
+        std::lock_guard<std::mutex> lock(inFlightMutex);
+        ++inFlight;
+    }
+    std::thread([layer, model = std::move(model), promise = std::move(promise)]() mutable {
+        {
+            // 模型快照和promise在计数减一之前释放，waitForAll 返回后线程不再访问任何共享对象
+            std::shared_ptr<const ModelLoader> snapshot = std::move(model);
+            std::promise<std::unique_ptr<ConvAnimBase>> result = std::move(promise);
+            std::unique_ptr<ConvAnimBase> anim = ConvAnimPanel::createAnimator(layer);
+            if (anim && !anim->load(*snapshot)) {
+                anim.reset();
+            }
+            result.set_value(std::move(anim));
+        }
+        std::lock_guard<std::mutex> lock(inFlightMutex);
+        if (--inFlight == 0) {
+            inFlightDone.notify_all();
+        }
+    }).detach();
+}
+
+void AnimatorLoader::waitForAll() {
+    std::unique_lock<std::mutex> lock(inFlightMutex);
+    inFlightDone.wait(lock, [] { return inFlight == 0; });
+}
+
+bool AnimatorLoader::poll() {
+    if (pending_.valid() &&
+        pending_.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        animator_ = pending_.get();
+        if (animator_) {
+            // 纹理必须在渲染线程创建
+            animator_->initTextures();
+        } else {
+            failed_ = true;
+            std::cerr << "conv" << layer_ << "卷积动画加载失败" << std::endl;
+        }
+    }
+    return animator_ != nullptr;
+}
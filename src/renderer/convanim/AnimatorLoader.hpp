@@ -0,0 +1,34 @@
+#pragma once
+#include "renderer/convanim/ConvAnimBase.hpp"
+#include <future>
+#include <memory>
+
+// 卷积动画的延迟加载器
+// 第一次请求时才在后台线程构建动画器并执行load()（图片解码、权重读取、卷积计算），
+// 完成后由渲染线程在poll()中创建纹理。
+// 后台线程是分离的并持有模型快照：加载完成前销毁加载器（如热重载时丢弃面板）不会等待，
+// 线程结束时结果随之释放。进行中的线程数全局计数，程序退出前须调用 waitForAll()，
+// 避免线程在静态对象析构之后仍在运行。
+class AnimatorLoader {
+public:
+    explicit AnimatorLoader(int layer) : layer_(layer) {}
+
+    // 请求加载（只有第一次调用会启动后台任务）
+    void request(std::shared_ptr<const ModelLoader> model);
+
+    // 在渲染线程每帧调用；返回动画器是否已可用
+    bool poll();
+
+    // 等待所有后台加载线程结束（查看器退出时调用）
+    static void waitForAll();
+
+    bool isLoading() const { return pending_.valid(); }
+    bool failed() const { return failed_; }
+    ConvAnimBase* get() const { return animator_.get(); }
+
+private:
+    int layer_;
+    std::future<std::unique_ptr<ConvAnimBase>> pending_;   // 来自 std::promise，析构时不阻塞
+    std::unique_ptr<ConvAnimBase> animator_;
+    bool failed_ = false;
+};
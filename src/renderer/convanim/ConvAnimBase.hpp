@@ -2,14 +2,19 @@
 #include <SFML/Graphics.hpp>
 #include <imgui.h>
 #include <vector>
+#include "loader/ModelLoader.hpp"
 #include <string>
 
 class ConvAnimBase {
 public:
     virtual ~ConvAnimBase() = default;
     
-    // 加载数据
-    virtual bool load(const std::string& modelDir) = 0;
+    // 加载数据（权重和参考激活值从共享的ModelLoader中按名称获取）
+    // 只做CPU端工作，不访问GL资源，可以在后台线程调用
+    virtual bool load(const ModelLoader& model) = 0;
+
+    // 创建并上传纹理，必须在渲染线程、load()成功之后调用
+    virtual void initTextures() = 0;
     
     // 动画控制
     virtual void play() = 0;
@@ -18,6 +23,7 @@ public:
     virtual void update(float dt) = 0;
     
     virtual void step() = 0;                           // 单步执行
+    virtual void seek(int position) = 0;               // 跳到第 position 个输出位置（行优先，从0开始）
     virtual void setAnimationSpeed(float speed) = 0;  
     virtual float getAnimationSpeed() const = 0;
            
@@ -28,9 +34,16 @@ public:
     
     // 获取纹理
     virtual const sf::Texture& getInputTexture() const = 0;
-    virtual const sf::Texture& getKernelTexture() const = 0;
+    virtual const sf::Texture& getKernelTexture() const = 0;       // 配合 getKernelUV 显示卷积窗口覆盖的输入
     virtual const sf::Texture& getOutputTexture() const = 0;
     virtual const sf::Texture& getKernelFrameTexture() const = 0;
+    // 纹理都是静态的，位置变化只改变纹理坐标，高亮和光标由面板叠加绘制
+    // 选中的输入通道在 getKernelFrameTexture()（输入图集）中的纹理坐标
+    virtual void getInputUV(ImVec2& uv0, ImVec2& uv1) const = 0;
+    // 卷积窗口覆盖的输入在 getKernelTexture() 中的纹理坐标
+    virtual void getKernelUV(ImVec2& uv0, ImVec2& uv1) const = 0;
+    // 当前卷积核的输出在输出纹理（图集）中的纹理坐标
+    virtual void getOutputUV(ImVec2& uv0, ImVec2& uv1) const = 0;
     
     // 获取当前参数
     virtual float getDotProduct() const = 0;
@@ -51,6 +64,17 @@ public:
     virtual int getNumKernels() const = 0;       // 获取卷积核数量
     virtual int getKernelIndex() const = 0;      // 获取当前索引
     virtual void setKernelIndex(int index) = 0;  // 设置卷积核索引
+
+    // 输入通道相关：点积对全部输入通道求和，显示的输入特征图和3×3权重属于选中的通道
+    virtual int getNumInputChannels() const = 0;
+    virtual int getInputChannel() const = 0;
+    virtual void setInputChannel(int channel) = 0;
+    virtual const std::vector<float>& getChannelContributions() const = 0;  // 当前位置各输入通道的贡献
+    virtual const std::vector<float>& getPartialSums() const = 0;           // 贡献的累计部分和
+
+    // 逐步显示输出（只显示已经计算到的位置）
+    virtual void setProgressiveOutput(bool enabled) = 0;
+    virtual bool isProgressiveOutput() const = 0;
     
     
 };
\ No newline at end of file
@@ -1,6 +1,51 @@
 #include "renderer/convanim/ConvAnimPanel.hpp"
+#include <algorithm>
+#include <cfloat>
 #include <iostream>
 
+namespace {
+
+// 叠加层：纹理保持不变，卷积窗口、网格线和输出光标画在 ImGui::Image 之上，移动时不需要上传纹理
+// 图像刚绘制完，GetItemRect 即为它的屏幕区域；cols × rows 为图像对应的格数
+struct ImageGrid {
+    ImVec2 origin;
+    float cellW = 0;
+    float cellH = 0;
+
+    ImageGrid(int cols, int rows) : origin(ImGui::GetItemRectMin()) {
+        ImVec2 max = ImGui::GetItemRectMax();
+        cellW = (max.x - origin.x) / cols;
+        cellH = (max.y - origin.y) / rows;
+    }
+    // 格子 (x, y) 的左上角
+    ImVec2 at(float x, float y) const { return ImVec2(origin.x + x * cellW, origin.y + y * cellH); }
+};
+
+const ImU32 kHighlightColor = IM_COL32(255, 255, 0, 255);
+const ImU32 kHighlightFill = IM_COL32(255, 255, 0, 80);
+const ImU32 kGridColor = IM_COL32(128, 128, 128, 90);
+const ImU32 kPendingColor = IM_COL32(32, 32, 48, 255);
+
+// 格子足够大时才画网格线，否则只会把图像盖住
+void drawGridLines(const ImageGrid& grid, int cols, int rows) {
+    if (grid.cellW < 6.0f || grid.cellH < 6.0f) return;
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    for (int x = 1; x < cols; ++x) {
+        drawList->AddLine(grid.at(x, 0), grid.at(x, rows), kGridColor);
+    }
+    for (int y = 1; y < rows; ++y) {
+        drawList->AddLine(grid.at(0, y), grid.at(cols, y), kGridColor);
+    }
+}
+
+void drawHighlightRect(const ImageGrid& grid, int x, int y, int w, int h) {
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    drawList->AddRectFilled(grid.at(x, y), grid.at(x + w, y + h), kHighlightFill);
+    drawList->AddRect(grid.at(x, y), grid.at(x + w, y + h), kHighlightColor, 0.0f, 0, 2.0f);
+}
+
+} // namespace
+
 std::unique_ptr<ConvAnimBase> ConvAnimPanel::createAnimator(int layer) {
         switch (layer) {
         case 1: return std::make_unique<Conv1Anim>();
@@ -64,6 +109,23 @@ void ConvAnimPanel::show(const std::string& title, bool* open,
     ImGui::End();
 }
 
+void ConvAnimPanel::showLoading(const std::string& title, bool* open, bool failed) {
+    ImGui::SetNextWindowSize(ImVec2(1000, 600), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowPos(ImVec2(100, 100), ImGuiCond_FirstUseEver);
+    
+    if (ImGui::Begin(title.c_str(), open, ImGuiWindowFlags_NoCollapse)) {
+        if (failed) {
+            ImGui::Text("卷积动画加载失败，请检查模型与图片资源");
+        } else {
+            // 简单的加载指示
+            const char* dots[] = {"", ".", "..", "..."};
+            int phase = static_cast<int>(ImGui::GetTime() * 3.0f) % 4;
+            ImGui::Text("正在加载卷积动画%s", dots[phase]);
+        }
+    }
+    ImGui::End();
+}
+
 void ConvAnimPanel::showInputWindow(ConvAnimBase& anim, const char* id) {
     ImGui::Text("输入特征图");
     ImGui::Separator();
@@ -77,15 +139,34 @@ void ConvAnimPanel::showInputWindow(ConvAnimBase& anim, const char* id) {
     int curY = anim.getCurrentY();
     int kernelSize = anim.getKernelSize();
     
-    // 显示输入纹理
+    // 显示输入纹理（输入图集中选中的通道）
+    ImVec2 uv0, uv1;
+    anim.getInputUV(uv0, uv1);
     ImGui::Image(
         (void*)(intptr_t)anim.getKernelFrameTexture().getNativeHandle(),
         inputSize,
-        ImVec2(0, 0), ImVec2(1, 1)
+        uv0, uv1
     );
+
+    // 叠加网格线和当前卷积窗口
+    int padW = anim.getInputWidth() + 2;
+    int padH = anim.getInputHeight() + 2;
+    ImageGrid grid(padW, padH);
+    drawGridLines(grid, padW, padH);
+    drawHighlightRect(grid, curX, curY, kernelSize, kernelSize);
     
     // 显示当前卷积位置
     ImGui::Text("当前卷积位置: (%d, %d)", curX+1, curY+1);
+
+    // 多输入通道时选择显示的通道（点积始终对全部通道求和）
+    int numChannels = anim.getNumInputChannels();
+    if (numChannels > 1) {
+        int displayChannel = anim.getInputChannel() + 1;
+        ImGui::SetNextItemWidth(inputSize.x);
+        if (ImGui::SliderInt("##input_channel", &displayChannel, 1, numChannels, "输入通道 #%d")) {
+            anim.setInputChannel(displayChannel - 1);
+        }
+    }
 }
 
 void ConvAnimPanel::showKernelWindow(ConvAnimBase& anim, const char* id) {
@@ -95,19 +176,26 @@ void ConvAnimPanel::showKernelWindow(ConvAnimBase& anim, const char* id) {
     int kernelSize = anim.getKernelSize();
     ImGui::Text("尺寸: %d × %d", kernelSize, kernelSize);
     
-    // 显示卷积核纹理
+    // 显示卷积窗口覆盖的输入（输入纹理的一部分）
     ImVec2 kernelSizeV(kernelSize * 10, kernelSize * 10);
+    ImVec2 uv0, uv1;
+    anim.getKernelUV(uv0, uv1);
     ImGui::Image(
         (void*)(intptr_t)anim.getKernelTexture().getNativeHandle(),
         kernelSizeV,
-        ImVec2(0, 0), ImVec2(1, 1)
+        uv0, uv1
     );
+    drawGridLines(ImageGrid(kernelSize, kernelSize), kernelSize, kernelSize);
     
     ImGui::Separator();
     ImGui::Text("卷积计算");
     ImGui::Separator();
     
-    // 显示卷积核权重
+    // 显示卷积核权重（选中的输入通道）
+    int numChannels = anim.getNumInputChannels();
+    if (numChannels > 1) {
+        ImGui::Text("输入通道 #%d 的权重", anim.getInputChannel() + 1);
+    }
     const auto& weights = anim.getKernelWeights();
     if (ImGui::BeginTable("weights", kernelSize, ImGuiTableFlags_Borders)) {
         for (int y = 0; y < kernelSize; ++y) {
@@ -123,7 +211,24 @@ void ConvAnimPanel::showKernelWindow(ConvAnimBase& anim, const char* id) {
     // 显示点积
     float dot = anim.getDotProduct();
     ImGui::Separator();
-    ImGui::Text("点积: %.4f", dot);
+    if (numChannels <= 1) {
+        ImGui::Text("点积: %.4f", dot);
+        return;
+    }
+
+    // 各输入通道的贡献及按通道累加的部分和，最后一项即为输出值
+    const auto& contributions = anim.getChannelContributions();
+    const auto& partialSums = anim.getPartialSums();
+    int channel = anim.getInputChannel();
+    ImGui::Text("点积: %.4f（%d个输入通道之和）", dot, numChannels);
+    if (channel < static_cast<int>(contributions.size())) {
+        ImGui::Text("通道 #%d 贡献: %.4f  累计至此: %.4f", channel + 1,
+                    contributions[channel], partialSums[channel]);
+    }
+    ImGui::PlotHistogram("##contributions", contributions.data(), static_cast<int>(contributions.size()),
+                         0, "各通道贡献", FLT_MAX, FLT_MAX, ImVec2(-1, 60));
+    ImGui::PlotLines("##partial_sums", partialSums.data(), static_cast<int>(partialSums.size()),
+                     0, "部分和", FLT_MAX, FLT_MAX, ImVec2(-1, 60));
 }
 
 void ConvAnimPanel::showOutputWindow(ConvAnimBase& anim, const char* id) {
@@ -136,11 +241,29 @@ void ConvAnimPanel::showOutputWindow(ConvAnimBase& anim, const char* id) {
     ImGui::Text("尺寸: %d × %d", outW, outH);
     
     ImVec2 outputSize(280, 280);
+    ImVec2 uv0, uv1;
+    anim.getOutputUV(uv0, uv1);
     ImGui::Image(
         (void*)(intptr_t)anim.getOutputTexture().getNativeHandle(),
         outputSize,
-        ImVec2(0, 0), ImVec2(1, 1)
+        uv0, uv1
     );
+
+    // 叠加尚未计算的区域（逐步显示时）、网格线和当前输出位置
+    int curX = anim.getCurrentX();
+    int curY = anim.getCurrentY();
+    ImageGrid grid(outW, outH);
+    if (anim.isProgressiveOutput()) {
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        if (curX + 1 < outW) {
+            drawList->AddRectFilled(grid.at(curX + 1, curY), grid.at(outW, curY + 1), kPendingColor);
+        }
+        if (curY + 1 < outH) {
+            drawList->AddRectFilled(grid.at(0, curY + 1), grid.at(outW, outH), kPendingColor);
+        }
+    }
+    drawGridLines(grid, outW, outH);
+    drawHighlightRect(grid, curX, curY, 1, 1);
     
     // 显示点积值
     ImGui::Separator();
@@ -155,9 +278,12 @@ void ConvAnimPanel::showControls(ConvAnimBase& anim, const char* id) {
     
     // 获取当前速度
     float currentSpeed = anim.getAnimationSpeed();
+    // 最快每秒扫过一整张输出图（高速时每帧前进多个位置）
+    const float maxSpeed = std::max(20.0f, static_cast<float>(anim.getOutputWidth() * anim.getOutputHeight()));
     
-    // 速度滑动条
-    if (ImGui::SliderFloat("速度(帧/秒)", &currentSpeed, 0.1f, 20.0f, "%.1f")) {
+    // 速度滑动条（对数刻度，低速端仍可精细调节）
+    if (ImGui::SliderFloat("速度(位置/秒)", &currentSpeed, 0.1f, maxSpeed, "%.1f",
+                           ImGuiSliderFlags_Logarithmic)) {
         anim.setAnimationSpeed(currentSpeed);
     }
     
@@ -171,6 +297,13 @@ void ConvAnimPanel::showControls(ConvAnimBase& anim, const char* id) {
     if (ImGui::Button("2.0帧/秒")) anim.setAnimationSpeed(2.0f);
     ImGui::SameLine();
     if (ImGui::Button("5.0帧/秒")) anim.setAnimationSpeed(5.0f);
+    ImGui::SameLine();
+    if (ImGui::Button("整图/秒")) anim.setAnimationSpeed(maxSpeed);
+
+    bool progressive = anim.isProgressiveOutput();
+    if (ImGui::Checkbox("逐步显示输出", &progressive)) {
+        anim.setProgressiveOutput(progressive);
+    }
 
 
     ImGui::Text("动画控制");
@@ -220,6 +353,18 @@ void ConvAnimPanel::showControls(ConvAnimBase& anim, const char* id) {
         ImGui::Text("进度: %d / %d (%.1f%%)", 
                    currentPos, totalPos, progress * 100.0f);
         ImGui::ProgressBar(progress, ImVec2(-1, 20), "");
+
+        // 在进度条上点击或拖动直接跳到对应位置
+        if (ImGui::IsItemHovered() && ImGui::IsMouseDown(ImGuiMouseButton_Left)) {
+            ImVec2 barMin = ImGui::GetItemRectMin();
+            ImVec2 barMax = ImGui::GetItemRectMax();
+            float width = barMax.x - barMin.x;
+            if (width > 0) {
+                float t = std::clamp((ImGui::GetMousePos().x - barMin.x) / width, 0.0f, 1.0f);
+                int target = std::min(totalPos - 1, static_cast<int>(t * totalPos));
+                if (target != currentPos - 1) anim.seek(target);
+            }
+        }
         
         // 位置信息
         ImGui::Text("当前坐标: X=%d, Y=%d", curX+1, curY+1);
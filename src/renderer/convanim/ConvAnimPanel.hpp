@@ -16,6 +16,9 @@ public:
     // 绘制动画面板
     static void show(const std::string& title, bool* open, 
                      ConvAnimBase& anim, float& deltaTime);
+
+    // 动画尚未加载完成时显示的占位窗口
+    static void showLoading(const std::string& title, bool* open, bool failed);
     
 private:
     static void showInputWindow(ConvAnimBase& anim, const char* id);
@@ -1,8 +1,63 @@
 #include "renderer/convanim/animations/Conv1Anim.hpp"
-#include <fstream>
+#include "engine/kernels/Conv3x3.hpp"
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 
+namespace {
+
+// 按缓存的范围归一化到 0..255，范围为0时显示中灰
+sf::Uint8 toGray(float val, float minVal, float range) {
+    return range > 0 ? static_cast<sf::Uint8>(((val - minVal) / range) * 255) : 128;
+}
+
+void setPixel(sf::Uint8* p, sf::Uint8 r, sf::Uint8 g, sf::Uint8 b) {
+    p[0] = r;
+    p[1] = g;
+    p[2] = b;
+    p[3] = 255;
+}
+
+// 把 count 个 width×height 的特征图排成接近正方形的网格（例如16个64×64排成256×256），
+// 每个特征图按自己的最小最大值归一化，空格保持透明
+void packAtlas(const float* maps, int count, int width, int height,
+               std::vector<sf::Uint8>& pixels, int& columns, int& rows) {
+    const size_t plane = static_cast<size_t>(width) * height;
+    columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count)))));
+    rows = std::max(1, (count + columns - 1) / columns);
+    const int atlasWidth = columns * width;
+
+    pixels.assign(static_cast<size_t>(atlasWidth) * rows * height * 4, 0);
+    for (int k = 0; k < count; ++k) {
+        const float* map = maps + k * plane;
+        auto [minIt, maxIt] = std::minmax_element(map, map + plane);
+        const float minVal = *minIt;
+        const float range = *maxIt - *minIt;
+
+        const int originX = (k % columns) * width;
+        const int originY = (k / columns) * height;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                sf::Uint8 gray = toGray(map[y * width + x], minVal, range);
+                setPixel(&pixels[((originY + y) * atlasWidth + originX + x) * 4], gray, gray, gray);
+            }
+        }
+    }
+}
+
+// 图集第 cell 格内 [x0, x1) × [y0, y1) 像素区域的纹理坐标
+void atlasUV(int cell, int columns, int rows, int width, int height,
+             int x0, int y0, int x1, int y1, ImVec2& uv0, ImVec2& uv1) {
+    const float atlasWidth = static_cast<float>(columns * width);
+    const float atlasHeight = static_cast<float>(rows * height);
+    const int originX = (cell % columns) * width;
+    const int originY = (cell / columns) * height;
+    uv0 = ImVec2((originX + x0) / atlasWidth, (originY + y0) / atlasHeight);
+    uv1 = ImVec2((originX + x1) / atlasWidth, (originY + y1) / atlasHeight);
+}
+
+} // namespace
+
 Conv1Anim::Conv1Anim() {
     int padding = 1;        // padding=1
     kernelSize = 3;         // 卷积核大小
@@ -27,17 +82,27 @@ Conv1Anim::Conv1Anim() {
     std::vector<float>& weights = getKernelWeights();
     weights.resize(kernelCount * kernelChannels * kernelSize * kernelSize);
     
-    // 初始化纹理
-    inputTex.create(padInputWidth, padInputHeight);
-    kernelTex.create(kernelSize, kernelSize);
-    outputTex.create(outputWidth, outputHeight);
-    kernelFrameTex.create(padInputWidth, padInputHeight);
+    // 纹理在initTextures()中创建（需要在渲染线程）
     kernel.resize(kernelSize * kernelSize);
 }
 
-bool Conv1Anim::load(const std::string& modelDir) {
+void Conv1Anim::initTextures() {
+    inputTex.create(padInputWidth, padInputHeight);
+
+    if (!paddedInput.empty()) {
+        // 第一个输入通道的预览；面板按 getInputUV 从输入图集（kernelFrameTex）中显示选中的通道
+        std::vector<sf::Uint8> pixels;
+        int columns = 0;
+        int rows = 0;
+        packAtlas(paddedInput.data(), 1, padInputWidth, padInputHeight, pixels, columns, rows);
+        inputTex.update(pixels.data());
+    }
+
+    refreshTextures();
+}
+
+bool Conv1Anim::load(const ModelLoader& model) {
    std::cout << "=== 加载Conv1动画数据 (校徽分类器) ===" << std::endl;
-    std::cout << "模型目录: " << modelDir << std::endl;
     
     // 1. 加载校徽图片
     std::string imagePath = "/workspace/python/data/mol_ustc_test/ustc.jpg";
@@ -48,9 +113,7 @@ bool Conv1Anim::load(const std::string& modelDir) {
     }
     
     // 2. 加载权重
-    std::string weightPath = modelDir + "/weights.bin";
-    std::cout << "加载权重: " << weightPath << std::endl;
-    if (!loadWeights(weightPath)) {
+    if (!loadWeights(model)) {
         std::cerr << "无法加载权重" << std::endl;
         return false;
     }
@@ -58,9 +121,6 @@ bool Conv1Anim::load(const std::string& modelDir) {
     // 3. 计算输出特征图
     calculateOutput();
     
-    // 4. 生成纹理
-    refreshTextures();
-    
     std::cout << "Conv1动画加载完成" << std::endl;
     std::cout << "  输入尺寸: " << inputWidth << "×" << inputHeight << " 灰度图" << std::endl;
     std::cout << "  卷积核: " << kernelCount << "个" << kernelSize << "×" << kernelSize << " 滤波器" << std::endl;
@@ -87,34 +147,24 @@ bool Conv1Anim::loadUstcImage(const std::string& imagePath) {
         }
     }
     
-    // 使用SFML纹理缩放
-    sf::Texture texture;
-    texture.loadFromImage(grayscaleImage);
-    
     // 计算缩放比例（保持宽高比）
     float scale = 64.0f / std::min(originalSize.x, originalSize.y);
     unsigned int scaledWidth = originalSize.x * scale;
     unsigned int scaledHeight = originalSize.y * scale;
     
-    sf::RenderTexture renderTexture;
-    renderTexture.create(scaledWidth, scaledHeight);
-    
-    sf::Sprite sprite(texture);
-    sprite.setScale(scale, scale);
-    renderTexture.draw(sprite);
-    renderTexture.display();
-    
-    sf::Image scaledImage = renderTexture.getTexture().copyToImage();
-    
     // 中心裁剪到64×64（不带padding的原始数据）
     unsigned int startX = (scaledWidth > 64) ? (scaledWidth - 64) / 2 : 0;
     unsigned int startY = (scaledHeight > 64) ? (scaledHeight - 64) / 2 : 0;
     
-    // 存储原始64×64数据（不带padding）
+    // 在CPU上做最近邻缩放（与未开启平滑的纹理缩放结果一致），不需要GL上下文，可在后台线程执行
     input.resize(64 * 64);
     for (unsigned int y = 0; y < 64; ++y) {
+        unsigned int srcY = std::min(originalSize.y - 1,
+                                     static_cast<unsigned int>((startY + y + 0.5f) / scale));
         for (unsigned int x = 0; x < 64; ++x) {
-            sf::Color pixel = scaledImage.getPixel(startX + x, startY + y);
+            unsigned int srcX = std::min(originalSize.x - 1,
+                                         static_cast<unsigned int>((startX + x + 0.5f) / scale));
+            sf::Color pixel = grayscaleImage.getPixel(srcX, srcY);
             float gray = pixel.r / 255.0f;            // [0,1]
             input[y * 64 + x] = gray * 2.0f - 1.0f;   // [-1,1]
         }
@@ -132,107 +182,34 @@ bool Conv1Anim::loadUstcImage(const std::string& imagePath) {
         }
     }
     
-    // 现在已经改为使用KernelFrameTexture而不是inputTex
-    std::vector<float> displayInput = paddedInput;
-    for (auto& val : displayInput) val = (val + 1.0f) * 0.5f;
-    binToTexture(displayInput, padInputWidth, padInputHeight, inputTex);
-    
     return true;
 }
 
 
-bool Conv1Anim::loadWeights(const std::string& weightPath) {
-    std::ifstream file(weightPath, std::ios::binary);
-    if (!file) {
-        std::cerr << "无法打开权重文件: " << weightPath << std::endl;
-        createTestWeights();
-        return true;
-    }
-    
-    // 读取权重数量
-    uint32_t numWeights = 0;
-    file.read(reinterpret_cast<char*>(&numWeights), sizeof(uint32_t));
-    std::cout << "权重数量: " << numWeights << std::endl;
-    
-    // conv1 权重: 16(输出通道) × 1(输入通道) × 3 × 3 = 144
-    int conv1WeightCount = 16 * 1 * 3 * 3;
-    if (numWeights < conv1WeightCount) {
-        std::cerr << "权重数量不足" << std::endl;
-        file.close();
+bool Conv1Anim::loadWeights(const ModelLoader& model) {
+    // conv1 权重: 16(输出通道) × 1(输入通道) × 3 × 3
+    kernelWeights = model.get_tensor("conv1.0.weight");
+    if (!kernelWeights.valid() || kernelWeights.shape().size() != 4 ||
+        kernelWeights.dim(1) != 1 || kernelWeights.dim(2) != kernelSize || kernelWeights.dim(3) != kernelSize) {
+        std::cerr << "conv1权重缺失或形状不符" << std::endl;
+        kernelWeights = TensorView();
+        kernelCount = 1;
         createTestWeights();
         return true;
     }
     
-    // 读取所有conv1权重
-    std::vector<float> allConv1Weights(conv1WeightCount);
-    file.read(reinterpret_cast<char*>(allConv1Weights.data()), conv1WeightCount * sizeof(float));
-    file.close();
+    kernelCount = kernelWeights.dim(0);
+    std::cout << "conv1权重: " << kernelWeights.numel() << " 个参数" << std::endl;
     
-    std::cout << "conv1权重: " << conv1WeightCount << " 个参数" << std::endl;
-    
-    // 将权重分组存储到16核
-    int kernelSize2d = kernelSize * kernelSize;
-    allKernels.resize(16, std::vector<float>(kernelSize2d));
-    
-    for (int k = 0; k < 16; ++k) {
-        int startIdx = k * kernelSize2d;
-        std::copy(
-            allConv1Weights.begin() + startIdx,
-            allConv1Weights.begin() + startIdx + kernelSize2d,
-            allKernels[k].begin()
-        );
-    }
-    
-    // 设置当前卷积核为第一个
-    setKernelIndex(0);
+    // 设置当前卷积核为第一个（纹理在initTextures中生成）
+    currentKernelIndex = 0;
+    updateCurrentKernel();
     
-    std::cout << "已" << allKernels.size() << "个卷积核" << std::endl;
+    std::cout << "已" << kernelCount << "个卷积核" << std::endl;
 
     return true;
 }
 
-// 暂时未使用，保留接口
-void Conv1Anim::loadInputData(const std::string& inputPath) {
-    std::ifstream file(inputPath, std::ios::binary);
-    if (!file) {
-        std::cerr << "无法打开输入文件: " << inputPath << std::endl;
-        
-        // 创建测试输入（棋盘格）
-        input.resize(inputWidth * inputHeight);
-        for (int y = 0; y < inputHeight; ++y) {
-            for (int x = 0; x < inputWidth; ++x) {
-                // 棋盘格图案
-                float value = ((x / 4 + y / 4) % 2) ? 1.0f : 0.0f;
-                input[y * inputWidth + x] = value;
-            }
-        }
-        std::cout << "使用测试输入" << std::endl;
-        return;
-    }
-    
-    // 读取输入数据
-    input.resize(inputWidth * inputHeight);
-    file.read(reinterpret_cast<char*>(input.data()), input.size() * sizeof(float));
-    file.close();
-
-    // 创建带padding的输入数据（66×66）
-    paddedInput.resize(padInputHeight * padInputWidth, 0.0f);
-    
-    // 将原始数据放入中心，四周填充0
-    for (int y = 0; y < 64; ++y) {
-        for (int x = 0; x < 64; ++x) {
-            int paddedX = x + 1;
-            int paddedY = y + 1;
-            paddedInput[paddedY * padInputWidth + paddedX] = input[y * 64 + x];
-        }
-    }
-    // 打印输入数据范围（调试用）
-    /*
-    float minVal = *std::min_element(input.begin(), input.end());
-    float maxVal = *std::max_element(input.begin(), input.end());
-    std::cout << "输入数据范围: [" << minVal << ", " << maxVal << "]" << std::endl;*/
-}
-
 void Conv1Anim::createTestWeights() {
     std::cout << "创建测试卷积核..." << std::endl;
     int firstKernelSize = 3 * 3;  // 9
@@ -249,85 +226,90 @@ void Conv1Anim::createTestWeights() {
     std::cout << "测试卷积核创建完成" << std::endl;
 }
 
-// 暂时未使用，保留接口
-void Conv1Anim::loadOutputData(const std::string& outputPath) {
-    std::ifstream file(outputPath, std::ios::binary);
-    if (!file) {
-        std::cerr << "无法打开输出文件: " << outputPath << std::endl;
-        
-        // 创建输出
-        output.resize(outputWidth * outputHeight);
-        for (int y = 0; y < outputHeight; ++y) {
-            for (int x = 0; x < outputWidth; ++x) {
-                float sum = 0.0f;
-                for (int ky = 0; ky < kernelSize; ++ky) {
-                    for (int kx = 0; kx < kernelSize; ++kx) {
-                        int ix = x + kx;
-                        int iy = y + ky;
-                        sum += paddedInput[iy * padInputWidth + ix] * kernel[ky * kernelSize + kx];
-                    }
-                }
-                output[y * outputWidth + x] = sum;
-            }
-        }
-        std::cout << "使用模拟输出" << std::endl;
-        return;
-    }
-    
-    // 读取输出数据
-    output.resize(outputWidth * outputHeight);
-    file.read(reinterpret_cast<char*>(output.data()), output.size() * sizeof(float));
-    
-    // 打印输出数据范围
-    float minVal = *std::min_element(output.begin(), output.end());
-    float maxVal = *std::max_element(output.begin(), output.end());
-    std::cout << "输出数据范围: [" << minVal << ", " << maxVal << "]" << std::endl;
-}
-
 void Conv1Anim::setKernelIndex(int index) {
-    if (index >= 0 && index < static_cast<int>(allKernels.size())) {
+    if (kernelWeights.valid() && index >= 0 && index < kernelWeights.dim(0)) {
         currentKernelIndex = index;
-        kernel = allKernels[index];  // 更新当前卷积核
-        std::cout << "切换到卷积核 #" << (index + 1) << std::endl;
+        updateCurrentKernel();  // 更新当前卷积核
         
-        // 重新计算输出
-        calculateOutput();
-        refreshTextures();
+        // 全部输出已在加载时算好并打包进图集，切换只改变显示区域
+        selectOutputMap();
+        updateContributions();
     } else {
         std::cerr << "无效的卷积核索引: " << index << std::endl;
     }
 }
 
 void Conv1Anim::updateCurrentKernel() {
-    if (!allKernels.empty() && currentKernelIndex < static_cast<int>(allKernels.size())) {
-        kernel = allKernels[currentKernelIndex];
+    if (!kernelWeights.valid()) return;
+    
+    // 选中输入通道的3×3卷积核
+    const float* weights = kernelWeights.slice(currentKernelIndex);
+    if (weights) {
+        const int taps = kernelSize * kernelSize;
+        weights += currentInputChannel * taps;
+        kernel.assign(weights, weights + taps);
     }
 }
 
+void Conv1Anim::setInputChannel(int channel) {
+    if (channel < 0 || channel >= inputChannelCount) return;
+    currentInputChannel = channel;
+    // 只改变显示的输入图集格和3×3权重，点积仍对全部输入通道求和
+    updateCurrentKernel();
+}
+
 void Conv1Anim::calculateOutput() {
-    output.resize(outputWidth * outputHeight, 0.0f);
-    
-    std::cout << "计算卷积..." << std::endl;
-    std::cout << "使用卷积核 #" << (currentKernelIndex + 1) << " 计算输出..." << std::endl;
-    
-    // 计算每个输出位置（在66×66的输入上滑动）
-    for (int y = 0; y < outputHeight; ++y) {
-        for (int x = 0; x < outputWidth; ++x) {
-            float sum = 0.0f;
-
-            // 在带padding的输入上计算卷积
-            for (int ky = 0; ky < kernelSize; ++ky) {
-                for (int kx = 0; kx < kernelSize; ++kx) {
-                    int inputX = x + kx;
-                    int inputY = y + ky;
-                    sum += paddedInput[inputY * padInputWidth + inputX] * kernel[ky * kernelSize + kx];
-                }
-            }
-            output[y * outputWidth + x] = sum;
+    const size_t plane = static_cast<size_t>(outputWidth) * outputHeight;
+    const int count = kernelWeights.valid() ? kernelCount : 1;
+    outputMaps.assign(count * plane, 0.0f);
+    
+    std::cout << "计算全部 " << count << " 个卷积核的输出（" << inputChannelCount << " 个输入通道）..." << std::endl;
+    
+    // 各卷积核的全部权重打包为 count × C_in × 3 × 3，一次卷积得到全部输出通道（不含偏置）
+    // 直接在未padding的输入上计算（边界按零填充处理，使用运行时选择的SIMD内核）
+    const int taps = kernelSize * kernelSize;
+    const int channels = kernelWeights.valid() ? inputChannelCount : 1;
+    if (input.size() >= static_cast<size_t>(channels) * inputWidth * inputHeight && kernel.size() >= 9) {
+        const size_t kernelStride = static_cast<size_t>(channels) * taps;
+        std::vector<float> packed(count * kernelStride);
+        for (int k = 0; k < count; ++k) {
+            const float* weights = kernelWeights.valid() ? kernelWeights.slice(k) : kernel.data();
+            std::copy(weights, weights + kernelStride, packed.begin() + k * kernelStride);
         }
+        kernels::conv3x3_s1p1(input.data(), channels, inputHeight, inputWidth,
+                              packed.data(), nullptr, count, outputMaps.data());
     }
+
+    buildOutputAtlas();
+    selectOutputMap();
+    updateContributions();
 }
 
+void Conv1Anim::buildOutputAtlas() {
+    const size_t plane = static_cast<size_t>(outputWidth) * outputHeight;
+    packAtlas(outputMaps.data(), static_cast<int>(outputMaps.size() / plane), outputWidth, outputHeight,
+              atlasPixels, atlasColumns, atlasRows);
+}
+
+void Conv1Anim::selectOutputMap() {
+    const size_t plane = static_cast<size_t>(outputWidth) * outputHeight;
+    const size_t offset = currentKernelIndex * plane;
+    if (offset + plane > outputMaps.size()) {
+        output.assign(plane, 0.0f);
+        return;
+    }
+    output.assign(outputMaps.begin() + offset, outputMaps.begin() + offset + plane);
+}
+
+void Conv1Anim::getOutputUV(ImVec2& uv0, ImVec2& uv1) const {
+    atlasUV(currentKernelIndex, atlasColumns, atlasRows, outputWidth, outputHeight,
+            0, 0, outputWidth, outputHeight, uv0, uv1);
+}
+
+void Conv1Anim::getInputUV(ImVec2& uv0, ImVec2& uv1) const {
+    atlasUV(currentInputChannel, inputAtlasColumns, inputAtlasRows, padInputWidth, padInputHeight,
+            0, 0, padInputWidth, padInputHeight, uv0, uv1);
+}
 
 void Conv1Anim::play() { playing = true; }
 void Conv1Anim::pause() { playing = false; }
@@ -335,56 +317,81 @@ void Conv1Anim::reset() {
     currentX = 0; 
     currentY = 0; 
     timer = 0.0f;
-    refreshTextures();
+    updateContributions();
 }
 
 // 添加单步执行函数
 void Conv1Anim::step() {
     if (!playing) {           // 只有在暂停状态下才能单步
-        moveToNextPosition();
-        refreshTextures();
+        advancePosition(1);
     } else {
         std::cout << "播放状态下无法单步执行" << std::endl;
     }
 }
 
-// 移动卷积核到下一个位置
-void Conv1Anim::moveToNextPosition() {
-    // 移动到下一个位置
-    currentX++;
-    if (currentX >= outputWidth) {
-        currentX = 0;
-        currentY++;
-        if (currentY >= outputHeight) {
-            currentY = 0;
-            //std::cout << "卷积完成一轮" << std::endl;
+void Conv1Anim::seek(int position) {
+    const int total = outputWidth * outputHeight;
+    if (total <= 0) return;
+    position = std::clamp(position, 0, total - 1);
+    currentX = position % outputWidth;
+    currentY = position / outputWidth;
+    timer = 0.0f;
+    updateContributions();
+}
+
+// 按线性下标直接计算新位置，一次前进多个位置也不需要逐个移动
+void Conv1Anim::advancePosition(long long count) {
+    const long long total = static_cast<long long>(outputWidth) * outputHeight;
+    if (total <= 0) return;
+    const long long position = (static_cast<long long>(currentY) * outputWidth + currentX + count) % total;
+    currentX = static_cast<int>(position % outputWidth);
+    currentY = static_cast<int>(position / outputWidth);
+    updateContributions();
+}
+
+void Conv1Anim::updateContributions() {
+    const int taps = kernelSize * kernelSize;
+    const size_t padPlane = static_cast<size_t>(padInputWidth) * padInputHeight;
+    const int channels = kernelWeights.valid() ? inputChannelCount : 1;
+    contributions.assign(channels, 0.0f);
+    partialSums.assign(channels, 0.0f);
+
+    const float* weights = kernelWeights.valid() ? kernelWeights.slice(currentKernelIndex) : kernel.data();
+    if (!weights || paddedInput.size() < channels * padPlane) return;
+
+    // 每个位置只有 C_in × 9 次乘加（conv4 为576次），每帧重新计算即可
+    float sum = 0.0f;
+    for (int c = 0; c < channels; ++c) {
+        const float* window = paddedInput.data() + c * padPlane + currentY * padInputWidth + currentX;
+        const float* w = weights + c * taps;
+        float acc = 0.0f;
+        for (int ky = 0; ky < kernelSize; ++ky) {
+            for (int kx = 0; kx < kernelSize; ++kx) {
+                acc += w[ky * kernelSize + kx] * window[ky * padInputWidth + kx];
+            }
         }
+        contributions[c] = acc;
+        sum += acc;
+        partialSums[c] = sum;
     }
 }
 
 void Conv1Anim::update(float dt) {
     if (!playing) return;
     
+    // 固定时间步长：累计的时间每满 frameDuration 前进一个位置。
+    // 高速播放（如每秒一整张输出图）时一帧前进多个位置；纹理不随位置变化，不需要上传
     timer += dt;
     if (timer < frameDuration) return;
-    timer -= frameDuration;
-    
-    // 移动到下一个位置
-    moveToNextPosition();
+    const long long steps = static_cast<long long>(timer / frameDuration);
+    timer -= steps * frameDuration;
     
-    // 更新纹理
-    refreshTextures();
+    advancePosition(steps);
 }
 
-
 void Conv1Anim::refreshTextures() {
-    // 更新输入纹理（高亮当前卷积区域）
+    // 输入和输出图集都是静态纹理，卷积窗口、输出光标等由面板叠加绘制
     refreshKernelFrameTexture();
-    
-    // 更新卷积核纹理
-    refreshKernelTexture();
-    
-    // 更新输出纹理
     refreshOutputTexture();
 }
 
@@ -393,162 +400,43 @@ void Conv1Anim::refreshKernelFrameTexture() {
         std::cerr << "paddedInput未初始化" << std::endl;
         return;
     }
-    
-    std::vector<sf::Uint8> pixels(padInputWidth * padInputHeight * 4, 0);
 
-    // 计算最小最大值用于归一化
-    float minVal = *std::min_element(paddedInput.begin(), paddedInput.end());
-    float maxVal = *std::max_element(paddedInput.begin(), paddedInput.end());
-    float range = maxVal - minVal;
-    
-    // 复制带padding的输入数据到纹理
-    for (int y = 0; y < padInputHeight; ++y) {
-        for (int x = 0; x < padInputWidth; ++x) {
-            size_t idx = y * padInputWidth + x;
-            if (idx >= paddedInput.size()) {
-                continue;
-            }
-            float val = paddedInput[idx];
-            uint8_t gray = range > 0 ? 
-                static_cast<uint8_t>(((val - minVal) / range) * 255) : 128;
-
-            int pixelIdx = (y * padInputWidth + x) * 4;
-            if (pixelIdx + 3 < pixels.size()) {
-                pixels[pixelIdx] = gray;      // R
-                pixels[pixelIdx + 1] = gray;  // G
-                pixels[pixelIdx + 2] = gray;  // B
-                pixels[pixelIdx + 3] = 255;   // A
-            }
-        }
+    // 每个带padding的输入通道占图集的一格，各自归一化
+    const size_t padPlane = static_cast<size_t>(padInputWidth) * padInputHeight;
+    const int channels = static_cast<int>(std::min<size_t>(inputChannelCount, paddedInput.size() / padPlane));
+    std::vector<sf::Uint8> pixels;
+    packAtlas(paddedInput.data(), channels, padInputWidth, padInputHeight,
+              pixels, inputAtlasColumns, inputAtlasRows);
+
+    const unsigned width = inputAtlasColumns * padInputWidth;
+    const unsigned height = inputAtlasRows * padInputHeight;
+    if (kernelFrameTex.getSize().x != width || kernelFrameTex.getSize().y != height) {
+        kernelFrameTex.create(width, height);
     }
-    
-    // 高亮当前卷积区域（添加边界检查）
-    for (int dy = 0; dy < kernelSize; ++dy) {
-        for (int dx = 0; dx < kernelSize; ++dx) {
-            int x = currentX + dx;
-            int y = currentY + dy;
-            
-            if (x >= 0 && x < padInputWidth && y >= 0 && y < padInputHeight) {
-                int idx = (y * padInputWidth + x) * 4;
-                if (idx + 3 < pixels.size()) {
-                    pixels[idx] = 255;      // 黄色高亮
-                    pixels[idx + 1] = 255;  
-                    pixels[idx + 2] = 0;    
-                    pixels[idx + 3] = 255;  // 不透明
-                }
-            }
-        }
-    }
-    
     kernelFrameTex.update(pixels.data());
 }
 
-void Conv1Anim::refreshKernelTexture() {
-    int displayWidth = kernelSize;
-    int displayHeight = kernelSize;
-    
-    std::vector<sf::Uint8> pixels(displayWidth * displayHeight * 4, 0);
-
-    // 计算最小最大值用于归一化
-    float minVal = *std::min_element(paddedInput.begin(), paddedInput.end());
-    float maxVal = *std::max_element(paddedInput.begin(), paddedInput.end());
-    float range = maxVal - minVal;
-    
-    for (int y = 0; y < kernelSize; ++y) {
-        for (int x = 0; x < kernelSize; ++x) {
-            // 覆盖的输入像素
-            int inputX = currentX + x;
-            int inputY = currentY + y;
-            float inputVal = 0.0f;
-            inputVal = paddedInput[inputY * padInputWidth + inputX];
-
-            uint8_t inputGray = range > 0 ? 
-                static_cast<uint8_t>(((inputVal - minVal) / range) * 255) : 128;
-        
-            int idx = (y * displayWidth + x) * 4;
-            pixels[idx] = inputGray;      // R
-            pixels[idx + 1] = inputGray;  // G
-            pixels[idx + 2] = inputGray;  // B
-            pixels[idx + 3] = 255;        // A
-        }
-    }
-    
-    // 更新纹理尺寸
-    if (kernelTex.getSize().x == 0) {
-        kernelTex.create(displayWidth, displayHeight);
+void Conv1Anim::refreshOutputTexture() {
+    if (atlasPixels.empty()) {
+        return;
     }
-    kernelTex.update(pixels.data());
-}
 
-void Conv1Anim::refreshOutputTexture() {
-    std::vector<sf::Uint8> pixels(outputWidth * outputHeight * 4, 0);
-    
-    // 计算最小最大值用于归一化
-    float minVal = *std::min_element(output.begin(), output.end());
-    float maxVal = *std::max_element(output.begin(), output.end());
-    float range = maxVal - minVal;
-    
-    for (int y = 0; y < outputHeight; ++y) {
-        for (int x = 0; x < outputWidth; ++x) {
-            float val = output[y * outputWidth + x];
-            uint8_t gray = range > 0 ? 
-                static_cast<uint8_t>(((val - minVal) / range) * 255) : 128;
-            
-            int idx = (y * outputWidth + x) * 4;
-            pixels[idx] = gray;      // R
-            pixels[idx + 1] = gray;  // G
-            pixels[idx + 2] = gray;  // B
-            pixels[idx + 3] = 255;   // A
-            
-            // 高亮当前计算位置
-            if (x == currentX && y == currentY) {
-                pixels[idx] = 255;      // 红色
-                pixels[idx + 1] = 255;  // 绿色
-                pixels[idx + 2] = 0;    // 无蓝色
-            }
-        }
+    // 图集像素在 calculateOutput 中已生成，这里只负责创建纹理并整张上传
+    const unsigned width = atlasColumns * outputWidth;
+    const unsigned height = atlasRows * outputHeight;
+    if (outputTex.getSize().x != width || outputTex.getSize().y != height) {
+        outputTex.create(width, height);
     }
-    
-    outputTex.update(pixels.data());
+    outputTex.update(atlasPixels.data());
 }
 
-float Conv1Anim::calculateDotProduct() const {
-    float sum = 0.0f;
-    for (int ky = 0; ky < kernelSize; ++ky) {
-        for (int kx = 0; kx < kernelSize; ++kx) {
-            int ix = currentX + kx;
-            int iy = currentY + ky;
-            sum += kernel[ky * kernelSize + kx] * paddedInput[iy * padInputWidth + ix];
-        }
-    }
-    return sum;
+void Conv1Anim::getKernelUV(ImVec2& uv0, ImVec2& uv1) const {
+    // 选中输入通道上卷积窗口覆盖的 kernelSize×kernelSize 个带padding输入像素
+    atlasUV(currentInputChannel, inputAtlasColumns, inputAtlasRows, padInputWidth, padInputHeight,
+            currentX, currentY, currentX + kernelSize, currentY + kernelSize, uv0, uv1);
 }
 
 float Conv1Anim::getDotProduct() const {
-    return calculateDotProduct();
+    // 全部输入通道之和（不含偏置）
+    return partialSums.empty() ? 0.0f : partialSums.back();
 }
-
-// 暂时未使用，保留接口
-void Conv1Anim::binToTexture(const std::vector<float>& data, 
-                           int width, int height, 
-                           sf::Texture& texture) {
-    std::vector<sf::Uint8> pixels(width * height * 4, 0);
-    
-    // 归一化到0-1
-    float minVal = *std::min_element(data.begin(), data.end());
-    float maxVal = *std::max_element(data.begin(), data.end());
-    float range = maxVal - minVal;
-    
-    for (int i = 0; i < width * height; ++i) {
-        float val = data[i];
-        uint8_t gray = range > 0 ? 
-            static_cast<uint8_t>(((val - minVal) / range) * 255) : 128;
-        
-        pixels[i * 4] = gray;      // R
-        pixels[i * 4 + 1] = gray;  // G
-        pixels[i * 4 + 2] = gray;  // B
-        pixels[i * 4 + 3] = 255;   // A
-    }
-    
-    texture.update(pixels.data());
-}
\ No newline at end of file
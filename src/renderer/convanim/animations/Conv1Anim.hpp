@@ -7,11 +7,13 @@ class Conv1Anim : public ConvAnimBase {
 public:
     Conv1Anim();
 
-    bool load(const std::string& modelDir) override;
+    bool load(const ModelLoader& model) override;
+    void initTextures() override;
     void play() override;
     void pause() override;
     void reset() override;
     void step() override;
+    void seek(int position) override;
     void update(float dt) override;
     bool isPlaying() const override { return playing; }
     std::string getTitle() const override { return "第一卷积层动画"; }
@@ -21,9 +23,12 @@ public:
     
     // 获取纹理
     const sf::Texture& getInputTexture() const override { return inputTex; }
-    const sf::Texture& getKernelTexture() const override { return kernelTex; }
+    const sf::Texture& getKernelTexture() const override { return kernelFrameTex; }
     const sf::Texture& getOutputTexture() const override { return outputTex; }
     const sf::Texture& getKernelFrameTexture() const override { return kernelFrameTex; }
+    void getInputUV(ImVec2& uv0, ImVec2& uv1) const override;
+    void getKernelUV(ImVec2& uv0, ImVec2& uv1) const override;
+    void getOutputUV(ImVec2& uv0, ImVec2& uv1) const override;
     
     // 获取当前参数
     float getDotProduct() const override;
@@ -55,26 +60,38 @@ public:
     int getNumKernels() const override { return kernelCount; }
     int getKernelIndex() const override { return currentKernelIndex; }
     void setKernelIndex(int index) override;
+
+    // 输入通道：点积是全部输入通道的 3×3 乘加之和，显示的输入特征图和权重为选中的通道
+    int getNumInputChannels() const override { return inputChannelCount; }
+    int getInputChannel() const override { return currentInputChannel; }
+    void setInputChannel(int channel) override;
+    const std::vector<float>& getChannelContributions() const override { return contributions; }
+    const std::vector<float>& getPartialSums() const override { return partialSums; }
+
+    // 逐步显示输出：尚未计算到的输出位置显示为暗色（由面板叠加绘制）
+    void setProgressiveOutput(bool enabled) override { progressiveOutput = enabled; }
+    bool isProgressiveOutput() const override { return progressiveOutput; }
     
 
 protected:
     // 数据
-    std::vector<float> input;      // 输入特征图
-    std::vector<float> kernel;     // 卷积核权重
-    std::vector<float> output;     // 输出特征图
-    std::vector<float> paddedInput;
+    std::vector<float> input;      // 输入特征图，inputChannelCount × inputHeight × inputWidth
+    std::vector<float> kernel;     // 当前卷积核在选中输入通道上的权重
+    std::vector<float> output;     // 当前卷积核的输出特征图
+    std::vector<float> outputMaps; // 全部卷积核的输出特征图，kernelCount × outputHeight × outputWidth
+    std::vector<float> paddedInput; // 带padding的输入，inputChannelCount × padInputHeight × padInputWidth
 
     // 纹理
     sf::Texture inputTex;          // 输入纹理
-    sf::Texture kernelTex;         // 卷积核纹理
-    sf::Texture outputTex;         // 输出纹理
-    sf::Texture kernelFrameTex;    // 卷积核边框纹理
+    sf::Texture outputTex;         // 输出纹理图集（每个卷积核的输出占一格）
+    sf::Texture kernelFrameTex;    // 带padding的输入纹理图集（每个输入通道占一格，静态，卷积窗口由面板叠加绘制）
     
     // 动画状态
     bool playing = false;
-    float timer = 0.0f;
-    float frameDuration = 0.1f;    // 每帧持续时间(秒)
-    float animationSpeed = 10.0f;  // 动画速度(帧/秒)
+    float timer = 0.0f;            // 尚未消耗的时间（固定时间步长累加器）
+    float frameDuration = 0.1f;    // 每个位置的持续时间(秒)
+    float animationSpeed = 10.0f;  // 动画速度(位置/秒)
+    bool progressiveOutput = true;
     int currentX = 0;              // 当前卷积位置x
     int currentY = 0;              // 当前卷积位置y
     
@@ -87,34 +104,42 @@ protected:
     int outputWidth = 64;
     int outputHeight = 64;
     int kernelCount = 16;
+    int inputChannelCount = 1;
     
    //辅助方法
-    bool loadWeights(const std::string& weightPath);
+    bool loadWeights(const ModelLoader& model);
     bool loadUstcImage(const std::string& imagePath);
-    void loadInputData(const std::string& inputPath);
-    void loadOutputData(const std::string& outputPath);
+    // 创建纹理时整张上传输入和输出图集，之后纹理不再变化
     void refreshTextures();
-    void refreshKernelTexture();
     void refreshOutputTexture();
     void refreshKernelFrameTexture();
     void createTestWeights();
+    // 一次计算全部卷积核的输出并打包图集像素（load 中调用，只用CPU）
     void calculateOutput();
+    void buildOutputAtlas();
+    void selectOutputMap();
 
-    // 移动卷积核到下一个位置
-    void moveToNextPosition();
-    
-    // 计算当前点积
-    float calculateDotProduct() const;
+    // 卷积核前进 count 个位置（行优先，到末尾后从头开始），O(1)
+    void advancePosition(long long count);
     
-    // 像素数据转纹理
-    void binToTexture(const std::vector<float>& data, 
-                     int width, int height, 
-                     sf::Texture& texture);
+    // 计算当前位置各输入通道的贡献和累计部分和，O(C_in × 9)；位置或卷积核变化后调用
+    void updateContributions();
+
+
 
+    // 输出图集的 RGBA 像素，每个输出通道单独归一化，由 calculateOutput 生成
+    std::vector<sf::Uint8> atlasPixels;
+    int atlasColumns = 1;                       // 图集的格数（每格 outputWidth × outputHeight）
+    int atlasRows = 1;
+    int inputAtlasColumns = 1;                  // 输入图集的格数（每格 padInputWidth × padInputHeight）
+    int inputAtlasRows = 1;
 
+    int currentInputChannel = 0;                // 显示的输入通道
+    std::vector<float> contributions;           // 当前位置各输入通道的 3×3 乘加结果
+    std::vector<float> partialSums;             // contributions 的前缀和，最后一项为点积
 
     int currentKernelIndex = 0;                  // 当前选择的卷积核索引
-    std::vector<std::vector<float>> allKernels;  // 存储所有16个卷积核
+    TensorView kernelWeights;                    // conv1全部卷积核（指向共享权重，不拷贝）
     
     // 更新当前卷积核
     void updateCurrentKernel();
@@ -7,40 +7,35 @@ Conv3Anim::Conv3Anim() {
     inputHeight = 16;
     padInputWidth = 18;
     padInputHeight = 18;
-    kernelCount = 1;
+    kernelCount = 1;  // 加载权重后更新为输出通道数
     outputWidth = 16;
     outputHeight = 16;
     
-    kernelFrameTex.create(padInputWidth, padInputHeight);
-    kernelTex.create(kernelSize, kernelSize);
-    outputTex.create(outputWidth, outputHeight);
 }
 
 
 
-bool Conv3Anim::load(const std::string& modelDir) {
+bool Conv3Anim::load(const ModelLoader& model) {
     std::cout << "=== 加载Conv3动画 ===" << std::endl;
     
-    if (!loadLayerInput(modelDir)) {
+    if (!loadLayerInput(model)) {
         return false;
     }
     
-    std::string weightPath = modelDir + "/weights.bin";
-    if (!loadKernelWeights(weightPath, getWeightOffset(), 32)) {
+    if (!loadKernelWeights(model, getWeightName())) {
         return false;
     }
     
     calculateOutput();
-    refreshTextures();
     
     std::cout << "Conv3动画加载完成" << std::endl;
     return true;
 }
 
-bool Conv3Anim::loadLayerInput(const std::string& modelDir) {
-    std::string inputPath = modelDir + "/m_ustc_conv2_output.bin";
-    std::cout << "  加载: " << inputPath << std::endl;
+bool Conv3Anim::loadLayerInput(const ModelLoader& model) {
+    std::string inputName = "m_ustc_conv2_output";
+    std::cout << "  加载: " << inputName << std::endl;
     
-    // conv2输出: 32×16×16，只取第一个通道
-    return loadSingleChannel(inputPath, 16, 16, 32, 0);
+    // conv2输出: 32×16×16，全部通道参与卷积
+    return loadInputChannels(model, inputName, 16, 16, 32);
 }
\ No newline at end of file
@@ -7,13 +7,13 @@ public:
 
     std::string getTitle() const override { return "Conv3 卷积层动画"; }
     std::string getDescription() const override { 
-        return "输入: 16×16, 输出: 16×16\n只显示第一个卷积核的第一个输入通道"; 
+        return "输入: 32×16×16, 输出: 16×16\n对32个输入通道的3×3乘加求和，可切换卷积核和显示的输入通道"; 
     }
     
-    virtual bool load(const std::string& modelDir) override;
-    virtual int getWeightOffset() const override { return 144 + 16 + 4608 + 32; }
+    virtual bool load(const ModelLoader& model) override;
+    virtual std::string getWeightName() const override { return "conv3.0.weight"; }
     virtual std::string getLayerName() const override { return "Conv3"; }
     
 protected:
-    virtual bool loadLayerInput(const std::string& modelDir) override;
+    virtual bool loadLayerInput(const ModelLoader& model) override;
 };
\ No newline at end of file
@@ -7,39 +7,34 @@ Conv4Anim::Conv4Anim() {
     inputHeight = 8;
     padInputWidth = 10;
     padInputHeight = 10;
-    kernelCount = 1;
+    kernelCount = 1;  // 加载权重后更新为输出通道数
     outputWidth = 8;
     outputHeight = 8;
 
-    kernelFrameTex.create(padInputWidth, padInputHeight);
-    kernelTex.create(kernelSize, kernelSize);
-    outputTex.create(outputWidth, outputHeight);
 }
 
 
-bool Conv4Anim::load(const std::string& modelDir) {
+bool Conv4Anim::load(const ModelLoader& model) {
     std::cout << "=== 加载Conv4动画 ===" << std::endl;
     
-    if (!loadLayerInput(modelDir)) {
+    if (!loadLayerInput(model)) {
         return false;
     }
     
-    std::string weightPath = modelDir + "/weights.bin";
-    if (!loadKernelWeights(weightPath, getWeightOffset(), 64)) {
+    if (!loadKernelWeights(model, getWeightName())) {
         return false;
     }
     
     calculateOutput();
-    refreshTextures();
     
     std::cout << "Conv4动画加载完成" << std::endl;
     return true;
 }
 
-bool Conv4Anim::loadLayerInput(const std::string& modelDir) {
-    std::string inputPath = modelDir + "/m_ustc_conv3_output.bin";
-    std::cout << "  加载: " << inputPath << std::endl;
+bool Conv4Anim::loadLayerInput(const ModelLoader& model) {
+    std::string inputName = "m_ustc_conv3_output";
+    std::cout << "  加载: " << inputName << std::endl;
     
-    // conv3输出: 64×8×8，只取第一个通道
-    return loadSingleChannel(inputPath, 8, 8, 64, 0);
+    // conv3输出: 64×8×8，全部通道参与卷积
+    return loadInputChannels(model, inputName, 8, 8, 64);
 }
\ No newline at end of file
@@ -7,14 +7,14 @@ public:
     
     std::string getTitle() const override { return "Conv4 卷积层动画"; }
     std::string getDescription() const override { 
-        return "输入: 8×8, 输出: 8×8\n只显示第一个卷积核的第一个输入通道"; 
+        return "输入: 64×8×8, 输出: 8×8\n对64个输入通道的3×3乘加求和，可切换卷积核和显示的输入通道"; 
     }
 
-    virtual bool load(const std::string& modelDir) override;
+    virtual bool load(const ModelLoader& model) override;
     
-    virtual int getWeightOffset() const override { return 144 + 16 + 4608 + 32 + 18432 + 64; }
+    virtual std::string getWeightName() const override { return "conv4.0.weight"; }
     virtual std::string getLayerName() const override { return "Conv4"; }
     
 protected:
-    virtual bool loadLayerInput(const std::string& modelDir) override;
+    virtual bool loadLayerInput(const ModelLoader& model) override;
 };
\ No newline at end of file
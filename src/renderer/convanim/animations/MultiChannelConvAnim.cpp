@@ -1,17 +1,29 @@
 #include "renderer/convanim/animations/MultiChannelConvAnim.hpp"
+#include "engine/kernels/Layout.hpp"
 #include <fstream>
 #include <iostream>
     
-bool MultiChannelConvAnim::loadSingleChannel(const std::string& filepath, 
+bool MultiChannelConvAnim::loadInputChannels(const ModelLoader& model,
+                                            const std::string& tensorName,
                                             int width, int height, 
-                                            int totalChannels, int channel) {
+                                            int totalChannels) {
+    int totalSize = width * height * totalChannels;
+    inputChannelCount = totalChannels;
+
+    // 单文件容器中已包含参考激活值，直接使用共享数据
+    TensorView tensor = model.get_tensor(tensorName);
+    if (tensor.valid() && tensor.numel() >= static_cast<size_t>(totalSize)) {
+        extractChannels(tensor.data(), width, height, totalChannels);
+        return createPaddedInput(width, height);
+    }
+
+    std::string filepath = model.get_model_dir() + "/" + tensorName + ".bin";
     std::ifstream file(filepath, std::ios::binary);
     if (!file) {
         std::cout << "无法打开文件: " << filepath << std::endl;
         return false;
     }
     
-    int totalSize = width * height * totalChannels;
     size_t expectedSize = totalSize * sizeof(float);
     std::vector<float> allData(totalSize);
     
@@ -21,53 +33,68 @@ bool MultiChannelConvAnim::loadSingleChannel(const std::string& filepath,
     }
     file.close();
     
-    input.resize(width * height);
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            int srcIdx = (y * width + x) * totalChannels + channel;
-            int dstIdx = y * width + x;
-            if (srcIdx < totalSize && dstIdx < input.size()) {
-                input[dstIdx] = allData[srcIdx];
-            }
-        }
-    }
+    extractChannels(allData.data(), width, height, totalChannels);
     
     // 创建带padding的输入数据
     return createPaddedInput(width, height);
 }
 
+void MultiChannelConvAnim::extractChannels(const float* allData, int width, int height,
+                                          int totalChannels) {
+    // 导出的激活值为 NCHW：每个通道是一个连续的 height×width 平面
+    const size_t plane = static_cast<size_t>(width) * height;
+    input.assign(totalChannels * plane, 0.0f);
+    for (int c = 0; c < totalChannels; ++c) {
+        kernels::ChannelView view = kernels::channel_view_nchw(allData, totalChannels, height, width, c);
+        if (!view.valid()) {
+            std::cout << "通道越界: " << c << " / " << totalChannels << std::endl;
+            return;
+        }
+        float* dst = input.data() + c * plane;
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                dst[y * width + x] = view.at(x, y);
+            }
+        }
+    }
+}
+
 bool MultiChannelConvAnim::createPaddedInput(int width, int height) {
-    paddedInput.resize(padInputHeight * padInputWidth, 0.0f);
+    const size_t plane = static_cast<size_t>(width) * height;
+    const size_t padPlane = static_cast<size_t>(padInputWidth) * padInputHeight;
+    paddedInput.assign(inputChannelCount * padPlane, 0.0f);
     
-    // 将原始数据放入中心，四周填充0
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            int paddedX = x + 1;
-            int paddedY = y + 1;
-            paddedInput[paddedY * padInputWidth + paddedX] = input[y * width + x];
+    // 每个通道的原始数据放入中心，四周填充0
+    for (int c = 0; c < inputChannelCount; ++c) {
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                int paddedX = x + 1;
+                int paddedY = y + 1;
+                paddedInput[c * padPlane + paddedY * padInputWidth + paddedX] = input[c * plane + y * width + x];
+            }
         }
     }
     
     return true;
 }
 
-bool MultiChannelConvAnim::loadKernelWeights(const std::string& weightPath, 
-                                            int offset, int kernelChannels) {
-    std::ifstream file(weightPath, std::ios::binary);
-    if (!file) {
-        std::cout << "无法打开权重文件" << std::endl;
+bool MultiChannelConvAnim::loadKernelWeights(const ModelLoader& model,
+                                            const std::string& weightName) {
+    // 按层名查找权重，避免依赖硬编码偏移
+    TensorView weights = model.get_tensor(weightName);
+    if (!weights.valid() || weights.shape().size() != 4 || weights.dim(1) != inputChannelCount ||
+        weights.dim(2) != kernelSize || weights.dim(3) != kernelSize) {
+        std::cout << "无法加载权重: " << weightName << std::endl;
         return false;
     }
     
-    // 跳过文件头和前offset个权重
-    uint32_t numWeights = 0;
-    file.read(reinterpret_cast<char*>(&numWeights), sizeof(uint32_t));
-    file.seekg(offset * sizeof(float), std::ios::cur);
+    // 全部输出通道的 C_in × 3 × 3 权重，显示选中输入通道的9个
+    kernelWeights = weights;
+    kernelCount = weights.dim(0);
+    currentKernelIndex = 0;
+    currentInputChannel = 0;
+    updateCurrentKernel();
     
-    // 读取第一个核的第一个通道（3×3=9个权重）
-    kernel.resize(9);
-    file.read(reinterpret_cast<char*>(kernel.data()), 9 * sizeof(float));
-    
-    std::cout << "加载卷积核权重" << std::endl;
+    std::cout << "加载卷积核权重: " << weightName << std::endl;
     return true;
-}
\ No newline at end of file
+}
@@ -3,18 +3,22 @@
 
 class MultiChannelConvAnim : public Conv1Anim {
 public:
-    virtual bool load(const std::string& modelDir) override = 0;
-    virtual int getWeightOffset() const = 0;       // 权重偏移量
-    virtual std::string getLayerName() const = 0;  // 层名
+    virtual bool load(const ModelLoader& model) override = 0;
+    virtual std::string getWeightName() const = 0;  // 权重张量名（model.json中的层名）
+    virtual std::string getLayerName() const = 0;   // 层名
     
 protected:
-    virtual bool loadLayerInput(const std::string& modelDir) = 0;
+    virtual bool loadLayerInput(const ModelLoader& model) = 0;
     
-    // 加载多通道数据中的单个通道
-    bool loadSingleChannel(const std::string& filepath, int width, int height, int totalChannels, int channel = 0);
+    // 加载上一层输出的全部通道作为输入（优先使用共享张量，缺失时读取导出的bin文件）
+    bool loadInputChannels(const ModelLoader& model, const std::string& tensorName,
+                           int width, int height, int totalChannels);
     
-    // 加载卷积核权重（第一个核的第一个输入通道）
-    bool loadKernelWeights(const std::string& weightPath, int offset, int kernelChannels = 1);
+    // 加载卷积核权重（全部输出通道的 C_in × 3 × 3，须在 loadInputChannels 之后）
+    bool loadKernelWeights(const ModelLoader& model, const std::string& weightName);
 
     bool createPaddedInput(int width, int height);
-};
\ No newline at end of file
+
+private:
+    void extractChannels(const float* allData, int width, int height, int totalChannels);
+};
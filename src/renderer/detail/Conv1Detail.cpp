@@ -1,19 +1,11 @@
 #include "renderer/detail/Conv1Detail.hpp"
 #include <iostream>
 
-bool Conv1Detail::initialize() {
+bool Conv1Detail::initialize(std::shared_ptr<const ModelLoader> model) {
     initializeHotspots();
+    model_ = std::move(model);
     std::cout << "conv1热点交互初始化完成，热点数量: " << hotspots_.size() << std::endl;
 
-        // 创建动画器
-        animator = std::make_unique<Conv1Anim>();
-        
-        // 加载数据
-        bool success = animator->load("/workspace/assets/model");
-        
-        std::cout << "conv1热点交互初始化完成" 
-                  << (success ? " (包含动画)" : " (动画加载失败)") << std::endl;
-
     return true;
 }
 
@@ -162,6 +154,9 @@ void Conv1Detail::drawButton(const Hotspot& hotspot, ImVec2 contentSize, ImVec2
         if (hotspot.name == "conv1_kernel") {
             //std::cout << "打开卷积动画窗口" << std::endl;
             showAnimation = true;
+            if (model_) {
+                animator.request(model_);
+            }
         }
         else if (hotspot.name == "batchnorm + activation") {
             std::cout << "打开归一化与ReLU激活窗口" << std::endl;
@@ -182,6 +177,10 @@ void Conv1Detail::handleButtons() {
         // 限制最大dt防止卡顿跳跃
         if (deltaTime > 0.1f) deltaTime = 0.1f;
         
-        ConvAnimPanel::show("卷积动画窗口", &showAnimation, *animator, deltaTime);
+        if (animator.poll()) {
+            ConvAnimPanel::show("卷积动画窗口", &showAnimation, *animator.get(), deltaTime);
+        } else {
+            ConvAnimPanel::showLoading("卷积动画窗口", &showAnimation, animator.failed());
+        }
     }
 }
\ No newline at end of file
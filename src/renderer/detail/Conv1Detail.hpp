@@ -3,11 +3,12 @@
 #include "renderer/convanim/ConvAnimBase.hpp"
 #include "renderer/convanim/animations/Conv1Anim.hpp"
 #include "renderer/convanim/ConvAnimPanel.hpp"
+#include "renderer/convanim/AnimatorLoader.hpp"
 #include <vector>
 
 class Conv1Detail : public ConvDetailBase {
 public:
-    bool initialize() override;
+    bool initialize(std::shared_ptr<const ModelLoader> model) override;
     void drawHotspots(ImVec2 contentSize, ImVec2 imagePos) override;
     void handleMouse(const sf::Vector2f& mousePos, ImVec2 contentSize, ImVec2 imagePos) override;
 
@@ -34,7 +35,8 @@ private:
 
     std::string getButtonText(const std::string& hotspotName) const;
 
-    // 卷积动画
-    std::unique_ptr<Conv1Anim> animator;
+    // 卷积动画（首次点击"卷积动画"时才在后台加载）
+    std::shared_ptr<const ModelLoader> model_;
+    AnimatorLoader animator{1};
     bool showAnimation = false;
 };
\ No newline at end of file
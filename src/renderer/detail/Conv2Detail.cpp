@@ -1,18 +1,10 @@
 #include "renderer/detail/Conv2Detail.hpp"
 #include <iostream>
 
-bool Conv2Detail::initialize() {
+bool Conv2Detail::initialize(std::shared_ptr<const ModelLoader> model) {
     initializeHotspots();
+    model_ = std::move(model);
     std::cout << "conv2热点交互初始化完成，热点数量: " << hotspots_.size() << std::endl;
-     
-     // 创建动画器
-        animator = std::make_unique<Conv2Anim>();
-        
-        // 加载数据
-        bool success = animator->load("/workspace/assets/model");
-        
-        std::cout << "conv2热点交互初始化完成" 
-                  << (success ? " (包含动画)" : " (动画加载失败)") << std::endl;
 
     return true;
 }
@@ -161,6 +153,9 @@ void Conv2Detail::drawButton(const Hotspot& hotspot, ImVec2 contentSize, ImVec2
         if (hotspot.name == "conv2_kernel") {
             //std::cout << "打开卷积动画窗口" << std::endl;
             showAnimation = true;
+            if (model_) {
+                animator.request(model_);
+            }
         }
         else if (hotspot.name == "batchnorm + activation") {
             std::cout << "打开归一化与ReLU激活窗口" << std::endl;
@@ -178,6 +173,10 @@ void Conv2Detail::handleButtons() {
     if (showAnimation) {
             static float deltaTime = 0.0f;
             deltaTime = 0.016f;  // 模拟60fps
-            ConvAnimPanel::show("卷积动画窗口", &showAnimation, *animator, deltaTime);
+            if (animator.poll()) {
+                ConvAnimPanel::show("卷积动画窗口", &showAnimation, *animator.get(), deltaTime);
+            } else {
+                ConvAnimPanel::showLoading("卷积动画窗口", &showAnimation, animator.failed());
+            }
         }
 }
\ No newline at end of file
@@ -1,18 +1,10 @@
 #include "renderer/detail/Conv4Detail.hpp"
 #include <iostream>
 
-bool Conv4Detail::initialize() {
+bool Conv4Detail::initialize(std::shared_ptr<const ModelLoader> model) {
     initializeHotspots();
+    model_ = std::move(model);
     std::cout << "conv4热点交互初始化完成，热点数量: " << hotspots_.size() << std::endl;
-     
-     // 创建动画器
-        animator = std::make_unique<Conv4Anim>();
-        
-        // 加载数据
-        bool success = animator->load("/workspace/assets/model");
-        
-        std::cout << "conv4热点交互初始化完成" 
-                  << (success ? " (包含动画)" : " (动画加载失败)") << std::endl;
 
     return true;
 }
@@ -162,6 +154,9 @@ void Conv4Detail::drawButton(const Hotspot& hotspot, ImVec2 contentSize, ImVec2
         if (hotspot.name == "conv4_kernel") {
             //std::cout << "打开卷积动画窗口" << std::endl;
             showAnimation = true;
+            if (model_) {
+                animator.request(model_);
+            }
         }
         else if (hotspot.name == "batchnorm + activation") {
             std::cout << "打开归一化与ReLU激活窗口" << std::endl;
@@ -179,6 +174,10 @@ void Conv4Detail::handleButtons() {
     if (showAnimation) {
             static float deltaTime = 0.0f;
             deltaTime = 0.016f;
-            ConvAnimPanel::show("卷积动画窗口", &showAnimation, *animator, deltaTime);
+            if (animator.poll()) {
+                ConvAnimPanel::show("卷积动画窗口", &showAnimation, *animator.get(), deltaTime);
+            } else {
+                ConvAnimPanel::showLoading("卷积动画窗口", &showAnimation, animator.failed());
+            }
         }
 }
\ No newline at end of file
@@ -1,13 +1,16 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <imgui.h>
+#include <memory>
 #include <string>
+#include "loader/ModelLoader.hpp"
 
 class ConvDetailBase {
 public:
     virtual ~ConvDetailBase() = default;
     
-    virtual bool initialize() = 0;
+    // model 为创建时的模型快照；后台加载的卷积动画同样持有它，面板先销毁也不影响任务完成
+    virtual bool initialize(std::shared_ptr<const ModelLoader> model) = 0;
     
     virtual void drawHotspots(ImVec2 contentSize, ImVec2 imagePos) = 0;
     